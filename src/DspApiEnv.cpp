@@ -9,7 +9,7 @@
 #include "Utility/DspMacros.h"
 
 DspApiEnv::DspApiEnv() :
-solver_(NULL), model_(NULL) {
+solver_(NULL), model_(NULL), bundled_(NULL) {
 	par_ = new DspParams;
 	message_ = new DspMessage(par_->getIntParam("LOG_LEVEL"));
 }
@@ -17,6 +17,7 @@ solver_(NULL), model_(NULL) {
 DspApiEnv::~DspApiEnv() {
 	FREE_PTR(model_);
 	FREE_PTR(solver_);
+	FREE_PTR(bundled_);
 	FREE_PTR(par_);
 	FREE_PTR(message_);
 }
@@ -8,6 +8,7 @@
 #ifndef DSPAPIENV_H_
 #define DSPAPIENV_H_
 
+#include <vector>
 #include "DspConfig.h"
 #include "Solver/DecSolver.h"
 #include "Model/DecModel.h"
@@ -37,6 +38,8 @@ public:
 
 	DecSolver * solver_;   /**< A decomposition solver object */
 	DecModel * model_;     /**< A decomposition model object */
+	DecModel * bundled_;   /**< A model of scenario bundles solved in place of model_ (NULL if no bundles) */
+	std::vector<int> bundles_; /**< bundle of each scenario of model_ */
 	DspParams * par_;      /**< A parameters object */
 	DspMessage * message_; /**< A message object */
 };
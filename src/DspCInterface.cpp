@@ -9,10 +9,13 @@
 
 #include <cstdlib>
 #include <cstdio>
+#include <algorithm>
 
 #include "DspApiEnv.h"
 #include "DspCInterface.h"
 #include "Utility/DspMacros.h"
+#include "Utility/DspProfiler.h"
+#include "Utility/DspScenarioBundle.h"
 #include "Model/DecTssModel.h"
 #include "Model/DecBlkModel.h"
 
@@ -38,6 +41,79 @@
 
 
 
+/**
+ * Profile of a solve. The profiler is enabled if a profile file is given, and it is
+ * always disabled when this goes out of scope, also when the solve throws. The report
+ * is written only after a successful solve.
+ */
+class DspProfileScope
+{
+public:
+	DspProfileScope(DspApiEnv * env): env_(env), done_(false)
+#ifdef DSP_HAS_MPI
+		, mpi_(false), comm_(MPI_COMM_NULL)
+#endif
+	{
+		begin();
+	}
+
+#ifdef DSP_HAS_MPI
+	/** the profiles of all the ranks are reduced, and rank 0 writes the report */
+	DspProfileScope(DspApiEnv * env, MPI_Comm comm): env_(env), done_(false), mpi_(true), comm_(comm)
+	{
+		begin();
+	}
+#endif
+
+	~DspProfileScope()
+	{
+		if (!done_)
+			finish(false);
+		DspProfiler::instance().enable(false);
+	}
+
+	/** write the profile report of a successful solve */
+	void write() {finish(true);}
+
+private:
+
+	void begin()
+	{
+		bool enabled = env_->par_->getStrParam("PROFILE/FILE").size() > 0;
+		DspProfiler::instance().enable(enabled);
+		if (enabled)
+			DspProfiler::instance().reset();
+	}
+
+	void finish(bool success)
+	{
+		done_ = true;
+		if (DspProfiler::isEnabled() == false)
+			return;
+#ifdef DSP_HAS_MPI
+		if (mpi_)
+		{
+			/** The ranks agree on the success, so that they all enter the reduction or none does. */
+			int ok = success ? 1 : 0;
+			int allok = 0;
+			MPI_Allreduce(&ok, &allok, 1, MPI_INT, MPI_MIN, comm_);
+			if (allok == 0)
+				return;
+			DspProfiler::instance().reduce(comm_);
+		}
+#endif
+		if (success)
+			DspProfiler::instance().write(env_->par_->getStrParam("PROFILE/FILE").c_str());
+	}
+
+	DspApiEnv * env_;
+	bool done_; /**< whether the profile was finished */
+#ifdef DSP_HAS_MPI
+	bool mpi_;
+	MPI_Comm comm_;
+#endif
+};
+
 /* using __cplusplus */
 #ifdef __cplusplus
 extern "C" {
@@ -67,6 +143,8 @@ void freeSolver(DspApiEnv * env)
 {
 	DSP_API_CHECK_ENV();
 	FREE_PTR(env->solver_);
+	FREE_PTR(env->bundled_);
+	env->bundles_.clear();
 }
 
 /** If current model is stochastic, return the model as a TssModel object. If no model exists, create one. */
@@ -131,6 +209,8 @@ int readSmps(DspApiEnv * env, const char * smps)
 /** read dro files */
 int readDro(DspApiEnv * env, const char * dro)
 {
+	getTssModel(env)->setWassersteinSparsity(
+		env->par_->getIntParam("DRO/KNEAREST"), env->par_->getDblParam("DRO/CUTOFF"));
 	return getTssModel(env)->readDro(dro);
 }
 
@@ -249,6 +329,46 @@ void setSolution(
 	getTssModel(env)->setSolution(size, solution);
 }
 
+/**
+ * Return the model to be solved by the decomposition methods. If the scenario bundles are given
+ * by ARR_BUNDLE_IDX or NUM_BUNDLES, this creates the model of which each scenario is a bundle.
+ */
+static DecModel * getBundledModel(DspApiEnv * env)
+{
+	if (env->model_->isStochastic() == false)
+		return env->model_;
+
+	DecTssModel * tss = dynamic_cast<DecTssModel*>(env->model_);
+	int nscen = tss->getNumScenarios();
+	int nbundles = 0;
+	if (env->par_->getIntPtrParamSize("ARR_BUNDLE_IDX") > 0)
+	{
+		if (env->par_->getIntPtrParamSize("ARR_BUNDLE_IDX") != nscen)
+			throw "The number of bundle indices should be the number of scenarios.\n";
+		env->bundles_.assign(env->par_->getIntPtrParam("ARR_BUNDLE_IDX"), env->par_->getIntPtrParam("ARR_BUNDLE_IDX") + nscen);
+		nbundles = *std::max_element(env->bundles_.begin(), env->bundles_.end()) + 1;
+	}
+	else if (env->par_->getIntParam("NUM_BUNDLES") > 0 && env->par_->getIntParam("NUM_BUNDLES") < nscen)
+	{
+		std::vector<std::vector<double> > data(nscen);
+		for (int s = 0; s < nscen; ++s)
+			DSP_RTN_CHECK_THROW(tss->getScenarioData(s, data[s]));
+		nbundles = DspBundleScenarios(env->par_->getIntParam("NUM_BUNDLES"), data, env->bundles_);
+	}
+	else
+		return env->model_;
+
+	if (env->par_->getDblPtrParamSize("DD/INIT_MULTIPLIERS") > 0 || env->par_->getDblPtrParamSize("DW/INIT_COLS") > 0)
+		throw "The initial multipliers and columns are not supported with scenario bundles.\n";
+
+	DecTssModel * bundled = NULL;
+	DSP_RTN_CHECK_THROW(tss->createBundledModel(nbundles, &env->bundles_[0], bundled));
+	env->bundled_ = bundled;
+	env->message_->print(1, "Solving %d scenarios in %d bundles.\n", nscen, nbundles);
+
+	return env->bundled_;
+}
+
 /** solve deterministic equivalent model */
 void solveDe(DspApiEnv * env)
 {
@@ -264,9 +384,11 @@ void solveDe(DspApiEnv * env)
 	freeSolver(env);
 
 	env->solver_ = new DeDriver(env->model_, env->par_, env->message_);
+	DspProfileScope profile(env);
 	DSP_RTN_CHECK_THROW(env->solver_->init());
 	DSP_RTN_CHECK_THROW(dynamic_cast<DeDriver*>(env->solver_)->run());
 	DSP_RTN_CHECK_THROW(env->solver_->finalize());
+	profile.write();
 
 	END_TRY_CATCH(;)
 }
@@ -283,10 +405,12 @@ void solveDd(DspApiEnv * env)
 	}
 	freeSolver(env);
 
-	env->solver_ = new DdDriverSerial(env->model_, env->par_, env->message_);
+	env->solver_ = new DdDriverSerial(getBundledModel(env), env->par_, env->message_);
+	DspProfileScope profile(env);
 	DSP_RTN_CHECK_THROW(env->solver_->init());
 	DSP_RTN_CHECK_THROW(dynamic_cast<DdDriverSerial*>(env->solver_)->run());
 	DSP_RTN_CHECK_THROW(env->solver_->finalize());
+	profile.write();
 
 	END_TRY_CATCH(;)
 }
@@ -305,10 +429,12 @@ void solveDw(DspApiEnv * env)
 	}
 	freeSolver(env);
 
-	env->solver_ = new DwSolverSerial(env->model_, env->par_, env->message_);
+	env->solver_ = new DwSolverSerial(getBundledModel(env), env->par_, env->message_);
+	DspProfileScope profile(env);
 	DSP_RTN_CHECK_THROW(env->solver_->init());
 	DSP_RTN_CHECK_THROW(dynamic_cast<DwSolverSerial*>(env->solver_)->run());
 	DSP_RTN_CHECK_THROW(env->solver_->finalize());
+	profile.write();
 
 	END_TRY_CATCH(;)
 }
@@ -331,7 +457,7 @@ void solveBd(DspApiEnv * env)
 		return;
 	}
 
-	DecTssModel* dec = new DecTssModel(*getTssModel(env));
+	DecTssModel* dec = new DecTssModel(*dynamic_cast<TssModel*>(getBundledModel(env)));
 	BdDriverSerial * bd = new BdDriverSerial(dec, env->par_, env->message_);
 	env->solver_ = bd;
 	DSPdebugMessage("Created a serial Benders object\n");
@@ -358,9 +484,11 @@ void solveBd(DspApiEnv * env)
 	}
 	DSPdebugMessage("Set auxiliary variable data\n");
 
+	DspProfileScope profile(env);
 	DSP_RTN_CHECK_THROW(env->solver_->init());
 	DSP_RTN_CHECK_THROW(dynamic_cast<BdDriverSerial*>(env->solver_)->run());
 	DSP_RTN_CHECK_THROW(env->solver_->finalize());
+	profile.write();
 #else
 	printf("Benders decomposition has been disabled because SCIP was not available.\n");
 #endif
@@ -384,10 +512,12 @@ void solveDdMpi(DspApiEnv * env, MPI_Comm comm)
 	DSP_API_CHECK_MODEL();
 	freeSolver(env);
 
-	env->solver_ = new DdDriverMpi(env->model_, env->par_, env->message_, comm);
+	env->solver_ = new DdDriverMpi(getBundledModel(env), env->par_, env->message_, comm);
+	DspProfileScope profile(env, comm);
 	DSP_RTN_CHECK_THROW(env->solver_->init());
 	DSP_RTN_CHECK_THROW(dynamic_cast<DdDriverMpi*>(env->solver_)->run());
 	DSP_RTN_CHECK_THROW(env->solver_->finalize());
+	profile.write();
 
 	END_TRY_CATCH(;)
 }
@@ -410,7 +540,7 @@ void solveDwMpi(DspApiEnv * env, MPI_Comm comm)
 	DSP_API_CHECK_MODEL();
 	freeSolver(env);
 
-	env->solver_ = new DwSolverMpi(env->model_, env->par_, env->message_, comm);
+	env->solver_ = new DwSolverMpi(getBundledModel(env), env->par_, env->message_, comm);
 
 	/** Check whether or not the subproblems are distributed. */
 	int is_distributed;
@@ -437,9 +567,11 @@ void solveDwMpi(DspApiEnv * env, MPI_Comm comm)
 		return;
 	}
 
+	DspProfileScope profile(env, comm);
 	DSP_RTN_CHECK_THROW(env->solver_->init());
 	DSP_RTN_CHECK_THROW(dynamic_cast<DwSolverMpi*>(env->solver_)->run());
 	DSP_RTN_CHECK_THROW(env->solver_->finalize());
+	profile.write();
 
 	END_TRY_CATCH(;)
 }
@@ -469,7 +601,7 @@ void solveBdMpi(
 	}
 
 	//DSPdebugMessage("Creating a MPI Benders object (comm %d)\n", comm);
-	BdDriverMpi * bd = new BdDriverMpi(new DecTssModel(*getTssModel(env)), env->par_, env->message_, comm);
+	BdDriverMpi * bd = new BdDriverMpi(new DecTssModel(*dynamic_cast<TssModel*>(getBundledModel(env))), env->par_, env->message_, comm);
 	env->solver_ = bd;
 
 	double * obj_aux  = NULL;
@@ -494,9 +626,11 @@ void solveBdMpi(
 		FREE_ARRAY_PTR(cubd_aux);
 	}
 
+	DspProfileScope profile(env, comm);
 	DSP_RTN_CHECK_THROW(env->solver_->init());
 	DSP_RTN_CHECK_THROW(dynamic_cast<BdDriverMpi*>(env->solver_)->run());
 	DSP_RTN_CHECK_THROW(env->solver_->finalize());
+	profile.write();
 #else
 	printf("Benders decomposition has been disabled because SCIP was not available.\n");
 #endif
@@ -512,6 +646,140 @@ void readParamFile(DspApiEnv * env, const char * param_file)
 	env->par_->readParamFile(param_file);
 }
 
+/** set profile report file */
+void setProfile(DspApiEnv * env, const char * filename)
+{
+	DSP_API_CHECK_ENV();
+	env->par_->setStrParam("PROFILE/FILE", filename == NULL ? "" : filename);
+}
+
+void setRestart(DspApiEnv * env, const char * filename)
+{
+	DSP_API_CHECK_ENV();
+	env->par_->setStrParam("DD/RESTART/FILE", filename == NULL ? "" : filename);
+	env->par_->setStrParam("DW/RESTART/FILE", filename == NULL ? "" : filename);
+}
+
+/** copy an array to a double array parameter */
+static void setDblPtrParam(DspParams * par, const char * name, int size, const double * vals)
+{
+	par->setDblPtrParamSize(name, size);
+	for (int i = 0; i < size; ++i)
+		par->setDblPtrParam(name, i, vals[i]);
+}
+
+int setInitialMultipliers(DspApiEnv * env, int size, const double * lambda)
+{
+	DSP_API_CHECK_MODEL(DSP_RTN_ERR);
+	BGN_TRY_CATCH
+	if (lambda == NULL)
+		size = 0;
+	if (size > 0 && size != env->model_->getNumCouplingRows())
+	{
+		char msg[128];
+		sprintf(msg, "The number of initial multipliers (%d) should be the number of coupling rows (%d).\n",
+				size, env->model_->getNumCouplingRows());
+		throw msg;
+	}
+	setDblPtrParam(env->par_, "DD/INIT_MULTIPLIERS", size, lambda);
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+	return DSP_RTN_OK;
+}
+
+int addInitialColumn(DspApiEnv * env, int block, int size, const double * solution)
+{
+	DSP_API_CHECK_MODEL(DSP_RTN_ERR);
+	BGN_TRY_CATCH
+	if (block < 0 || block >= env->model_->getNumSubproblems())
+		throw "Invalid subproblem index of the initial column.\n";
+
+	/** number of columns in the subproblem */
+	int ncols = 0;
+	if (env->model_->isStochastic())
+		ncols = getTssModel(env)->getNumCols(0) + getTssModel(env)->getNumCols(1);
+	else {
+		BlkModel* blk = dynamic_cast<DecBlkModel*>(env->model_)->blkPtr();
+		if (blk->areBlocksUpdated() == false)
+			blk->updateBlocks();
+		ncols = blk->block(block+1)->getNumCols();
+	}
+	if (solution == NULL || size != ncols)
+	{
+		char msg[128];
+		sprintf(msg, "The size of the initial column (%d) should be the number of columns of the subproblem (%d).\n",
+				size, ncols);
+		throw msg;
+	}
+
+	/** append a record [block, size, solution] */
+	int oldsize = env->par_->getDblPtrParamSize("DW/INIT_COLS");
+	std::vector<double> records(env->par_->getDblPtrParam("DW/INIT_COLS"), env->par_->getDblPtrParam("DW/INIT_COLS") + oldsize);
+	records.push_back(block);
+	records.push_back(size);
+	records.insert(records.end(), solution, solution + size);
+	setDblPtrParam(env->par_, "DW/INIT_COLS", records.size(), records.data());
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+	return DSP_RTN_OK;
+}
+
+int setInitialIncumbent(DspApiEnv * env, int size, const double * solution)
+{
+	DSP_API_CHECK_MODEL(DSP_RTN_ERR);
+	BGN_TRY_CATCH
+	if (solution == NULL)
+		size = 0;
+	if (size > 0 && size != env->model_->getNumCouplingCols())
+	{
+		char msg[128];
+		sprintf(msg, "The size of the initial incumbent (%d) should be the number of coupling columns (%d).\n",
+				size, env->model_->getNumCouplingCols());
+		throw msg;
+	}
+	setDblPtrParam(env->par_, "INIT_INCUMBENT", size, solution);
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+	return DSP_RTN_OK;
+}
+
+void clearWarmStart(DspApiEnv * env)
+{
+	DSP_API_CHECK_ENV();
+	env->par_->setDblPtrParamSize("DD/INIT_MULTIPLIERS", 0);
+	env->par_->setDblPtrParamSize("DW/INIT_COLS", 0);
+	env->par_->setDblPtrParamSize("INIT_INCUMBENT", 0);
+}
+
+int setScenarioBundles(DspApiEnv * env, int size, const int * bundles)
+{
+	DSP_API_CHECK_MODEL(DSP_RTN_ERR);
+	BGN_TRY_CATCH
+	if (bundles == NULL)
+		size = 0;
+	if (size > 0 && size != getTssModel(env)->getNumScenarios())
+	{
+		char msg[128];
+		sprintf(msg, "The number of bundle indices (%d) should be the number of scenarios (%d).\n",
+				size, getTssModel(env)->getNumScenarios());
+		throw msg;
+	}
+	std::vector<bool> used(size, false);
+	for (int s = 0; s < size; ++s)
+	{
+		if (bundles[s] < 0 || bundles[s] >= size)
+			throw "Invalid bundle index.\n";
+		used[bundles[s]] = true;
+	}
+	/** the bundles are numbered from zero without a gap */
+	int nbundles = std::find(used.begin(), used.end(), false) - used.begin();
+	for (int s = 0; s < size; ++s)
+		if (bundles[s] >= nbundles)
+			throw "The bundles should be numbered from zero without a gap.\n";
+	env->par_->setIntPtrParamSize("ARR_BUNDLE_IDX", size);
+	for (int s = 0; s < size; ++s)
+		env->par_->setIntPtrParam("ARR_BUNDLE_IDX", s, bundles[s]);
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+	return DSP_RTN_OK;
+}
+
 void setWassersteinAmbiguitySet(DspApiEnv *env, double lp_norm, double eps)
 {
 	DSP_API_CHECK_ENV();
@@ -525,10 +793,38 @@ void setWassersteinAmbiguitySet(DspApiEnv *env, double lp_norm, double eps)
 					 "Please create all the scenario subproblems at each process.\n";
 		throw msg;
 	}
+	getTssModel(env)->setWassersteinSparsity(
+		env->par_->getIntParam("DRO/KNEAREST"), env->par_->getDblParam("DRO/CUTOFF"));
 	DSP_RTN_CHECK_THROW(getTssModel(env)->setWassersteinAmbiguitySet(lp_norm, eps));
 	END_TRY_CATCH(;)
 }
 
+int reduceScenarios(DspApiEnv * env, int nscen, int method)
+{
+	DSP_API_CHECK_MODEL(DSP_RTN_ERR);
+	BGN_TRY_CATCH
+	if (env->model_->isStochastic() == false)
+		throw "Scenario reduction is available for stochastic programs only.\n";
+	if (env->model_->isDistributed())
+		throw "Scenario reduction requires all the scenarios at each process.\n";
+	if (method != SCEN_BACKWARD && method != SCEN_KMEDOIDS)
+		throw "Invalid scenario reduction method.\n";
+	int nscen0 = getTssModel(env)->getNumScenarios();
+	double kantorovich = 0.0;
+	DSP_RTN_CHECK_THROW(getTssModel(env)->reduceScenarios(nscen, method, &kantorovich));
+	env->message_->print(1, "Reduced %d scenarios to %d scenarios (Kantorovich distance %e).\n",
+			nscen0, getTssModel(env)->getNumScenarios(), kantorovich);
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+	return DSP_RTN_OK;
+}
+
+/** write SMPS files */
+int writeSmps(DspApiEnv * env, const char * smps)
+{
+	DSP_API_CHECK_MODEL(DSP_RTN_ERR);
+	return getTssModel(env)->writeSmps(smps);
+}
+
 /** set boolean parameter */
 void setBoolParam(DspApiEnv * env, const char * name, bool value)
 {
@@ -681,6 +977,16 @@ double getDualBound(DspApiEnv * env)
 void getPrimalSolution(DspApiEnv * env, int num, double * solution)
 {
 	DSP_API_CHECK_SOLVER();
+	if (env->bundled_)
+	{
+		BGN_TRY_CATCH
+		std::vector<double> sol(env->model_->getFullModelNumCols());
+		DSP_RTN_CHECK_THROW(dynamic_cast<DecTssModel*>(env->model_)->unbundleSolution(
+				env->bundled_->getNumSubproblems(), &env->bundles_[0], env->solver_->getBestPrimalSolution(), &sol[0]));
+		CoinCopyN(&sol[0], CoinMin(num, (int) sol.size()), solution);
+		END_TRY_CATCH(;)
+		return;
+	}
 	CoinCopyN(env->solver_->getBestPrimalSolution(), num, solution);
 }
 
@@ -688,6 +994,17 @@ void getPrimalSolution(DspApiEnv * env, int num, double * solution)
 void getDualSolution(DspApiEnv * env, int num, double * solution)
 {
 	DSP_API_CHECK_SOLVER();
+	/** the dual solution of the dual decomposition consists of the multipliers of the coupling rows */
+	if (env->bundled_ && dynamic_cast<DdDriver*>(env->solver_))
+	{
+		BGN_TRY_CATCH
+		std::vector<double> mul(env->model_->getNumCouplingRows());
+		DSP_RTN_CHECK_THROW(dynamic_cast<DecTssModel*>(env->model_)->unbundleMultipliers(
+				env->bundled_->getNumSubproblems(), &env->bundles_[0], env->solver_->getBestDualSolution(), &mul[0]));
+		CoinCopyN(&mul[0], CoinMin(num, (int) mul.size()), solution);
+		END_TRY_CATCH(;)
+		return;
+	}
 	CoinCopyN(env->solver_->getBestDualSolution(), num, solution);
 }
 
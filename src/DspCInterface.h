@@ -149,6 +149,71 @@ void solveBdMpi(
 /** read parameter file */
 void readParamFile(DspApiEnv * env, const char * param_file);
 
+/**
+ * Write the profile report of the subsequent solves to a file. The report is
+ * in JSON if the name ends with .json, and in CSV otherwise. In parallel runs,
+ * the profiles are reduced to rank 0. Empty or NULL file name disables profiling.
+ */
+void setProfile(DspApiEnv * env, const char * filename);
+
+/**
+ * Resume the dual decomposition or the Dantzig-Wolfe branch-and-price from a
+ * checkpoint file written with the parameters DD/CHECKPOINT/FREQ or
+ * DW/CHECKPOINT/FILE, respectively. For the dual decomposition, the number of
+ * processes may differ from the run that wrote the checkpoint. Empty or NULL
+ * file name disables the restart.
+ */
+void setRestart(DspApiEnv * env, const char * filename);
+
+/**
+ * Set the initial Lagrangian multipliers of the coupling rows for the dual
+ * decomposition (e.g., from a previous solve of a similar model). The size must
+ * be the number of coupling rows. The multipliers are ignored when the run is
+ * resumed from a checkpoint.
+ */
+int setInitialMultipliers(
+		DspApiEnv *    env,   /**< pointer to API object */
+		int            size,  /**< size of multiplier array */
+		const double * lambda /**< initial multipliers */);
+
+/**
+ * Add an initial column of the Dantzig-Wolfe master given by a solution of a
+ * subproblem (block). For stochastic models, the solution consists of the first-
+ * and the second-stage variables of the scenario. This function can be called
+ * multiple times for multiple columns.
+ */
+int addInitialColumn(
+		DspApiEnv *    env,     /**< pointer to API object */
+		int            block,   /**< subproblem index */
+		int            size,    /**< size of solution array */
+		const double * solution /**< subproblem solution */);
+
+/**
+ * Set an initial incumbent given by the values of the coupling (first-stage)
+ * variables. The incumbent is evaluated for an upper bound at the beginning of
+ * the dual decomposition and the Dantzig-Wolfe decomposition of stochastic models.
+ */
+int setInitialIncumbent(
+		DspApiEnv *    env,     /**< pointer to API object */
+		int            size,    /**< size of solution array */
+		const double * solution /**< coupling column solution */);
+
+/** clear the initial multipliers, columns, and incumbent */
+void clearWarmStart(DspApiEnv * env /**< pointer to API object */);
+
+/**
+ * Set the scenario bundles of a stochastic model. Each bundle is solved as a single
+ * extensive-form subproblem by the dual decomposition, Dantzig-Wolfe and Benders
+ * methods, and ARR_PROC_IDX then refers to the bundles. The bundles are numbered
+ * from zero without a gap. Otherwise, the NUM_BUNDLES parameter forms the bundles
+ * by the similarity of scenarios. The solutions are reported for the scenarios.
+ * Empty or NULL array removes the bundles.
+ */
+int setScenarioBundles(
+		DspApiEnv * env,    /**< pointer to API object */
+		int         size,   /**< number of scenarios */
+		const int * bundles /**< bundle of each scenario */);
+
 /** 
  * Set the Wasserstein ambiguity set for distributionally robust optimization.
  * This should be used for stochastic programming models, where the probabilities
@@ -160,6 +225,20 @@ void readParamFile(DspApiEnv * env, const char * param_file);
  */
 void setWassersteinAmbiguitySet(DspApiEnv *env, double lp_norm, double eps);
 
+/**
+ * Reduce the scenarios of a stochastic model to the given number by the fast backward
+ * reduction (0) or the k-medoids clustering (1). The probability of each removed scenario
+ * is moved to the kept scenario representing it. This should be called before the scenario
+ * bundles, the block indices and the Wasserstein ambiguity set are set.
+ */
+int reduceScenarios(
+		DspApiEnv * env,   /**< pointer to API object */
+		int         nscen, /**< number of scenarios to keep */
+		int         method /**< reduction method */);
+
+/** write SMPS files */
+int writeSmps(DspApiEnv * env, const char * smps);
+
 /** set boolean parameter */
 void setBoolParam(DspApiEnv *env, const char *name, bool value);
 
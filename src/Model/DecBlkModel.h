@@ -75,6 +75,8 @@ public:
 	int getNumReferences() {return 0;}
 	double getWassersteinSize() {return 0.0;}
 	double getWassersteinDist(int i, int j) {return 0.0;}
+	const CoinPackedVector * getWassersteinPairs(int j) {return NULL;}
+	int getNumWassersteinPairs() {return 0;}
 	double getReferenceProbability(int i) {return 0.0;}
 
 	DSP_RTN_CODE decompose(
@@ -13,6 +13,7 @@
 /** Coin */
 #include "CoinTime.hpp"
 #include "CoinPackedMatrix.hpp"
+#include "CoinPackedVector.hpp"
 /** Dsp */
 #include "Utility/DspMacros.h"
 #include "Utility/DspRtnCodes.h"
@@ -189,10 +190,22 @@ public:
 	virtual double getWassersteinSize() = 0;
 
 	/**
-	 * Returns the Wasserstein distance between two random realizations i and j.
+	 * Returns the Wasserstein distance between reference i and scenario j, which is
+	 * COIN_DBL_MAX if the pair is not kept in the sparsified ambiguity set.
 	 */
 	virtual double getWassersteinDist(int i, int j) = 0;
 
+	/**
+	 * Returns the transport pairs of scenario j, of which the indices are the references
+	 * and the elements are the Wasserstein distances.
+	 */
+	virtual const CoinPackedVector * getWassersteinPairs(int j) = 0;
+
+	/**
+	 * Returns the total number of the transport pairs.
+	 */
+	virtual int getNumWassersteinPairs() = 0;
+
 	/**
 	 * Returns the probability of reference i.
 	 */
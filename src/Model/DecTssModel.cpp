@@ -5,6 +5,7 @@
  *      Author: ctjandra
  */
 
+#include <algorithm>
 #include "Utility/DspMessage.h"
 #include "Model/DecTssModel.h"
 
@@ -525,3 +526,254 @@ DSP_RTN_CODE DecTssModel::copyRecoProb(
 
 	return DSP_RTN_OK;
 }
+
+DSP_RTN_CODE DecTssModel::getScenarioData(
+		int scen,                   /**< [in] scenario index */
+		std::vector<double> & data, /**< [out] scenario data */
+		bool exact                  /**< [in] get the exact data to identify the identical scenarios */)
+{
+	assert(scen >= 0 && scen < nscen_);
+
+	BGN_TRY_CATCH
+
+	int ncols = ncols_[1];
+	int nrows = nrows_[1];
+	data.resize(3 * ncols + 2 * nrows);
+	double * obj  = &data[0];
+	double * clbd = obj + ncols;
+	double * cubd = clbd + ncols;
+	double * rlbd = cubd + ncols;
+	double * rubd = rlbd + nrows;
+
+	copyCoreObjective(obj, 1);
+	combineRandObjective(obj, 1, scen, false);
+	copyCoreColLower(clbd, 1);
+	combineRandColLower(clbd, 1, scen);
+	copyCoreColUpper(cubd, 1);
+	combineRandColUpper(cubd, 1, scen);
+	copyCoreRowLower(rlbd, 1);
+	combineRandRowLower(rlbd, 1, scen);
+	copyCoreRowUpper(rubd, 1);
+	combineRandRowUpper(rubd, 1, scen);
+
+	/** an infinite bound and a zero bound must not be identical */
+	for (unsigned i = 0; i < data.size(); ++i)
+		if (fabs(data[i]) >= 1.0e+20)
+			data[i] = exact ? (data[i] > 0 ? COIN_DBL_MAX : -COIN_DBL_MAX) : 0.0;
+
+	if (exact && mat_scen_[scen])
+	{
+		const CoinPackedMatrix * mat = mat_scen_[scen];
+		for (int i = 0; i < mat->getMajorDim(); ++i)
+		{
+			CoinBigIndex start = mat->getVectorStarts()[i];
+			int length = mat->getVectorSize(i);
+			data.push_back(length);
+			for (int j = 0; j < length; ++j)
+			{
+				data.push_back(mat->getIndices()[start + j]);
+				data.push_back(mat->getElements()[start + j]);
+			}
+		}
+	}
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DecTssModel::createBundledModel(
+		int nbundles,              /**< [in] number of bundles */
+		const int * bundles,       /**< [in] bundle of each scenario */
+		DecTssModel *& bundled     /**< [out] bundled model */)
+{
+#define FREE_MEMORY                \
+	FREE_PTR(mat_tech)             \
+	FREE_PTR(mat_reco)             \
+	FREE_ARRAY_PTR(clbd_reco)      \
+	FREE_ARRAY_PTR(cubd_reco)      \
+	FREE_ARRAY_PTR(ctype_reco)     \
+	FREE_ARRAY_PTR(obj_reco)       \
+	FREE_ARRAY_PTR(rlbd_reco)      \
+	FREE_ARRAY_PTR(rubd_reco)
+
+	CoinPackedMatrix * mat_tech = NULL;
+	CoinPackedMatrix * mat_reco = NULL;
+	double * clbd_reco  = NULL;
+	double * cubd_reco  = NULL;
+	char *   ctype_reco = NULL;
+	double * obj_reco   = NULL;
+	double * rlbd_reco  = NULL;
+	double * rubd_reco  = NULL;
+
+	bundled = NULL;
+
+	BGN_TRY_CATCH
+
+	if (isDro())
+		throw "Scenario bundles are not supported for distributionally robust models.";
+	if (isDistributed())
+		throw "Scenario bundles require the data of all the scenarios.";
+
+	/** scenarios of each bundle */
+	std::vector<std::vector<int> > members(nbundles);
+	for (int s = 0; s < nscen_; ++s)
+	{
+		if (bundles[s] < 0 || bundles[s] >= nbundles)
+			throw "Invalid bundle index.";
+		members[bundles[s]].push_back(s);
+	}
+	int maxsize = 0;
+	for (int b = 0; b < nbundles; ++b)
+	{
+		if (members[b].size() == 0)
+			throw "Empty scenario bundle.";
+		maxsize = CoinMax(maxsize, (int) members[b].size());
+	}
+
+	int ncols1 = ncols_[0];
+	int nrows1 = nrows_[0];
+	int ncols2 = ncols_[1];
+	int nrows2 = nrows_[1];
+
+	bundled = new DecTssModel;
+	DSP_RTN_CHECK_THROW(bundled->setNumberOfScenarios(nbundles));
+	DSP_RTN_CHECK_THROW(bundled->setDimensions(ncols1, nrows1, maxsize * ncols2, maxsize * nrows2));
+
+	/** first stage */
+	{
+		std::vector<CoinBigIndex> start(1, 0);
+		std::vector<int> index;
+		std::vector<double> value;
+		for (int i = 0; i < nrows1; ++i)
+		{
+			index.insert(index.end(), rows_core_[i]->getIndices(), rows_core_[i]->getIndices() + rows_core_[i]->getNumElements());
+			value.insert(value.end(), rows_core_[i]->getElements(), rows_core_[i]->getElements() + rows_core_[i]->getNumElements());
+			start.push_back(index.size());
+		}
+		DSP_RTN_CHECK_THROW(bundled->loadFirstStage(&start[0], index.data(), value.data(),
+				clbd_core_[0], cubd_core_[0], ctype_core_[0], obj_core_[0], rlbd_core_[0], rubd_core_[0]));
+	}
+
+	/** second stage of each bundle */
+	std::vector<double> clbd(maxsize * ncols2), cubd(maxsize * ncols2), obj(maxsize * ncols2);
+	std::vector<char> ctype(maxsize * ncols2);
+	std::vector<double> rlbd(maxsize * nrows2), rubd(maxsize * nrows2);
+	for (int b = 0; b < nbundles; ++b)
+	{
+		double prob = 0.0;
+		for (unsigned k = 0; k < members[b].size(); ++k)
+			prob += prob_[members[b][k]];
+
+		std::vector<CoinBigIndex> start(1, 0);
+		std::vector<int> index;
+		std::vector<double> value;
+		for (int k = 0; k < maxsize; ++k)
+		{
+			int cpos = k * ncols2;
+			int rpos = k * nrows2;
+			if (k < (int) members[b].size())
+			{
+				int s = members[b][k];
+				DSP_RTN_CHECK_THROW(copyRecoProb(s, mat_tech, mat_reco,
+						clbd_reco, cubd_reco, ctype_reco, obj_reco, rlbd_reco, rubd_reco, false));
+
+				/** the objective is weighted by the conditional probability in the bundle */
+				double weight = prob > 0.0 ? prob_[s] / prob : 1.0;
+				for (int j = 0; j < ncols2; ++j)
+					obj[cpos + j] = weight * obj_reco[j];
+				CoinCopyN(clbd_reco, ncols2, &clbd[cpos]);
+				CoinCopyN(cubd_reco, ncols2, &cubd[cpos]);
+				CoinCopyN(ctype_reco, ncols2, &ctype[cpos]);
+				CoinCopyN(rlbd_reco, nrows2, &rlbd[rpos]);
+				CoinCopyN(rubd_reco, nrows2, &rubd[rpos]);
+
+				for (int i = 0; i < nrows2; ++i)
+				{
+					const CoinShallowPackedVector tech = mat_tech->getVector(i);
+					const CoinShallowPackedVector reco = mat_reco->getVector(i);
+					index.insert(index.end(), tech.getIndices(), tech.getIndices() + tech.getNumElements());
+					value.insert(value.end(), tech.getElements(), tech.getElements() + tech.getNumElements());
+					for (int j = 0; j < reco.getNumElements(); ++j)
+					{
+						index.push_back(ncols1 + cpos + reco.getIndices()[j]);
+						value.push_back(reco.getElements()[j]);
+					}
+					start.push_back(index.size());
+				}
+				FREE_MEMORY
+			}
+			else
+			{
+				/** padding */
+				CoinFillN(&clbd[cpos], ncols2, 0.0);
+				CoinFillN(&cubd[cpos], ncols2, 0.0);
+				CoinFillN(&obj[cpos], ncols2, 0.0);
+				copyCoreColType(&ctype[cpos], 1);
+				CoinFillN(&rlbd[rpos], nrows2, -COIN_DBL_MAX);
+				CoinFillN(&rubd[rpos], nrows2, COIN_DBL_MAX);
+				for (int i = 0; i < nrows2; ++i)
+					start.push_back(index.size());
+			}
+		}
+
+		DSP_RTN_CHECK_THROW(bundled->loadSecondStage(b, prob, &start[0], index.data(), value.data(),
+				&clbd[0], &cubd[0], &ctype[0], &obj[0], &rlbd[0], &rubd[0]));
+	}
+
+	END_TRY_CATCH_RTN(FREE_MEMORY;FREE_PTR(bundled),DSP_RTN_ERR)
+
+	FREE_MEMORY
+
+	return DSP_RTN_OK;
+#undef FREE_MEMORY
+}
+
+DSP_RTN_CODE DecTssModel::unbundleSolution(
+		int nbundles,              /**< [in] number of bundles */
+		const int * bundles,       /**< [in] bundle of each scenario */
+		const double * bundledsol, /**< [in] solution of the bundled model */
+		double * solution          /**< [out] solution of this model */)
+{
+	BGN_TRY_CATCH
+
+	/** position of each scenario in its bundle */
+	std::vector<int> sizes(nbundles, 0);
+	std::vector<int> pos(nscen_);
+	for (int s = 0; s < nscen_; ++s)
+		pos[s] = sizes[bundles[s]]++;
+	int maxsize = *std::max_element(sizes.begin(), sizes.end());
+
+	CoinCopyN(bundledsol, ncols_[0], solution);
+	for (int s = 0; s < nscen_; ++s)
+		CoinCopyN(bundledsol + ncols_[0] + (bundles[s] * maxsize + pos[s]) * ncols_[1], ncols_[1],
+				solution + ncols_[0] + s * ncols_[1]);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DecTssModel::unbundleMultipliers(
+		int nbundles,              /**< [in] number of bundles */
+		const int * bundles,       /**< [in] bundle of each scenario */
+		const double * bundledmul, /**< [in] multipliers of the bundled model */
+		double * multipliers       /**< [out] multipliers of this model */)
+{
+	BGN_TRY_CATCH
+
+	std::vector<double> prob(nbundles, 0.0);
+	for (int s = 0; s < nscen_; ++s)
+		prob[bundles[s]] += prob_[s];
+
+	for (int s = 0; s < nscen_; ++s)
+	{
+		double weight = prob[bundles[s]] > 0.0 ? prob_[s] / prob[bundles[s]] : 0.0;
+		for (int j = 0; j < ncols_[0]; ++j)
+			multipliers[s * ncols_[0] + j] = weight * bundledmul[bundles[s] * ncols_[0] + j];
+	}
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
@@ -153,6 +153,8 @@ public:
 	virtual int getNumReferences() {return TssModel::getNumReferences();}
 	virtual double getWassersteinSize() {return TssModel::getWassersteinSize();}
 	virtual double getWassersteinDist(int i, int j) {return TssModel::getWassersteinDist(i,j);}
+	virtual const CoinPackedVector * getWassersteinPairs(int j) {return TssModel::getWassersteinPairs(j);}
+	virtual int getNumWassersteinPairs() {return TssModel::getNumWassersteinPairs();}
 	virtual double getReferenceProbability(int i) {return TssModel::getReferenceProbability(i);}
 
 	DSP_RTN_CODE decompose(
@@ -213,6 +215,46 @@ public:
 		double *& rlbd,          /**< [out] row lower bounds */
 		double *& rubd           /**< [out] row upper bounds */);
 
+	/** Methods on scenario bundles */
+
+	/** Get the second-stage data of a scenario (objective coefficients, column and row bounds),
+	 * where infinite values are replaced by zeros, to measure the similarity of scenarios.
+	 * For the exact data, the infinite values are kept as +/-COIN_DBL_MAX and the scenario
+	 * matrix rows (lengths, indices and elements) are appended, so that the data of two
+	 * scenarios are equal only if the scenarios are identical. */
+	DSP_RTN_CODE getScenarioData(
+		int scen,                   /**< [in] scenario index */
+		std::vector<double> & data, /**< [out] scenario data */
+		bool exact = false          /**< [in] get the exact data to identify the identical scenarios */);
+
+	/**
+	 * Create a model of which each scenario is a bundle of the scenarios of this model.
+	 *
+	 * The second stage of a bundle is the block-diagonal extensive form of its scenarios in the
+	 * increasing order of scenario indices, and its probability is the sum of their probabilities.
+	 * Since every scenario has the same dimension, the bundles with fewer scenarios than the
+	 * largest bundle are padded with the columns fixed to zero and the free rows.
+	 */
+	DSP_RTN_CODE createBundledModel(
+		int nbundles,              /**< [in] number of bundles */
+		const int * bundles,       /**< [in] bundle of each scenario */
+		DecTssModel *& bundled     /**< [out] bundled model */);
+
+	/** Map a solution of the bundled model to the full solution of this model */
+	DSP_RTN_CODE unbundleSolution(
+		int nbundles,              /**< [in] number of bundles */
+		const int * bundles,       /**< [in] bundle of each scenario */
+		const double * bundledsol, /**< [in] solution of the bundled model */
+		double * solution          /**< [out] solution of this model */);
+
+	/** Map the multipliers of the coupling rows of the bundled model to this model,
+	 * where the multipliers of a bundle are split over its scenarios in proportion to their probabilities. */
+	DSP_RTN_CODE unbundleMultipliers(
+		int nbundles,              /**< [in] number of bundles */
+		const int * bundles,       /**< [in] bundle of each scenario */
+		const double * bundledmul, /**< [in] multipliers of the bundled model */
+		double * multipliers       /**< [out] multipliers of this model */);
+
 	/** Methods on alternative representation used in subgradient algorithm */
 
 	/** Evaluates row with nonanticipativity represented as x_i = x_{i+1} */
@@ -5,8 +5,17 @@
  *      Author: kibaekkim
  */
 
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <algorithm>
 #include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrix.hpp"
 #include "StoModel.h"
+#include "Utility/DspWasserstein.h"
+#include "Utility/DspScenarioReduction.h"
+#include "Utility/DspParams.h"
 
 StoModel::StoModel() :
 		nscen_(0),
@@ -37,7 +46,8 @@ StoModel::StoModel() :
 		isdro_(false),
 		nrefs_(0),
 		wass_eps_(0.0),
-		wass_dist_(NULL),
+		wass_knearest_(0),
+		wass_cutoff_(0.0),
 		refs_probability_(NULL)
 {
 	/** nothing to do */
@@ -54,7 +64,9 @@ StoModel::StoModel(const StoModel & rhs) :
 		isdro_(rhs.isdro_),
 		nrefs_(rhs.nrefs_),
 		wass_eps_(rhs.wass_eps_),
-		wass_dist_(rhs.wass_dist_),
+		wass_knearest_(rhs.wass_knearest_),
+		wass_cutoff_(rhs.wass_cutoff_),
+		wass_pairs_(rhs.wass_pairs_),
 		refs_probability_(rhs.refs_probability_)
 {
 	/** allocate memory */
@@ -156,7 +168,6 @@ StoModel::~StoModel()
 	FREE_2D_ARRAY_PTR(nstgs_, rlbd_core_);
 	FREE_2D_ARRAY_PTR(nstgs_, rubd_core_);
 	FREE_2D_ARRAY_PTR(nstgs_, ctype_core_);
-	FREE_2D_ARRAY_PTR(nrefs_, wass_dist_);
 	FREE_2D_PTR(nscen_, mat_scen_);
 	FREE_2D_PTR(nscen_, clbd_scen_);
 	FREE_2D_PTR(nscen_, cubd_scen_);
@@ -361,9 +372,13 @@ DSP_RTN_CODE StoModel::readDro(const char * filename)
 		 * 1. wass_size_
 		 * 2. nrefs_
 		 * 3. refs_probability_ (size of nrefs by ,)
-		 * 4. wass_dist_ (size of nrefs by nscen)
+		 * 4. Wasserstein distances (nscen rows of nrefs distances)
+		 *
+		 * The distances are sparsified row by row, so the full matrix is never stored.
 		 */
 		int contents_num = 1;
+		std::vector<double> dist;
+		std::vector<std::pair<double,int> > nearest;
 		size_t found;
 		string elem;
 		while(getline(myfile, line)) {
@@ -401,10 +416,12 @@ DSP_RTN_CODE StoModel::readDro(const char * filename)
 				contents_num++;
 			} else if (contents_num >= 4) {
 				if (contents_num == 4) {
-					wass_dist_ = new double * [nrefs_];
-					for (int i = 0; i < nrefs_; ++i) {
-						wass_dist_[i] = new double [nscen_];
-					}
+					wass_pairs_.assign(nscen_, CoinPackedVector());
+					nearest.assign(nrefs_, std::make_pair(COIN_DBL_MAX, -1));
+					dist.resize(nrefs_);
+				}
+				if (contents_num-4 >= nscen_) {
+					throw "invalid number of rows for Wasserstein distance\n";
 				}
 
 				int i;
@@ -412,7 +429,7 @@ DSP_RTN_CODE StoModel::readDro(const char * filename)
 					found = line.find_first_of(" ,");
 					if(string::npos == found && i < nrefs_ - 1)
 						break;
-					wass_dist_[i][contents_num-4] = atof(line.substr(0, found).c_str());
+					dist[i] = atof(line.substr(0, found).c_str());
 					if (string::npos != found)
 						line = line.substr(found+1);
 				}
@@ -420,13 +437,17 @@ DSP_RTN_CODE StoModel::readDro(const char * filename)
 					throw "invalid number of columns for Wasserstein distance\n";
 					break;
 				}
+				setWassersteinPairs(contents_num-4, dist, nearest);
 				contents_num++;
 			}
 		}
 		if (contents_num-4 != nscen_) {
 			throw "invalid number of rows for Wasserstein distance\n";
 		}
+		coverWassersteinReferences(nearest);
 		isdro_ = true;
+		if (getNumWassersteinPairs() < nrefs_ * nscen_)
+			printf("[DRO] Kept %d of %d transport pairs.\n", getNumWassersteinPairs(), nrefs_ * nscen_);
 	} else {
 		char msg[128];
 		sprintf(msg, "unable to open file %s\n", filename);
@@ -484,63 +505,46 @@ DSP_RTN_CODE StoModel::setWassersteinAmbiguitySet(double lp_norm, double eps)
 	}
 
 	refs_probability_ = new double[nrefs_];
-	wass_dist_ = new double *[nrefs_];
-
-	/** Compute the Wasserstein distances of lp_norm,
-	 * and assign the reference probabilities.
-	 */
+	std::vector<int> refs(nrefs_);
 	for (int s = 0, r = 0; s < nscen_; ++s)
 	{
 		if (prob_[s] > 0)
 		{
 			refs_probability_[r] = prob_[s];
-			wass_dist_[r] = new double[nscen_];
-			CoinZeroN(wass_dist_[r], nscen_);
-			assert(mat_scen_[s]->getNumRows() == nrows_[1]);
-
-			/** Compute the distances.
-			 * 
-			 * TODO: Can we do in parallel?
-			 * The relevant issues need addressed first: 
-			 * - https://github.com/kibaekkim/DSPopt.jl/issues/14
-			 */
-			for (int ss = 0; ss < nscen_; ++ss)
-			{
-				for (int j = 0; j < ncols_[1]; ++j)
-				{
-					wass_dist_[r][ss] += pow(fabs((*obj_scen_[s])[j] - (*obj_scen_[ss])[j]), 2);
-					if ((*clbd_scen_[s])[j] > -1.e+20 && (*clbd_scen_[ss])[j] > -1.e+20)
-						wass_dist_[r][ss] += pow(fabs((*clbd_scen_[s])[j] - (*clbd_scen_[ss])[j]), 2);
-					if ((*cubd_scen_[s])[j] < 1.e+20 && (*cubd_scen_[ss])[j] < 1.e+20)
-						wass_dist_[r][ss] += pow(fabs((*cubd_scen_[s])[j] - (*cubd_scen_[ss])[j]), 2);
-				}
-				for (int i = 0; i < nrows_[1]; ++i)
-				{
-					if ((*rlbd_scen_[s])[i] > -1.e+20 && (*rlbd_scen_[ss])[i] > -1.e+20)
-						wass_dist_[r][ss] += pow(fabs((*rlbd_scen_[s])[i] - (*rlbd_scen_[ss])[i]), 2);
-					if ((*rubd_scen_[s])[i] < 1.e+20 && (*rubd_scen_[ss])[i] < 1.e+20)
-						wass_dist_[r][ss] += pow(fabs((*rubd_scen_[s])[i] - (*rubd_scen_[ss])[i]), 2);
-					for (int j = 0; j < mat_scen_[s]->getNumCols(); ++j)
-					{
-						wass_dist_[r][ss] += pow(fabs(mat_scen_[s]->getCoefficient(i, j) - mat_scen_[ss]->getCoefficient(i, j)), 2);
-					}
-				}
-				wass_dist_[r][ss] = pow(wass_dist_[r][ss], lp_norm / 2.0);
-			}
-			r++;
+			refs[r++] = s;
 		}
 	}
 
-	/** scaling vector */
+	/** Compute the Wasserstein distances of lp_norm from the references to each scenario,
+	 * and keep only the sparsified transport pairs.
+	 *
+	 * TODO: Can we do in parallel?
+	 * The relevant issues need addressed first: 
+	 * - https://github.com/kibaekkim/DSPopt.jl/issues/14
+	 */
+	wass_pairs_.assign(nscen_, CoinPackedVector());
+	std::vector<double> dist(nrefs_);
+	std::vector<std::pair<double,int> > nearest(nrefs_, std::make_pair(COIN_DBL_MAX, -1));
 	double scaling_constant = pow(wass_eps_, 2);
-	for (int r = 0; r < nrefs_; ++r)
-		for (int s = 0; s < nscen_; ++s)
-			scaling_constant += pow(wass_dist_[r][s], 2);
+	for (int ss = 0; ss < nscen_; ++ss)
+	{
+		for (int r = 0; r < nrefs_; ++r)
+		{
+			assert(mat_scen_[refs[r]]->getNumRows() == nrows_[1]);
+			dist[r] = getScenarioDistance(refs[r], ss, lp_norm);
+
+			/** The scaling accounts for all the pairs, including the dropped ones. */
+			scaling_constant += pow(dist[r], 2);
+		}
+		setWassersteinPairs(ss, dist, nearest);
+	}
+	coverWassersteinReferences(nearest);
+
+	/** scaling vector */
 	scaling_constant = sqrt(scaling_constant);
 	wass_eps_ /= scaling_constant;
-	for (int r = 0; r < nrefs_; ++r)
-		for (int s = 0; s < nscen_; ++s)
-			wass_dist_[r][s] /= scaling_constant;
+	for (int s = 0; s < nscen_; ++s)
+		wass_pairs_[s] /= scaling_constant;
 
 	/** Quadratic equations
 	 * TODO: The quadratic objective function and constraints need to be considered.
@@ -549,10 +553,89 @@ DSP_RTN_CODE StoModel::setWassersteinAmbiguitySet(double lp_norm, double eps)
 
 	printf("[DRO] Set %d reference scenarios.\n", nrefs_);
 	printf("[DRO] Computed the Wasserstein distances of order %f.\n", lp_norm);
+	if (getNumWassersteinPairs() < nrefs_ * nscen_)
+		printf("[DRO] Kept %d of %d transport pairs.\n", getNumWassersteinPairs(), nrefs_ * nscen_);
 
 	return DSP_RTN_OK;
 }
 
+/** dense copy of a sparse vector of the given length, of which the indices start from offset */
+static void scatterVector(int n, int offset, const CoinPackedVector * vec, std::vector<double> & dense)
+{
+	/** the buffer only grows so that it is allocated once over the calls */
+	if ((int) dense.size() < n)
+		dense.resize(n);
+	std::fill(dense.begin(), dense.begin() + n, 0.0);
+	for (int k = 0; k < vec->getNumElements(); ++k)
+	{
+		int j = vec->getIndices()[k] - offset;
+		if (j >= 0 && j < n)
+			dense[j] = vec->getElements()[k];
+	}
+}
+
+double StoModel::getScenarioDistance(int s, int t, double lp_norm)
+{
+	double dist = 0.0;
+	std::vector<double> & xs = dist_buf_[0];
+	std::vector<double> & xt = dist_buf_[1];
+
+	/** second-stage columns */
+	scatterVector(ncols_[1], cstart_[1], obj_scen_[s], xs);
+	scatterVector(ncols_[1], cstart_[1], obj_scen_[t], xt);
+	for (int j = 0; j < ncols_[1]; ++j)
+		dist += pow(xs[j] - xt[j], 2);
+	scatterVector(ncols_[1], cstart_[1], clbd_scen_[s], xs);
+	scatterVector(ncols_[1], cstart_[1], clbd_scen_[t], xt);
+	for (int j = 0; j < ncols_[1]; ++j)
+		if (xs[j] > -1.e+20 && xt[j] > -1.e+20)
+			dist += pow(xs[j] - xt[j], 2);
+	scatterVector(ncols_[1], cstart_[1], cubd_scen_[s], xs);
+	scatterVector(ncols_[1], cstart_[1], cubd_scen_[t], xt);
+	for (int j = 0; j < ncols_[1]; ++j)
+		if (xs[j] < 1.e+20 && xt[j] < 1.e+20)
+			dist += pow(xs[j] - xt[j], 2);
+
+	/** second-stage rows */
+	scatterVector(nrows_[1], rstart_[1], rlbd_scen_[s], xs);
+	scatterVector(nrows_[1], rstart_[1], rlbd_scen_[t], xt);
+	for (int i = 0; i < nrows_[1]; ++i)
+		if (xs[i] > -1.e+20 && xt[i] > -1.e+20)
+			dist += pow(xs[i] - xt[i], 2);
+	scatterVector(nrows_[1], rstart_[1], rubd_scen_[s], xs);
+	scatterVector(nrows_[1], rstart_[1], rubd_scen_[t], xt);
+	for (int i = 0; i < nrows_[1]; ++i)
+		if (xs[i] < 1.e+20 && xt[i] < 1.e+20)
+			dist += pow(xs[i] - xt[i], 2);
+
+	/** matrix rows, of which the difference is accumulated in a dense vector over the core columns */
+	int ncols = ncols_core_;
+	if ((int) xs.size() < ncols)
+		xs.resize(ncols);
+	std::fill(xs.begin(), xs.begin() + ncols, 0.0);
+	for (int i = 0; i < nrows_[1]; ++i)
+	{
+		const CoinShallowPackedVector rs = mat_scen_[s]->getVector(i);
+		const CoinShallowPackedVector rt = mat_scen_[t]->getVector(i);
+		for (int k = 0; k < rs.getNumElements(); ++k)
+			xs[rs.getIndices()[k]] += rs.getElements()[k];
+		for (int k = 0; k < rt.getNumElements(); ++k)
+			xs[rt.getIndices()[k]] -= rt.getElements()[k];
+		for (int k = 0; k < rs.getNumElements(); ++k)
+		{
+			dist += pow(xs[rs.getIndices()[k]], 2);
+			xs[rs.getIndices()[k]] = 0.0;
+		}
+		for (int k = 0; k < rt.getNumElements(); ++k)
+		{
+			dist += pow(xs[rt.getIndices()[k]], 2);
+			xs[rt.getIndices()[k]] = 0.0;
+		}
+	}
+
+	return pow(dist, lp_norm / 2.0);
+}
+
 void StoModel::normalizeProbability()
 {
 	double prob_sum = 0.0;
@@ -564,6 +647,85 @@ void StoModel::normalizeProbability()
 			prob_[s] /= prob_sum;
 }
 
+DSP_RTN_CODE StoModel::reduceScenarios(int nscen, int method, double * kantorovich)
+{
+	if (nstgs_ == 0 || nscen_ == 0)
+	{
+		std::cerr << "No scenario is loaded." << std::endl;
+		return DSP_RTN_ERR;
+	}
+	if (isdro_)
+	{
+		std::cerr << "The scenarios cannot be reduced after the ambiguity set is set." << std::endl;
+		return DSP_RTN_ERR;
+	}
+	if (kantorovich) *kantorovich = 0.0;
+	if (nscen <= 0 || nscen >= nscen_)
+		return DSP_RTN_OK;
+
+	BGN_TRY_CATCH
+
+	normalizeProbability();
+
+	/** Euclidean distance of the second-stage data, as in the Wasserstein ambiguity set */
+	std::function<double(int,int)> dist = [this](int s, int t) {
+		return getScenarioDistance(s, t, 1.0);
+	};
+	std::vector<double> prob(prob_, prob_ + nscen_);
+	std::vector<int> rep;
+	double reduced = method == SCEN_KMEDOIDS ?
+			DspKMedoids(nscen, nscen_, dist, prob, rep) :
+			DspBackwardReduction(nscen, nscen_, dist, prob, rep);
+	if (kantorovich) *kantorovich = reduced;
+
+	/** move the probabilities to the kept scenarios */
+	for (int s = 0; s < nscen_; ++s)
+		if (rep[s] != s)
+			prob_[rep[s]] += prob_[s];
+
+	/** compact the scenario data in place */
+	int nkept = 0;
+	for (int s = 0; s < nscen_; ++s)
+	{
+		if (rep[s] != s)
+		{
+			FREE_PTR(mat_scen_[s]);
+			FREE_PTR(clbd_scen_[s]);
+			FREE_PTR(cubd_scen_[s]);
+			FREE_PTR(obj_scen_[s]);
+			FREE_PTR(rlbd_scen_[s]);
+			FREE_PTR(rubd_scen_[s]);
+			continue;
+		}
+		prob_[nkept] = prob_[s];
+		mat_scen_[nkept] = mat_scen_[s];
+		clbd_scen_[nkept] = clbd_scen_[s];
+		cubd_scen_[nkept] = cubd_scen_[s];
+		obj_scen_[nkept] = obj_scen_[s];
+		rlbd_scen_[nkept] = rlbd_scen_[s];
+		rubd_scen_[nkept] = rubd_scen_[s];
+		if (nkept < s)
+		{
+			mat_scen_[s] = NULL;
+			clbd_scen_[s] = NULL;
+			cubd_scen_[s] = NULL;
+			obj_scen_[s] = NULL;
+			rlbd_scen_[s] = NULL;
+			rubd_scen_[s] = NULL;
+		}
+		nkept++;
+	}
+	nscen_ = nkept;
+
+	scen2stg_.clear();
+	for (int s = 0; s < nscen_; ++s)
+		scen2stg_.insert(std::pair<int,int>(s, 1));
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
 /** split core matrix row for a given stage */
 CoinPackedVector * StoModel::splitCoreRowVec(
 		int i,  /**< row index */
@@ -873,7 +1035,50 @@ double StoModel::getWassersteinDist(int i, int j) {
 		printf("Scenario index (%d) is out of range (%d).\n", j, nscen_);
 		return 0.0;
 	}
-	return wass_dist_[i][j];
+	/** The pair not in the sparsified set has the infinite distance. */
+	int pos = wass_pairs_[j].findIndex(i);
+	return pos < 0 ? COIN_DBL_MAX : wass_pairs_[j].getElements()[pos];
+}
+
+const CoinPackedVector * StoModel::getWassersteinPairs(int j) {
+	if (!isdro_ || j < 0 || j >= (int) wass_pairs_.size()) return NULL;
+	return &wass_pairs_[j];
+}
+
+int StoModel::getNumWassersteinPairs() {
+	int npairs = 0;
+	for (unsigned j = 0; j < wass_pairs_.size(); ++j)
+		npairs += wass_pairs_[j].getNumElements();
+	return npairs;
+}
+
+void StoModel::setWassersteinPairs(
+		int j,
+		const std::vector<double> & dist,
+		std::vector<std::pair<double,int> > & nearest) {
+	std::vector<int> keep;
+	double cutoff = wass_cutoff_ > 0 ? wass_cutoff_ * wass_eps_ : -1.0;
+	DspWassersteinSparsify(nrefs_, dist.data(), wass_knearest_, cutoff, keep);
+	wass_pairs_[j].clear();
+	wass_pairs_[j].reserve(keep.size());
+	for (unsigned k = 0; k < keep.size(); ++k)
+		wass_pairs_[j].insert(keep[k], dist[keep[k]]);
+	for (int r = 0; r < nrefs_; ++r)
+		if (dist[r] < nearest[r].first)
+			nearest[r] = std::make_pair(dist[r], j);
+}
+
+void StoModel::coverWassersteinReferences(const std::vector<std::pair<double,int> > & nearest) {
+	std::vector<bool> covered(nrefs_, false);
+	for (int j = 0; j < nscen_; ++j)
+		for (int k = 0; k < wass_pairs_[j].getNumElements(); ++k)
+			covered[wass_pairs_[j].getIndices()[k]] = true;
+	for (int r = 0; r < nrefs_; ++r) {
+		if (covered[r] || nearest[r].second < 0) continue;
+		CoinPackedVector & pairs = wass_pairs_[nearest[r].second];
+		pairs.insert(r, nearest[r].first);
+		pairs.sortIncrIndex();
+	}
 }
 
 double StoModel::getReferenceProbability(int i) {
@@ -885,3 +1090,510 @@ double StoModel::getReferenceProbability(int i) {
 	}
 	return refs_probability_[i];
 }
+
+/** MPS row type for the row bounds */
+static char mpsRowType(double rlbd, double rubd)
+{
+	if (rlbd == rubd)
+		return 'E';
+	else if (rlbd <= -1.0e+20 && rubd < 1.0e+20)
+		return 'L';
+	return 'G';
+}
+
+/** MPS right-hand side for the row bounds */
+static double mpsRowRhs(double rlbd, double rubd)
+{
+	if (mpsRowType(rlbd, rubd) == 'L')
+		return rubd;
+	return rlbd > -1.0e+20 ? rlbd : -1.0e+30;
+}
+
+/** whether the row is a ranged row */
+static bool mpsRowRanged(double rlbd, double rubd)
+{
+	return rlbd > -1.0e+20 && rubd < 1.0e+20 && rlbd != rubd;
+}
+
+/** write a name-name-value line of MPS */
+static void mpsWriteLine(std::ostream & os, const char * name1, const char * name2, double value)
+{
+	char buf[256];
+	snprintf(buf, sizeof(buf), "    %-12s %-12s %.15g\n", name1, name2, value);
+	os << buf;
+}
+
+/** write the bounds of a column to MPS */
+static void mpsWriteBounds(std::ostream & os, const char * name, double clbd, double cubd, char ctype)
+{
+	char buf[256];
+	if (ctype == 'B' && clbd == 0.0 && cubd == 1.0)
+	{
+		snprintf(buf, sizeof(buf), " BV BOUND     %s\n", name);
+		os << buf;
+		return;
+	}
+	if (clbd == cubd)
+	{
+		snprintf(buf, sizeof(buf), " FX BOUND     %-12s %.15g\n", name, clbd);
+		os << buf;
+		return;
+	}
+	if (clbd <= -1.0e+20 && cubd >= 1.0e+20)
+	{
+		snprintf(buf, sizeof(buf), " FR BOUND     %s\n", name);
+		os << buf;
+		return;
+	}
+	if (clbd <= -1.0e+20)
+		snprintf(buf, sizeof(buf), " MI BOUND     %s\n", name), os << buf;
+	else if (clbd != 0.0)
+		snprintf(buf, sizeof(buf), " LO BOUND     %-12s %.15g\n", name, clbd), os << buf;
+	/** integer columns need an explicit upper bound; otherwise some readers assume binary */
+	if (cubd < 1.0e+20 || ctype != 'C')
+		snprintf(buf, sizeof(buf), " UP BOUND     %-12s %.15g\n", name, CoinMin(cubd, 1.0e+30)), os << buf;
+}
+
+void StoModel::cloneScenario(
+		int              scen,
+		int              nscen,
+		const double *   perturb,
+		unsigned         seed,
+		ScenarioClone &  clone)
+{
+	int b = scen % nscen_;
+	int nclones = nscen / nscen_ + (b < nscen % nscen_ ? 1 : 0);
+
+	clone.base = b;
+	clone.prob = prob_[b] / nclones;
+
+	/** base scenario data */
+	clone.rlbd.assign(rlbd_core_[1], rlbd_core_[1] + nrows_[1]);
+	clone.rubd.assign(rubd_core_[1], rubd_core_[1] + nrows_[1]);
+	clone.obj.assign(obj_core_[1], obj_core_[1] + ncols_[1]);
+	combineRandRowLower(&clone.rlbd[0], 1, b);
+	combineRandRowUpper(&clone.rubd[0], 1, b);
+	combineRandObjective(&clone.obj[0], 1, b, false);
+	clone.rows.resize(nrows_[1]);
+	clone.rand_mat.resize(nrows_[1]);
+	for (int i = 0; i < nrows_[1]; ++i)
+	{
+		clone.rows[i] = *rows_core_[rstart_[1] + i];
+		combineRandRowVec(&clone.rows[i], i, b);
+		clone.rand_mat[i].assign(clone.rows[i].getNumElements(), false);
+	}
+
+	/** mark random data of the base scenario */
+	clone.rand_rhs.assign(nrows_[1], false);
+	clone.rand_obj.assign(ncols_[1], false);
+	for (int k = 0; k < rlbd_scen_[b]->getNumElements(); ++k)
+		clone.rand_rhs[rlbd_scen_[b]->getIndices()[k] - rstart_[1]] = true;
+	for (int k = 0; k < rubd_scen_[b]->getNumElements(); ++k)
+		clone.rand_rhs[rubd_scen_[b]->getIndices()[k] - rstart_[1]] = true;
+	for (int k = 0; k < obj_scen_[b]->getNumElements(); ++k)
+	{
+		int j = obj_scen_[b]->getIndices()[k] - cstart_[1];
+		if (j >= 0 && j < ncols_[1])
+			clone.rand_obj[j] = true;
+	}
+	for (int i = 0; i < nrows_[1]; ++i)
+	{
+		CoinBigIndex start = mat_scen_[b]->getVectorStarts()[i];
+		for (int k = 0; k < mat_scen_[b]->getVectorSize(i); ++k)
+		{
+			int pos = clone.rows[i].findIndex(mat_scen_[b]->getIndices()[start + k]);
+			if (pos >= 0)
+				clone.rand_mat[i][pos] = true;
+		}
+	}
+
+	if (perturb == NULL)
+		return;
+
+	/** The perturbation depends only on the seed and the scenario index. */
+	std::seed_seq seq = {seed, static_cast<unsigned>(scen)};
+	std::mt19937 rng(seq);
+	std::uniform_real_distribution<double> unif(-1.0, 1.0);
+
+	if (perturb[0] > 0.0)
+	{
+		for (int i = 0; i < nrows_[1]; ++i)
+		{
+			double factor = 1.0 + perturb[0] * unif(rng);
+			if (clone.rlbd[i] > -1.0e+20)
+				clone.rlbd[i] *= factor;
+			if (clone.rubd[i] < 1.0e+20)
+				clone.rubd[i] *= factor;
+			clone.rand_rhs[i] = true;
+		}
+	}
+	if (perturb[1] > 0.0)
+	{
+		for (int j = 0; j < ncols_[1]; ++j)
+		{
+			clone.obj[j] *= 1.0 + perturb[1] * unif(rng);
+			clone.rand_obj[j] = true;
+		}
+	}
+	if (perturb[2] > 0.0)
+	{
+		/** technology matrix and random recourse matrix elements */
+		for (int i = 0; i < nrows_[1]; ++i)
+		{
+			CoinPackedVector & row = clone.rows[i];
+			for (int k = 0; k < row.getNumElements(); ++k)
+			{
+				if (row.getIndices()[k] < cstart_[1] || clone.rand_mat[i][k])
+				{
+					row.setElement(k, row.getElements()[k] * (1.0 + perturb[2] * unif(rng)));
+					clone.rand_mat[i][k] = true;
+				}
+			}
+		}
+	}
+}
+
+DSP_RTN_CODE StoModel::writeSmps(
+		const char *   filename,
+		int            nscen,
+		const double * perturb,
+		unsigned       seed)
+{
+	if (nstgs_ != 2 || nscen_ <= 0)
+	{
+		std::cerr << "No two-stage stochastic problem is loaded." << std::endl;
+		return DSP_RTN_ERR;
+	}
+	if (nscen <= 0)
+		nscen = nscen_;
+	for (int k = 0; perturb != NULL && k < 3; ++k)
+		if (perturb[k] < 0.0 || perturb[k] >= 1.0)
+		{
+			std::cerr << "The relative perturbations must be in [0,1)." << std::endl;
+			return DSP_RTN_ERR;
+		}
+
+	BGN_TRY_CATCH
+
+	char fname[256];
+	char name[32];
+	char name2[32];
+	char buf[256];
+
+	/** random column bounds are not written */
+	for (int s = 0; s < nscen_; ++s)
+	{
+		for (int k = 0; k < clbd_scen_[s]->getNumElements(); ++k)
+		{
+			int j = clbd_scen_[s]->getIndices()[k] - cstart_[1];
+			if (j >= 0 && j < ncols_[1] && clbd_scen_[s]->getElements()[k] != clbd_core_[1][j])
+			{
+				std::cerr << "Warning: random column bounds are not written to SMPS." << std::endl;
+				s = nscen_;
+				break;
+			}
+		}
+	}
+
+	/** core column-wise matrix */
+	CoinPackedMatrix mat(false, 0, 0);
+	mat.setDimensions(0, ncols_core_);
+	for (int i = 0; i < nrows_core_; ++i)
+		mat.appendRow(*rows_core_[i]);
+	mat.reverseOrdering();
+
+	/** core file */
+	sprintf(fname, "%s.cor", filename);
+	std::ofstream cor(fname);
+	if (!cor.good())
+		throw "Failed to open the core file.";
+	cor << "NAME          DSPGEN\nROWS\n N  OBJ\n";
+	for (int stg = 0; stg < nstgs_; ++stg)
+		for (int i = 0; i < nrows_[stg]; ++i)
+			cor << " " << mpsRowType(rlbd_core_[stg][i], rubd_core_[stg][i]) << "  R" << rstart_[stg] + i << "\n";
+	cor << "COLUMNS\n";
+	bool intmarker = false;
+	for (int stg = 0; stg < nstgs_; ++stg)
+	{
+		for (int j = 0; j < ncols_[stg]; ++j)
+		{
+			int col = cstart_[stg] + j;
+			bool isint = ctype_core_[stg][j] != 'C';
+			if (isint != intmarker)
+			{
+				cor << "    MARKER       'MARKER'     " << (isint ? "'INTORG'" : "'INTEND'") << "\n";
+				intmarker = isint;
+			}
+			sprintf(name, "C%d", col);
+			mpsWriteLine(cor, name, "OBJ", obj_core_[stg][j]);
+			const CoinShallowPackedVector vec = mat.getVector(col);
+			for (int k = 0; k < vec.getNumElements(); ++k)
+			{
+				sprintf(name2, "R%d", vec.getIndices()[k]);
+				mpsWriteLine(cor, name, name2, vec.getElements()[k]);
+			}
+		}
+	}
+	if (intmarker)
+		cor << "    MARKER       'MARKER'     'INTEND'\n";
+	cor << "RHS\n";
+	for (int stg = 0; stg < nstgs_; ++stg)
+		for (int i = 0; i < nrows_[stg]; ++i)
+		{
+			sprintf(name, "R%d", rstart_[stg] + i);
+			mpsWriteLine(cor, "RHS", name, mpsRowRhs(rlbd_core_[stg][i], rubd_core_[stg][i]));
+		}
+	cor << "RANGES\n";
+	for (int stg = 0; stg < nstgs_; ++stg)
+		for (int i = 0; i < nrows_[stg]; ++i)
+			if (mpsRowRanged(rlbd_core_[stg][i], rubd_core_[stg][i]))
+			{
+				sprintf(name, "R%d", rstart_[stg] + i);
+				mpsWriteLine(cor, "RNG", name, rubd_core_[stg][i] - rlbd_core_[stg][i]);
+			}
+	cor << "BOUNDS\n";
+	for (int stg = 0; stg < nstgs_; ++stg)
+		for (int j = 0; j < ncols_[stg]; ++j)
+		{
+			sprintf(name, "C%d", cstart_[stg] + j);
+			mpsWriteBounds(cor, name, clbd_core_[stg][j], cubd_core_[stg][j], ctype_core_[stg][j]);
+		}
+	cor << "ENDATA\n";
+	cor.close();
+
+	/** time file */
+	sprintf(fname, "%s.tim", filename);
+	std::ofstream tim(fname);
+	if (!tim.good())
+		throw "Failed to open the time file.";
+	tim << "TIME          DSPGEN\nPERIODS       IMPLICIT\n";
+	sprintf(name, "C%d", cstart_[0]);
+	sprintf(name2, "R%d", rstart_[0]);
+	tim << "    " << name << "  " << (nrows_[0] > 0 ? name2 : "OBJ") << "  STAGE-1\n";
+	sprintf(name, "C%d", cstart_[1]);
+	sprintf(name2, "R%d", rstart_[1]);
+	tim << "    " << name << "  " << name2 << "  STAGE-2\n";
+	tim << "ENDATA\n";
+	tim.close();
+
+	/** stoch file */
+	sprintf(fname, "%s.sto", filename);
+	std::ofstream sto(fname);
+	if (!sto.good())
+		throw "Failed to open the stoch file.";
+	sto << "STOCH         DSPGEN\nSCENARIOS     DISCRETE\n";
+	ScenarioClone clone;
+	for (int s = 0; s < nscen; ++s)
+	{
+		cloneScenario(s, nscen, perturb, seed, clone);
+		snprintf(buf, sizeof(buf), " SC SCEN%d  ROOT  %.15g  STAGE-2\n", s + 1, clone.prob);
+		sto << buf;
+		for (int i = 0; i < nrows_[1]; ++i)
+		{
+			if (clone.rand_rhs[i] == false) continue;
+			sprintf(name, "R%d", rstart_[1] + i);
+			mpsWriteLine(sto, "RHS", name, mpsRowRhs(clone.rlbd[i], clone.rubd[i]));
+		}
+		for (int j = 0; j < ncols_[1]; ++j)
+		{
+			if (clone.rand_obj[j] == false) continue;
+			sprintf(name, "C%d", cstart_[1] + j);
+			mpsWriteLine(sto, name, "OBJ", clone.obj[j]);
+		}
+		for (int i = 0; i < nrows_[1]; ++i)
+		{
+			sprintf(name2, "R%d", rstart_[1] + i);
+			for (int k = 0; k < clone.rows[i].getNumElements(); ++k)
+			{
+				if (clone.rand_mat[i][k] == false) continue;
+				sprintf(name, "C%d", clone.rows[i].getIndices()[k]);
+				mpsWriteLine(sto, name, name2, clone.rows[i].getElements()[k]);
+			}
+		}
+	}
+	sto << "ENDATA\n";
+	sto.close();
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE StoModel::writeMpsDec(
+		const char *   filename,
+		int            nscen,
+		const double * perturb,
+		unsigned       seed)
+{
+	if (nstgs_ != 2 || nscen_ <= 0)
+	{
+		std::cerr << "No two-stage stochastic problem is loaded." << std::endl;
+		return DSP_RTN_ERR;
+	}
+	if (nscen <= 0)
+		nscen = nscen_;
+	for (int k = 0; perturb != NULL && k < 3; ++k)
+		if (perturb[k] < 0.0 || perturb[k] >= 1.0)
+		{
+			std::cerr << "The relative perturbations must be in [0,1)." << std::endl;
+			return DSP_RTN_ERR;
+		}
+
+	BGN_TRY_CATCH
+
+	char fname[256];
+	char name[64];
+	char name2[64];
+	ScenarioClone clone;
+
+	/** MPS file; the scenarios are cloned again in each section instead of being stored. */
+	sprintf(fname, "%s.mps", filename);
+	std::ofstream mps(fname);
+	if (!mps.good())
+		throw "Failed to open the MPS file.";
+	mps << "NAME          DSPGEN\nROWS\n N  OBJ\n";
+	for (int s = 0; s < nscen; ++s)
+	{
+		cloneScenario(s, nscen, NULL, seed, clone);
+		for (int i = 0; i < nrows_[0]; ++i)
+			mps << " " << mpsRowType(rlbd_core_[0][i], rubd_core_[0][i]) << "  S" << s << "_R" << i << "\n";
+		for (int i = 0; i < nrows_[1]; ++i)
+			mps << " " << mpsRowType(clone.rlbd[i], clone.rubd[i]) << "  S" << s << "_R" << rstart_[1] + i << "\n";
+	}
+	for (int s = 0; s < nscen - 1; ++s)
+		for (int j = 0; j < ncols_[0]; ++j)
+			mps << " E  NA" << s << "_" << j << "\n";
+
+	mps << "COLUMNS\n";
+	bool intmarker = false;
+	for (int s = 0; s < nscen; ++s)
+	{
+		cloneScenario(s, nscen, perturb, seed, clone);
+
+		/** column-wise scenario matrix */
+		CoinPackedMatrix mat(false, 0, 0);
+		mat.setDimensions(0, ncols_core_);
+		for (int i = 0; i < nrows_[0]; ++i)
+			mat.appendRow(*rows_core_[i]);
+		for (int i = 0; i < nrows_[1]; ++i)
+			mat.appendRow(clone.rows[i]);
+		mat.reverseOrdering();
+
+		for (int stg = 0; stg < nstgs_; ++stg)
+		{
+			for (int j = 0; j < ncols_[stg]; ++j)
+			{
+				int col = cstart_[stg] + j;
+				bool isint = ctype_core_[stg][j] != 'C';
+				if (isint != intmarker)
+				{
+					mps << "    MARKER       'MARKER'     " << (isint ? "'INTORG'" : "'INTEND'") << "\n";
+					intmarker = isint;
+				}
+				sprintf(name, "S%d_C%d", s, col);
+				mpsWriteLine(mps, name, "OBJ", clone.prob * (stg == 0 ? obj_core_[0][j] : clone.obj[j]));
+				const CoinShallowPackedVector vec = mat.getVector(col);
+				for (int k = 0; k < vec.getNumElements(); ++k)
+				{
+					sprintf(name2, "S%d_R%d", s, vec.getIndices()[k]);
+					mpsWriteLine(mps, name, name2, vec.getElements()[k]);
+				}
+				/** nonanticipativity: x_s - x_{s+1} = 0 */
+				if (stg == 0)
+				{
+					if (s > 0)
+					{
+						sprintf(name2, "NA%d_%d", s - 1, j);
+						mpsWriteLine(mps, name, name2, -1.0);
+					}
+					if (s < nscen - 1)
+					{
+						sprintf(name2, "NA%d_%d", s, j);
+						mpsWriteLine(mps, name, name2, 1.0);
+					}
+				}
+			}
+		}
+	}
+	if (intmarker)
+		mps << "    MARKER       'MARKER'     'INTEND'\n";
+
+	mps << "RHS\n";
+	for (int s = 0; s < nscen; ++s)
+	{
+		cloneScenario(s, nscen, perturb, seed, clone);
+		for (int i = 0; i < nrows_[0]; ++i)
+		{
+			sprintf(name, "S%d_R%d", s, i);
+			mpsWriteLine(mps, "RHS", name, mpsRowRhs(rlbd_core_[0][i], rubd_core_[0][i]));
+		}
+		for (int i = 0; i < nrows_[1]; ++i)
+		{
+			sprintf(name, "S%d_R%d", s, rstart_[1] + i);
+			mpsWriteLine(mps, "RHS", name, mpsRowRhs(clone.rlbd[i], clone.rubd[i]));
+		}
+	}
+
+	mps << "RANGES\n";
+	for (int s = 0; s < nscen; ++s)
+	{
+		cloneScenario(s, nscen, perturb, seed, clone);
+		for (int i = 0; i < nrows_[0]; ++i)
+			if (mpsRowRanged(rlbd_core_[0][i], rubd_core_[0][i]))
+			{
+				sprintf(name, "S%d_R%d", s, i);
+				mpsWriteLine(mps, "RNG", name, rubd_core_[0][i] - rlbd_core_[0][i]);
+			}
+		for (int i = 0; i < nrows_[1]; ++i)
+			if (mpsRowRanged(clone.rlbd[i], clone.rubd[i]))
+			{
+				sprintf(name, "S%d_R%d", s, rstart_[1] + i);
+				mpsWriteLine(mps, "RNG", name, clone.rubd[i] - clone.rlbd[i]);
+			}
+	}
+
+	mps << "BOUNDS\n";
+	std::vector<double> clbd(ncols_[1]), cubd(ncols_[1]);
+	for (int s = 0; s < nscen; ++s)
+	{
+		int b = s % nscen_;
+		copyCoreColLower(&clbd[0], 1);
+		copyCoreColUpper(&cubd[0], 1);
+		combineRandColLower(&clbd[0], 1, b);
+		combineRandColUpper(&cubd[0], 1, b);
+		for (int j = 0; j < ncols_[0]; ++j)
+		{
+			sprintf(name, "S%d_C%d", s, cstart_[0] + j);
+			mpsWriteBounds(mps, name, clbd_core_[0][j], cubd_core_[0][j], ctype_core_[0][j]);
+		}
+		for (int j = 0; j < ncols_[1]; ++j)
+		{
+			sprintf(name, "S%d_C%d", s, cstart_[1] + j);
+			mpsWriteBounds(mps, name, clbd[j], cubd[j], ctype_core_[1][j]);
+		}
+	}
+	mps << "ENDATA\n";
+	mps.close();
+
+	/** DEC file */
+	sprintf(fname, "%s.dec", filename);
+	std::ofstream dec(fname);
+	if (!dec.good())
+		throw "Failed to open the DEC file.";
+	dec << "PRESOLVED\n0\nNBLOCKS\n" << nscen << "\n";
+	for (int s = 0; s < nscen; ++s)
+	{
+		dec << "BLOCK " << s + 1 << "\n";
+		for (int i = 0; i < nrows_core_; ++i)
+			dec << "S" << s << "_R" << i << "\n";
+	}
+	dec << "MASTERCONSS\n";
+	for (int s = 0; s < nscen - 1; ++s)
+		for (int j = 0; j < ncols_[0]; ++j)
+			dec << "NA" << s << "_" << j << "\n";
+	dec.close();
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
@@ -9,6 +9,7 @@
 #define STOMODEL_H_
 
 #include <map>
+#include <vector>
 /** Coin */
 #include "CoinTime.hpp"
 #include "SmiScnModel.hpp"
@@ -47,6 +48,32 @@ public:
 	/** read DRO file */
 	DSP_RTN_CODE readDro(const char * filename);
 
+	/**
+	 * Write SMPS files (.cor, .tim and .sto). The scenarios are cloned from the
+	 * scenarios of this model in round-robin fashion, and the second-stage right-hand
+	 * sides, objective coefficients and technology matrix are randomly perturbed by
+	 * the relative amplitudes given in perturb. The amplitudes must be in [0,1) so
+	 * that the perturbed data keep their signs. The scenarios are written one at a
+	 * time, so the number of scenarios is not limited by the memory.
+	 */
+	DSP_RTN_CODE writeSmps(
+			const char *   filename,       /**< file name without extensions */
+			int            nscen = 0,      /**< number of scenarios (0 for the same number) */
+			const double * perturb = NULL, /**< relative perturbations of rhs, obj and matrix (NULL for none) */
+			unsigned       seed = 1        /**< random seed */);
+
+	/**
+	 * Write the extensive form in the block-angular MPS and DEC files, where each
+	 * block is a scenario with its own copy of the first-stage variables and the
+	 * nonanticipativity constraints are the master constraints. The scenarios are
+	 * cloned as in writeSmps.
+	 */
+	DSP_RTN_CODE writeMpsDec(
+			const char *   filename,       /**< file name without extensions */
+			int            nscen = 0,      /**< number of scenarios (0 for the same number) */
+			const double * perturb = NULL, /**< relative perturbations of rhs, obj and matrix (NULL for none) */
+			unsigned       seed = 1        /**< random seed */);
+
 	void __printData();
 
 public:
@@ -105,6 +132,24 @@ public:
 	 */
 	DSP_RTN_CODE setWassersteinAmbiguitySet(double lp_norm, double eps);
 
+	/**
+	 * Reduce the scenarios by the fast backward reduction or the k-medoids clustering,
+	 * where the distance of two scenarios is the Euclidean distance of their second-stage
+	 * data as in the Wasserstein ambiguity set. The probability of each removed scenario
+	 * is moved to the kept scenario representing it. This should be called before the
+	 * Wasserstein ambiguity set is set.
+	 */
+	DSP_RTN_CODE reduceScenarios(
+			int      nscen,              /**< number of scenarios to keep */
+			int      method,             /**< reduction method (DSP_SCEN_REDUCTION) */
+			double * kantorovich = NULL  /**< [out] Kantorovich distance of the reduced distribution */);
+
+	/**
+	 * distance of the second-stage data of two scenarios, raised to the power of lp_norm;
+	 * this reuses the scratch buffers of the model and is not reentrant.
+	 */
+	double getScenarioDistance(int s, int t, double lp_norm);
+
 	/** 
 	 * Nomalize probability vector
 	 */
@@ -188,10 +233,57 @@ public:
 	virtual int getNumReferences() {return nrefs_;}
 	virtual double getWassersteinSize() {return wass_eps_;}
 	virtual double getWassersteinDist(int i, int j);
+	virtual const CoinPackedVector * getWassersteinPairs(int j);
+	virtual int getNumWassersteinPairs();
 	virtual double getReferenceProbability(int i);
 
+	/**
+	 * Sparsify the Wasserstein ambiguity set by keeping only the transport pairs of
+	 * each scenario to its knearest references and/or within the distance cutoff
+	 * (relative to the Wasserstein ball size). This should be set before the set is
+	 * read or computed.
+	 */
+	void setWassersteinSparsity(
+			int knearest,  /**< number of the nearest references per scenario (all if nonpositive) */
+			double cutoff  /**< relative distance cutoff (none if nonpositive) */)
+	{
+		wass_knearest_ = knearest;
+		wass_cutoff_ = cutoff;
+	}
+
 protected:
 
+	/** sparsify and store the Wasserstein distances from the references to scenario j */
+	void setWassersteinPairs(
+			int j,                                       /**< [in] scenario index */
+			const std::vector<double> & dist,            /**< [in] distance from each reference */
+			std::vector<std::pair<double,int> > & nearest /**< [in/out] nearest scenario of each reference */);
+
+	/** keep at least one transport pair for each reference */
+	void coverWassersteinReferences(const std::vector<std::pair<double,int> > & nearest);
+
+	/** second-stage data of a cloned scenario */
+	struct ScenarioClone
+	{
+		int base;                           /**< base scenario index */
+		double prob;                        /**< probability */
+		std::vector<double> rlbd;           /**< row lower bounds */
+		std::vector<double> rubd;           /**< row upper bounds */
+		std::vector<double> obj;            /**< objective coefficients */
+		std::vector<CoinPackedVector> rows; /**< matrix rows (core column indices) */
+		std::vector<bool> rand_rhs;         /**< whether the row bound is random */
+		std::vector<bool> rand_obj;         /**< whether the objective coefficient is random */
+		std::vector<std::vector<bool> > rand_mat; /**< whether the row element is random */
+	};
+
+	/** clone and perturb a scenario of this model */
+	void cloneScenario(
+			int              scen,    /**< cloned scenario index */
+			int              nscen,   /**< number of cloned scenarios */
+			const double *   perturb, /**< relative perturbations of rhs, obj and matrix */
+			unsigned         seed,    /**< random seed */
+			ScenarioClone &  clone    /**< [out] cloned scenario */);
+
 	/*
 	 * Stage level data
 	 */
@@ -238,9 +330,13 @@ protected:
 	bool isdro_;                /**< is this distributionally robust? */
 	int nrefs_;                 /**< number of reference scenarios for DRO */
 	double wass_eps_;           /**< size of the Wasserstein ball */
-	double ** wass_dist_;       /**< Wasserstein distances between two realizations */
+	int wass_knearest_;         /**< number of the nearest references kept per scenario */
+	double wass_cutoff_;        /**< distance cutoff of the kept pairs relative to the ball size */
+	std::vector<CoinPackedVector> wass_pairs_; /**< Wasserstein distances of each scenario to the references in its transport pairs */
 	double * refs_probability_; /** probability vector of references */
 
+	std::vector<double> dist_buf_[2]; /**< scratch buffers of getScenarioDistance */
+
 public:
 
 #if 0
@@ -6,6 +6,8 @@
  */
 
 #include <algorithm>
+#include "Utility/DspScenarioBundle.h"
+#include "Model/DecTssModel.h"
 #include "Solver/Benders/BdMW.h"
 
 BdMW::BdMW(
@@ -35,3 +37,31 @@ BdMW::~BdMW() {
 	FREE_PTR(master_);
 	FREE_PTR(worker_);
 }
+
+DSP_RTN_CODE BdMW::setCutAggregation(SCIPconshdlrBenders * conshdlr) {
+	BGN_TRY_CATCH
+
+	int naux = conshdlr->getNumAuxVars();
+	DecTssModel * tss = dynamic_cast<DecTssModel*>(model_);
+
+	/** cluster the scenarios by their data */
+	if (par_->getBoolParam("BD/AGGR/CLUSTER") && tss && !tss->isDistributed() && naux > 1) {
+		std::vector<std::vector<double> > data(tss->getNumScenarios());
+		for (int s = 0; s < tss->getNumScenarios(); ++s)
+			DSP_RTN_CHECK_THROW(tss->getScenarioData(s, data[s]));
+		std::vector<int> clusters;
+		int nclusters = DspBundleScenarios(naux, data, clusters);
+		conshdlr->setAuxVarClusters(clusters);
+		message_->print(1, "Clustered %d scenarios for %d auxiliary variables.\n", tss->getNumScenarios(), nclusters);
+	}
+
+	/** adaptive aggregation of the cuts */
+	if (par_->getBoolParam("BD/AGGR/DYNAMIC") && naux > 1)
+		conshdlr->setDynamicAggregation(
+				par_->getDblParam("BD/AGGR/REFINE_TOL"),
+				par_->getIntParam("BD/AGGR/COARSEN_AGE"));
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
@@ -71,6 +71,13 @@ protected:
 	/** constraint handler */
 	virtual SCIPconshdlrBenders * constraintHandler() {return NULL;}
 
+	/**
+	 * Set the aggregation of the optimality cuts to the constraint handler. If BD/AGGR/CLUSTER
+	 * is set, each auxiliary variable approximates the recourse of a cluster of similar scenarios.
+	 * If BD/AGGR/DYNAMIC is set, the cuts of the auxiliary variables are adaptively aggregated.
+	 */
+	virtual DSP_RTN_CODE setCutAggregation(SCIPconshdlrBenders * conshdlr);
+
 public:
 
 	/** master pointer */
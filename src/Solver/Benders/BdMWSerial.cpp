@@ -119,6 +119,17 @@ SCIPconshdlrBenders* BdMWSerial::constraintHandler()
 	conshdlr->setDecModel(model_);
 	conshdlr->setBdSub(bdsub);
 	conshdlr->setOriginalVariables(si->getNumCols(), si->getScipVars(), naux);
+	DSP_RTN_CHECK_THROW(setCutAggregation(conshdlr));
+	if (par_->getBoolParam("BD/CUT_POOL"))
+		conshdlr->setCutPool(
+				par_->getDblParam("BD/CUT_POOL/PARALLELISM"),
+				par_->getIntParam("BD/CUT_POOL/MAX_AGE"),
+				par_->getIntParam("BD/CUT_POOL/PURGE_FREQ"));
+	if (par_->getBoolParam("BD/IN_OUT"))
+		conshdlr->setInOutStabilization(par_->getDblParam("BD/IN_OUT/ALPHA"));
+	SCIPconshdlrDrBenders * drconshdlr = dynamic_cast<SCIPconshdlrDrBenders*>(conshdlr);
+	if (drconshdlr)
+		drconshdlr->setClosedForm(par_->getBoolParam("DRO/CLOSED_FORM"));
 
 	END_TRY_CATCH_RTN(;, NULL)
 
@@ -9,12 +9,10 @@
 // #define DSP_PROFILE
 
 #include "Utility/DspUtility.h"
+#include "Utility/DspProfiler.h"
 #include "Model/TssModel.h"
 #include "Solver/Benders/BdSub.h"
-#include "SolverInterface/DspOsiScip.h"
-#include "SolverInterface/DspOsiClp.h"
-#include "SolverInterface/DspOsiCpx.h"
-#include "SolverInterface/DspOsiGrb.h"
+#include "SolverInterface/DspOsiFactory.h"
 
 BdSub::BdSub(DspParams *par) : par_(par),
 							   nsubprobs_(0),
@@ -43,6 +41,7 @@ BdSub::BdSub(DspParams *par) : par_(par),
 BdSub::BdSub(const BdSub &rhs) : par_(rhs.par_),
 								 nsubprobs_(rhs.nsubprobs_),
 								 recourse_has_integer_(rhs.recourse_has_integer_),
+								 core_point_(rhs.core_point_),
 								 names_statistics_(rhs.names_statistics_),
 								 count_statistics_(rhs.count_statistics_),
 								 time_statistics_(rhs.time_statistics_)
@@ -231,6 +230,9 @@ int BdSub::generateCuts(
 			doContinue = false;
 	}
 
+	if (par_->getBoolParam("BD/SUB/MAGNANTI_WONG"))
+		updateCorePoint(ncols, x);
+
 	END_TRY_CATCH(FREE_MEMORY)
 
 	/** free memory */
@@ -309,6 +311,7 @@ void BdSub::solveOneSubproblem(
 	/** collect statistics */
 	cgl->count_statistics_["create lpsub"]++;
 	cgl->time_statistics_["create lpsub"] += CoinGetTimeOfDay() - stime; // toc
+	DSP_PROFILE_TIME("bd/create_lpsub", CoinGetTimeOfDay() - stime);
 
 	/** solve feasibility problem */
 	int nAddedCols = 0;
@@ -375,6 +378,7 @@ void BdSub::solveOneSubproblem(
 	/** collect statistics */
 	cgl->count_statistics_["solve lpsub"]++;
 	cgl->time_statistics_["solve lpsub"] += CoinGetTimeOfDay() - stime; // toc
+	DSP_PROFILE_TIME("bd/solve_lpsub", CoinGetTimeOfDay() - stime);
 
 	/** update warmstart */
 	FREE_PTR(cgl->warm_start_[s]);
@@ -414,6 +418,10 @@ void BdSub::solveOneSubproblem(
 		/** calculate cut elements */
 		calculateCutElements(si->getNumRows(), si->getNumCols(),
 							 cgl->mat_mp_[s], rlbd, rubd, clbd, cubd, pi, rc, cutval[s], cutrhs[s]);
+
+		/** replace by the Pareto-optimal cut */
+		if (cgl->par_->getBoolParam("BD/SUB/MAGNANTI_WONG") && cgl->core_point_.size() > 0)
+			generateParetoCut(cgl, s, si, x, Tx[s], cutval[s], cutrhs[s]);
 	} else {
 		si->writeMps("subprob");
 	}
@@ -456,6 +464,7 @@ DSP_RTN_CODE BdSub::solveOneIntegerSubproblem(
 	/** collect statistics */
 	cgl->count_statistics_["create ipsub DspOsi"]++;
 	cgl->time_statistics_["create ipsub DspOsi"] += CoinGetTimeOfDay() - stime; // toc
+	DSP_PROFILE_TIME("bd/create_ipsub_dsposi", CoinGetTimeOfDay() - stime);
 	stime = CoinGetTimeOfDay();
 
 	/** mark integer variables */
@@ -480,6 +489,7 @@ DSP_RTN_CODE BdSub::solveOneIntegerSubproblem(
 	/** collect statistics */
 	cgl->count_statistics_["create ipsub"]++;
 	cgl->time_statistics_["create ipsub"] += CoinGetTimeOfDay() - stime; // toc
+	DSP_PROFILE_TIME("bd/create_ipsub", CoinGetTimeOfDay() - stime);
 	stime = CoinGetTimeOfDay();											 // tic
 
 	/** solve */
@@ -491,6 +501,7 @@ DSP_RTN_CODE BdSub::solveOneIntegerSubproblem(
 	/** collect statistics */
 	cgl->count_statistics_["solve ipsub"]++;
 	cgl->time_statistics_["solve ipsub"] += CoinGetTimeOfDay() - stime; // toc
+	DSP_PROFILE_TIME("bd/solve_ipsub", CoinGetTimeOfDay() - stime);
 
 	/** solution status */
 	cgl->status_[s] = DspOsi::dsp_status(si);
@@ -697,37 +708,88 @@ DSP_RTN_CODE BdSub::calculateCutElements(
 	return DSP_RTN_OK;
 }
 
+DSP_RTN_CODE BdSub::generateParetoCut(
+		BdSub *              cgl,
+		int                  s,
+		OsiSolverInterface * si,
+		const double *       x,
+		const double *       Tx,
+		double *             cutval,
+		double &             cutrhs)
+{
+	BGN_TRY_CATCH
+
+	const double * rlbd = cgl->cglp_[s]->si_->getRowLower();
+	const double * rubd = cgl->cglp_[s]->si_->getRowUpper();
+	const double * clbd = cgl->cglp_[s]->si_->getColLower();
+	const double * cubd = cgl->cglp_[s]->si_->getColUpper();
+	int ncols = cgl->mat_mp_[s]->getNumCols();
+	double eps = cgl->par_->getDblParam("BD/SUB/MAGNANTI_WONG/PERTURB");
+
+	/** T times the core point */
+	std::vector<double> Tcore(cgl->mat_mp_[s]->getNumRows());
+	cgl->mat_mp_[s]->times(&cgl->core_point_[0], &Tcore[0]);
+
+	/** move the row bounds to the perturbed point */
+	for (int i = si->getNumRows() - 1; i >= 0; --i)
+	{
+		double Tp = (Tx[i] + eps * Tcore[i]) / (1.0 + eps);
+		if (rlbd[i] > -1.0e+20)
+			si->setRowLower(i, rlbd[i] - Tp);
+		if (rubd[i] < 1.0e+20)
+			si->setRowUpper(i, rubd[i] - Tp);
+	}
+
+	double stime = CoinGetTimeOfDay();
+	si->resolve();
+	cgl->count_statistics_["solve lpsub"]++;
+	cgl->time_statistics_["solve lpsub"] += CoinGetTimeOfDay() - stime;
+	DSP_PROFILE_TIME("bd/solve_lpsub", CoinGetTimeOfDay() - stime);
+
+	if (DspOsi::dsp_status(si) == DSP_STAT_OPTIMAL)
+	{
+		std::vector<double> val(ncols, 0.0);
+		double rhs = 0.0;
+		calculateCutElements(si->getNumRows(), si->getNumCols(),
+				cgl->mat_mp_[s], rlbd, rubd, clbd, cubd,
+				si->getRowPrice(), si->getReducedCost(), &val[0], rhs);
+
+		/** cut values at x, of which the optimality cut is tight */
+		double tight = cutrhs, pareto = rhs;
+		for (int j = 0; j < ncols; ++j)
+		{
+			tight -= cutval[j] * x[j];
+			pareto -= val[j] * x[j];
+		}
+		DSPdebugMessage("  Pareto-optimal cut at x: %e (optimality cut %e)\n", pareto, tight);
+		if (pareto >= tight - 1.0e-6 * CoinMax(1.0, fabs(tight)))
+		{
+			CoinCopyN(&val[0], ncols, cutval);
+			cutrhs = rhs;
+		}
+	}
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+void BdSub::updateCorePoint(int ncols, const double * x)
+{
+	if (core_point_.empty())
+		core_point_.assign(x, x + ncols);
+	else
+	{
+		for (int j = 0; j < ncols; ++j)
+			core_point_[j] = 0.5 * (core_point_[j] + x[j]);
+	}
+}
+
 DspOsi * BdSub::createDspOsi(int solver) {
 	DspOsi * osi = NULL;
 	BGN_TRY_CATCH
 
-	switch (solver) {
-		case OsiScip:
-			osi = new DspOsiScip();
-			break;
-		case OsiCpx:
-#ifdef DSP_HAS_CPX
-			osi = new DspOsiCpx();
-#else
-			throw CoinError("Cplex is not available.", "createDspOsi", "BdSub");
-#endif
-			break;
-		case OsiGrb:
-#ifdef DSP_HAS_GRB
-			osi = new DspOsiGrb();
-#else
-			throw CoinError("Gurobi is not available.", "createDspOsi", "BdSub");
-#endif
-			break;
-		case OsiClp:
-			osi = new DspOsiClp();
-			break;
-		default:
-			char coinmsg[128];
-			sprintf(coinmsg, "Invalid parameter value (solver = %d)", solver);
-			throw CoinError(coinmsg, "createDspOsi", "BdSub");
-			break;
-	}
+	osi = DspOsiFactory::create(solver);
 
 	END_TRY_CATCH_RTN(;,osi);
 	return osi;
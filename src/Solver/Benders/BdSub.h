@@ -130,6 +130,24 @@ private:
 			double *       cutval,             /**< [out] cut coefficients */
 			double &       cutrhs              /**< [out] cut rhs */);
 
+	/**
+	 * Replace the optimality cut by a Pareto-optimal (Magnanti-Wong) cut. Among the optimal
+	 * dual solutions at x, the dual solution maximizing the cut at the core point is obtained
+	 * by solving the subproblem at (x + eps * core) / (1 + eps) for a small eps. The cut is
+	 * replaced only if it is still tight at x.
+	 */
+	static DSP_RTN_CODE generateParetoCut(
+			BdSub *              cgl,    /**< [in] cut generator */
+			int                  s,      /**< [in] scenario index */
+			OsiSolverInterface * si,     /**< [in] subproblem solved at x */
+			const double *       x,      /**< [in] first-stage solution */
+			const double *       Tx,     /**< [in] Tx */
+			double *             cutval, /**< [in/out] cut coefficients */
+			double &             cutrhs  /**< [in/out] cut rhs */);
+
+	/** move the core point toward the first-stage solution */
+	void updateCorePoint(int ncols, const double * x);
+
 protected:
 
 	DspParams * par_; /**< parameters */
@@ -145,6 +163,7 @@ protected:
 	double **             solutions_;  /**< subproblem solutions */
 	DSP_RTN_CODE *        status_;     /**< subproblem solution status */
 	bool recourse_has_integer_;        /**< whether the recourse has integer variables */
+	std::vector<double> core_point_;   /**< core point of the Magnanti-Wong cuts */
 
 	/** simple statistics */
 	vector<string> names_statistics_;
@@ -70,6 +70,7 @@ void SCIPconshdlrBaseBendersWorker::generateCutsBase(
 	int nsubprobs,			   /**< [in] number of subproblems */
 	int nvars,				   /**< [in] number of variables */
 	int naux,				   /**< [in] number of auxiliary variables */
+	const int *aux_index,	   /**< [in] auxiliary variable index of each subproblem */
 	double *x,				   /**< [in] master solution */
 	const double *probability, /**< [in] probability */
 	OsiCuts *cuts /**< [out] cuts generated */)
@@ -103,7 +104,7 @@ void SCIPconshdlrBaseBendersWorker::generateCutsBase(
 	}
 
 	/** aggregate cuts */
-	aggregateCutsBase(nsubprobs, nvars, naux, probability, cuts);
+	aggregateCutsBase(nsubprobs, nvars, naux, aux_index, probability, cuts);
 	DSPdebug(cuts->printCuts());
 	// cuts->printCuts();
 
@@ -116,6 +117,7 @@ void SCIPconshdlrBaseBendersWorker::aggregateCutsBase(
 	int nsubprobs,			   /**< [in] number of subproblems */
 	int nvars,				   /**< [in] number of variables */
 	int naux,				   /**< [in] number of auxiliary variables */
+	const int *aux_index,	   /**< [in] auxiliary variable index of each subproblem */
 	const double *probability, /**< [in] probability */
 	OsiCuts *cuts /**< [out] cuts generated */)
 {
@@ -174,7 +176,7 @@ void SCIPconshdlrBaseBendersWorker::aggregateCutsBase(
 			break;
 		}
 
-		int ind_aux = cut_index_[i] % naux;
+		int ind_aux = aux_index[cut_index_[i]];
 
 		/** calculate weighted aggregation of cuts */
 		for (int j = 0; j < nvars; ++j)
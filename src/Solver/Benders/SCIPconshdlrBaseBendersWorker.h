@@ -26,6 +26,7 @@ protected:
 		int nsubprobs,			   /**< [in] number of subproblems */
 		int nvars,				   /**< [in] number of variables */
 		int naux,				   /**< [in] number of auxiliary variables */
+		const int *aux_index,	   /**< [in] auxiliary variable index of each subproblem */
 		double *x,				   /**< [in] master solution */
 		const double *probability, /**< [in] probability */
 		OsiCuts *cuts /**< [out] cuts generated */);
@@ -35,6 +36,7 @@ protected:
 		int nsubprobs,			   /**< [in] number of subproblems */
 		int nvars,				   /**< [in] number of variables */
 		int naux,				   /**< [in] number of auxiliary variables */
+		const int *aux_index,	   /**< [in] auxiliary variable index of each subproblem */
 		const double *probability, /**< [in] probability */
 		OsiCuts *cuts /**< [out] cuts generated */);
 
@@ -12,6 +12,7 @@
 
 /** DSP */
 #include "Utility/DspMessage.h"
+#include "Utility/DspProfiler.h"
 #include "Model/TssModel.h"
 #include "Solver/Benders/SCIPconshdlrBenders.h"
 
@@ -79,7 +80,17 @@ SCIPconshdlrBenders::SCIPconshdlrBenders(
 	  nvars_(0),
 	  vars_(NULL),
 	  naux_(0),
-	  probability_(NULL)
+	  probability_(NULL),
+	  dynamic_aggr_(false),
+	  refine_tol_(0.1),
+	  coarsen_age_(20),
+	  cutpool_(NULL),
+	  purge_freq_(1),
+	  nrounds_(0),
+	  nfiltered_(0),
+	  stab_alpha0_(0.0),
+	  stab_alpha_(0.0),
+	  nfallbacks_(0)
 {
 #ifdef BENDERS_PROFILE
 	/** initialize statistics */
@@ -98,6 +109,26 @@ SCIPconshdlrBenders::~SCIPconshdlrBenders()
 #ifdef BENDERS_PROFILE
 	write_statistics();
 #endif
+	FREE_PTR(cutpool_);
+}
+
+/** solving process deinitialization method of constraint handler (called before branch and bound process data is freed) */
+SCIP_DECL_CONSEXITSOL(SCIPconshdlrBenders::scip_exitsol)
+{
+	/** release the rows of the cut pool */
+	for (std::map<int, SCIP_ROW*>::iterator it = pool_rows_.begin(); it != pool_rows_.end(); ++it)
+		SCIP_CALL(SCIPreleaseRow(scip, &(it->second)));
+	pool_rows_.clear();
+	if (cutpool_)
+	{
+		DSPdebugMessage("cut pool: filtered %d, purged %d\n", nfiltered_, cutpool_->getNumPurged());
+		cutpool_->clear();
+	}
+	if (stab_alpha0_ > 0.0)
+		DSPdebugMessage("in-out stabilization: %d fall-backs\n", nfallbacks_);
+	stab_center_.clear();
+
+	return SCIP_OKAY;
 }
 
 /** destructor of constraint handler to free user data (called when SCIP is exiting) */
@@ -201,7 +232,8 @@ SCIP_RETCODE SCIPconshdlrBenders::generate_Benders(
 	SCIP *scip,
 	SCIP_CONSHDLR *conshdlr,
 	SCIP_SOL *sol,
-	OsiCuts *cs)
+	OsiCuts *cs,
+	bool update)
 {
 	SCIP_Real *vals = NULL; /**< current solution */
 
@@ -212,7 +244,25 @@ SCIP_RETCODE SCIPconshdlrBenders::generate_Benders(
 	SCIP_CALL(SCIPgetSolVals(scip, sol, nvars_, vars_, vals));
 
 	/** generate Benders cuts */
-	generateCuts(nvars_, vals, cs);
+	generateAtPoint(vals, vals, cs, update);
+
+	/** free memory */
+	SCIPfreeMemoryArray(scip, &vals);
+
+	return SCIP_OKAY;
+}
+
+void SCIPconshdlrBenders::generateAtPoint(
+	double *point,
+	const double *vals,
+	OsiCuts *cs,
+	bool update)
+{
+	/** generate Benders cuts */
+	generateCuts(nvars_, point, cs);
+
+	/** aggregate the cuts in the groups of auxiliary variables */
+	groupCuts(point, cs, update);
 
 	/** If found Benders cuts */
 	for (int i = 0; i < cs->sizeCuts(); ++i)
@@ -228,6 +278,66 @@ SCIP_RETCODE SCIPconshdlrBenders::generate_Benders(
 		else
 			rc->setEffectiveness(rc->violated(vals) / cutrow.twoNorm());
 	}
+}
+
+SCIP_RETCODE SCIPconshdlrBenders::generateStabilized(
+	SCIP *scip,
+	SCIP_CONSHDLR *conshdlr,
+	SCIP_SOL *sol,
+	OsiCuts *cs)
+{
+	SCIP_Real *vals = NULL; /**< current solution */
+
+	/** allocate memory */
+	SCIP_CALL(SCIPallocMemoryArray(scip, &vals, nvars_));
+
+	/** get current solution */
+	SCIP_CALL(SCIPgetSolVals(scip, sol, nvars_, vars_, vals));
+
+	/** the first solution is the stability center */
+	if (stab_center_.empty())
+		stab_center_.assign(vals, vals + nvars_);
+
+	/** separation point between the stability center and the solution */
+	std::vector<double> point(nvars_);
+	for (int j = 0; j < nvars_; ++j)
+		point[j] = stab_alpha_ * stab_center_[j] + (1.0 - stab_alpha_) * vals[j];
+
+	/** generate Benders cuts at the separation point */
+	generateAtPoint(&point[0], vals, cs, true);
+
+	/** count the cuts violated at the solution and at the separation point */
+	int nviolated = 0;
+	int nseparated = 0;
+	for (int i = 0; i < cs->sizeCuts(); ++i)
+	{
+		OsiRowCut *rc = cs->rowCutPtr(i);
+		if (!rc || rc->row().getNumElements() == 0)
+			continue;
+		if (SCIPisGT(scip, rc->effectiveness(), 0.0))
+			nviolated++;
+		if (SCIPisFeasPositive(scip, rc->violated(&point[0])))
+			nseparated++;
+	}
+
+	/** the separation point is in the epigraph, and becomes the stability center */
+	if (nseparated == 0)
+		stab_center_ = point;
+
+	if (nviolated > 0)
+		stab_alpha_ = CoinMin(stab_alpha0_, stab_alpha_ + 0.1);
+	else if (stab_alpha_ > 0.0)
+	{
+		stab_alpha_ = stab_alpha_ < 0.1 ? 0.0 : 0.5 * stab_alpha_;
+
+		/** fall back to the solution, which keeps the cuts at the separation point in the pool */
+		OsiCuts fallback;
+		generateAtPoint(vals, vals, &fallback, false);
+		for (int i = 0; i < fallback.sizeRowCuts(); ++i)
+			cs->insert(fallback.rowCut(i));
+		nfallbacks_++;
+	}
+	DSPdebugMessage("in-out: violated %d, separated %d, alpha %f\n", nviolated, nseparated, stab_alpha_);
 
 	/** free memory */
 	SCIPfreeMemoryArray(scip, &vals);
@@ -246,8 +356,15 @@ SCIP_RETCODE SCIPconshdlrBenders::sepaBenders(
 	/**< Benders cut placeholder */
 	OsiCuts cs;
 
-	/** generate Benders cuts */
-	SCIP_CALL(generate_Benders(scip, conshdlr, sol, &cs));
+	/** age the cuts in the pool and purge the old cuts */
+	if (cutpool_)
+		SCIP_CALL(updateCutPool(scip, sol));
+
+	/** generate Benders cuts, at the in-out separation point at the root */
+	if (stab_alpha0_ > 0.0 && sol == NULL && SCIPgetDepth(scip) <= 0)
+		SCIP_CALL(generateStabilized(scip, conshdlr, sol, &cs));
+	else
+		SCIP_CALL(generate_Benders(scip, conshdlr, sol, &cs, true));
 
 	/** If found Benders cuts */
 	for (int i = 0; i < cs.sizeCuts(); ++i)
@@ -277,12 +394,35 @@ SCIP_RETCODE SCIPconshdlrBenders::sepaBenders(
 		if (SCIPgetStage(scip) == SCIP_STAGE_INITSOLVE ||
 			SCIPgetStage(scip) == SCIP_STAGE_SOLVING)
 		{
-			/** create empty row */
 			SCIP_ROW * row = NULL;
+
+			/** filter the cut by the parallel cuts in the pool */
+			if (cutpool_)
+			{
+				int id = -1;
+				SCIP_CALL(findPoolCut(scip, sol, cutrow, rc->lb(), &id, &row));
+				if (id >= 0 && (row || !SCIPisGT(scip, rc->effectiveness(), 0.0)))
+				{
+					/** add the pooled cut instead */
+					if (row && !SCIProwIsInLP(row))
+					{
+						SCIP_Bool infeasible;
+						SCIP_CALL(SCIPaddRow(scip, row, BENDERS_CUT_FORCE, &infeasible));
+						if (infeasible || *result == SCIP_CUTOFF)
+							*result = SCIP_CUTOFF;
+						else
+							*result = SCIP_SEPARATED;
+					}
+					nfiltered_++;
+					continue;
+				}
+			}
+
+			/** create empty row */
 			SCIP_CALL(SCIPcreateEmptyRowConshdlr(scip, &row, conshdlr, "benders", rc->lb(), SCIPinfinity(scip),
 					FALSE, /**< is row local? */
 					FALSE, /**< is row modifiable? */
-					BENDERS_CUT_REMOVABLE  /**< is row removable? can this be TRUE? */));
+					cutpool_ ? TRUE : BENDERS_CUT_REMOVABLE  /**< is row removable? can this be TRUE? */));
 
 			/** cache the row extension and only flush them if the cut gets added */
 			SCIP_CALL(SCIPcacheRowExtensions(scip, row));
@@ -322,6 +462,10 @@ SCIP_RETCODE SCIPconshdlrBenders::sepaBenders(
 			SCIP_CALL(SCIPaddPoolCut(scip, row));
 			DSPdebugMessage("number of cuts in global cut pool: %d\n", SCIPgetNPoolCuts(scip));
 
+			/** keep track of the cut */
+			if (cutpool_)
+				SCIP_CALL(storePoolCut(scip, row, cutrow, rc->lb()));
+
 			/** release the row */
 			SCIP_CALL(SCIPreleaseRow(scip, &row));
 		}
@@ -331,6 +475,7 @@ SCIP_RETCODE SCIPconshdlrBenders::sepaBenders(
 	time_statistics_["sepaBenders"] += CoinGetTimeOfDay() - stime;
 	count_statistics_["sepaBenders"]++;
 #endif
+	DSP_PROFILE_TIME("bd/sepa", CoinGetTimeOfDay() - stime);
 
 	return SCIP_OKAY;
 }
@@ -372,6 +517,7 @@ SCIP_RETCODE SCIPconshdlrBenders::checkBenders(
 	time_statistics_["checkBenders"] += CoinGetTimeOfDay() - stime;
 	count_statistics_["checkBenders"]++;
 #endif
+	DSP_PROFILE_TIME("bd/check", CoinGetTimeOfDay() - stime);
 
 	return SCIP_OKAY;
 }
@@ -401,9 +547,261 @@ SCIP_RETCODE SCIPconshdlrBenders::setOriginalVariables(
 	for (int j = 0; j < nvars_; ++j)
 		vars_[j] = vars[j];
 	naux_ = naux;
+
+	/** approximate the recourse of subproblem s by auxiliary variable s % naux */
+	int nsubprobs = model_ ? model_->getNumSubproblems() : 0;
+	aux_index_.resize(nsubprobs);
+	for (int s = 0; s < nsubprobs; ++s)
+		aux_index_[s] = s % naux_;
+
+	/** no aggregation of the auxiliary variables */
+	aux_group_.resize(naux_);
+	for (int j = 0; j < naux_; ++j)
+		aux_group_[j] = j;
+	group_age_.assign(naux_, 0);
+
 	return SCIP_OKAY;
 }
 
+void SCIPconshdlrBenders::setAuxVarClusters(
+		const std::vector<int> & clusters /**< [in] auxiliary variable index of each subproblem */)
+{
+	assert((int) clusters.size() == (int) aux_index_.size());
+	for (unsigned s = 0; s < clusters.size(); ++s)
+		if (clusters[s] >= 0 && clusters[s] < naux_)
+			aux_index_[s] = clusters[s];
+}
+
+void SCIPconshdlrBenders::setDynamicAggregation(
+		double refine_tol, /**< [in] relative violation lost by the aggregation to refine the group */
+		int    coarsen_age /**< [in] number of rounds without violation to coarsen the group */)
+{
+	dynamic_aggr_ = true;
+	refine_tol_ = refine_tol;
+	coarsen_age_ = coarsen_age;
+
+	/** start from the single-cut aggregation */
+	aux_group_.assign(naux_, 0);
+	group_age_.assign(1, 0);
+}
+
+int SCIPconshdlrBenders::getNumAuxGroups()
+{
+	int ngroups = 0;
+	for (unsigned j = 0; j < aux_group_.size(); ++j)
+		ngroups = CoinMax(ngroups, aux_group_[j] + 1);
+	return ngroups;
+}
+
+void SCIPconshdlrBenders::setCutPool(
+		double parallelism, /**< [in] minimum cosine of the parallel cuts */
+		int    max_age,     /**< [in] number of rounds at which a cut is not tight before purging */
+		int    purge_freq   /**< [in] number of rounds between purging */)
+{
+	FREE_PTR(cutpool_);
+	cutpool_ = new DspCutPool(parallelism, max_age);
+	purge_freq_ = CoinMax(1, purge_freq);
+}
+
+void SCIPconshdlrBenders::setInOutStabilization(
+		double alpha /**< [in] initial weight of the stability center in [0,1) */)
+{
+	stab_alpha0_ = CoinMax(0.0, CoinMin(alpha, 0.99));
+	stab_alpha_ = stab_alpha0_;
+	stab_center_.clear();
+	nfallbacks_ = 0;
+}
+
+SCIP_RETCODE SCIPconshdlrBenders::findPoolCut(
+		SCIP *scip,                       /**< [in] scip pointer */
+		SCIP_SOL *sol,                    /**< [in] solution (NULL for the LP solution) */
+		const CoinPackedVector & cutrow,  /**< [in] cut row */
+		double lb,                        /**< [in] cut lower bound */
+		int * id,                         /**< [out] index of the parallel cut in the pool, or -1 */
+		SCIP_ROW ** row                   /**< [out] row of the parallel cut if violated; NULL otherwise */)
+{
+	*row = NULL;
+	*id = cutpool_->find(cutrow, lb);
+	if (*id >= 0)
+	{
+		SCIP_ROW * prow = pool_rows_[*id];
+		/** The parallel cut may not be violated, since the parallelism is not exact. */
+		if (SCIPisFeasLT(scip, SCIPgetRowSolActivity(scip, prow, sol), SCIProwGetLhs(prow)))
+			*row = prow;
+	}
+	return SCIP_OKAY;
+}
+
+SCIP_RETCODE SCIPconshdlrBenders::storePoolCut(
+		SCIP *scip,                       /**< [in] scip pointer */
+		SCIP_ROW *row,                    /**< [in] cut row added to SCIP */
+		const CoinPackedVector & cutrow,  /**< [in] cut row */
+		double lb                         /**< [in] cut lower bound */)
+{
+	int id = cutpool_->insert(cutrow, lb);
+	SCIP_CALL(SCIPcaptureRow(scip, row));
+	pool_rows_[id] = row;
+	return SCIP_OKAY;
+}
+
+SCIP_RETCODE SCIPconshdlrBenders::updateCutPool(
+		SCIP *scip,   /**< [in] scip pointer */
+		SCIP_SOL *sol /**< [in] solution (NULL for the LP solution) */)
+{
+	SCIP_Real *vals = NULL; /**< current solution */
+
+	/** age the cuts at the current solution */
+	SCIP_CALL(SCIPallocMemoryArray(scip, &vals, nvars_));
+	SCIP_CALL(SCIPgetSolVals(scip, sol, nvars_, vars_, vals));
+	cutpool_->age(vals);
+	SCIPfreeMemoryArray(scip, &vals);
+
+	/** purge the old cuts from the global cut pool */
+	if (++nrounds_ % purge_freq_ == 0)
+	{
+		std::vector<int> removed;
+		cutpool_->purge(removed);
+		for (unsigned i = 0; i < removed.size(); ++i)
+		{
+			SCIP_ROW * row = pool_rows_[removed[i]];
+			if (SCIProwIsInGlobalCutpool(row))
+				SCIP_CALL(SCIPdelPoolCut(scip, row));
+			SCIP_CALL(SCIPreleaseRow(scip, &row));
+			pool_rows_.erase(removed[i]);
+		}
+		DSPdebugMessage("purged %lu cuts from the pool of %lu cuts\n", removed.size(), cutpool_->size());
+	}
+
+	return SCIP_OKAY;
+}
+
+void SCIPconshdlrBenders::groupCuts(
+		const double * x, /**< [in] master solution */
+		OsiCuts * cuts,   /**< [in/out] cuts generated */
+		bool update       /**< [in] update the aggregation groups */)
+{
+	int ngroups = getNumAuxGroups();
+
+	/** nothing to aggregate */
+	if (ngroups == naux_ && dynamic_aggr_ == false)
+		return;
+
+	/** The optimality cuts are given for each auxiliary variable;
+	 * otherwise, we have a feasibility cut, which is not aggregated. */
+	if (cuts->sizeCuts() != naux_)
+		return;
+	std::vector<double> viol(naux_, 0.0);
+	for (int j = 0; j < naux_; ++j)
+	{
+		OsiRowCut * rc = cuts->rowCutPtr(j);
+		if (!rc || rc->row().findIndex(nvars_ - naux_ + j) < 0)
+			return;
+		viol[j] = rc->lb() - rc->row().dotProduct(x);
+	}
+
+	BGN_TRY_CATCH
+
+	if (dynamic_aggr_ && update)
+	{
+		/** violations of the aggregated cut and its disaggregated cuts */
+		std::vector<double> aggviol(ngroups, 0.0);
+		std::vector<double> sumviol(ngroups, 0.0);
+		std::vector<int> gsize(ngroups, 0);
+		for (int j = 0; j < naux_; ++j)
+		{
+			aggviol[aux_group_[j]] += viol[j];
+			sumviol[aux_group_[j]] += CoinMax(viol[j], 0.0);
+			gsize[aux_group_[j]]++;
+		}
+
+		int nnew = ngroups;
+		for (int g = 0; g < ngroups; ++g)
+		{
+			if (gsize[g] > 1 && sumviol[g] > 1.0e-6 &&
+				sumviol[g] - CoinMax(aggviol[g], 0.0) > refine_tol_ * sumviol[g])
+			{
+				/** refine: move the second half of the group to a new group */
+				int count = 0;
+				for (int j = 0; j < naux_; ++j)
+					if (aux_group_[j] == g && count++ >= gsize[g] / 2)
+						aux_group_[j] = nnew;
+				nnew++;
+				group_age_[g] = 0;
+				group_age_.push_back(0);
+				DSPdebugMessage("Refined aggregation group %d\n", g);
+			}
+			else if (aggviol[g] > 1.0e-6)
+				group_age_[g] = 0;
+			else
+				group_age_[g]++;
+		}
+
+		/** coarsen: merge the groups of which cuts have not been violated */
+		int merged = -1, nmerged = 0;
+		for (int g = 0; g < nnew; ++g)
+		{
+			if (group_age_[g] < coarsen_age_) continue;
+			if (merged < 0)
+				merged = g;
+			else
+			{
+				for (int j = 0; j < naux_; ++j)
+					if (aux_group_[j] == g)
+						aux_group_[j] = merged;
+				nmerged++;
+				DSPdebugMessage("Merged aggregation group %d into %d\n", g, merged);
+			}
+		}
+
+		/** number the groups in the order of their first auxiliary variables */
+		std::vector<int> index(nnew, -1);
+		std::vector<int> age;
+		for (int j = 0; j < naux_; ++j)
+		{
+			int g = aux_group_[j];
+			if (index[g] < 0)
+			{
+				index[g] = age.size();
+				age.push_back(g == merged && nmerged > 0 ? 0 : group_age_[g]);
+			}
+			aux_group_[j] = index[g];
+		}
+		group_age_ = age;
+		ngroups = age.size();
+	}
+
+	/** sum up the cuts in each group */
+	OsiCuts aggcuts;
+	std::vector<double> aggval(nvars_);
+	for (int g = 0; g < ngroups; ++g)
+	{
+		double aggrhs = 0.0;
+		CoinZeroN(&aggval[0], nvars_);
+		for (int j = 0; j < naux_; ++j)
+		{
+			if (aux_group_[j] != g) continue;
+			const CoinPackedVector & row = cuts->rowCutPtr(j)->row();
+			for (int k = 0; k < row.getNumElements(); ++k)
+				aggval[row.getIndices()[k]] += row.getElements()[k];
+			aggrhs += cuts->rowCutPtr(j)->lb();
+		}
+
+		CoinPackedVector vec;
+		for (int k = 0; k < nvars_; ++k)
+			if (fabs(aggval[k]) > 1e-10)
+				vec.insert(k, aggval[k]);
+
+		OsiRowCut rc;
+		rc.setRow(vec);
+		rc.setUb(COIN_DBL_MAX);
+		rc.setLb(fabs(aggrhs) < 1E-10 ? 0.0 : aggrhs);
+		aggcuts.insert(rc);
+	}
+	*cuts = aggcuts;
+
+	END_TRY_CATCH(;)
+}
+
 void SCIPconshdlrBenders::generateCuts(
 	int size,  /**< [in] size of x */
 	double *x, /**< [in] master solution */
@@ -514,7 +912,7 @@ void SCIPconshdlrBenders::aggregateCuts(
 		}
 
 		int s = bdsub_->getSubprobIndex(i);         /**< subproblem index */
-		int ind_aux = s % naux_;
+		int ind_aux = aux_index_[s];
 
 		/** calculate weighted aggregation of cuts */
 		for (int j = 0; j < nvars_; ++j)
@@ -12,6 +12,7 @@
 #include "objscip/objconshdlr.h"
 #include "Model/DecModel.h"
 #include "Solver/Benders/BdSub.h"
+#include "Utility/DspCutPool.h"
 #include "OsiCuts.hpp"
 
 /** A base class for implementing Benders constraint handler */
@@ -27,6 +28,9 @@ public:
 	/** destructor of constraint handler to free user data (called when SCIP is exiting) */
 	virtual SCIP_DECL_CONSFREE(scip_free);
 
+	/** solving process deinitialization method of constraint handler (called before branch and bound process data is freed) */
+	virtual SCIP_DECL_CONSEXITSOL(scip_exitsol);
+
 	/** transforms constraint data into data belonging to the transformed problem */
 	virtual SCIP_DECL_CONSTRANS(scip_trans);
 
@@ -84,13 +88,75 @@ public:
 			SCIP_Var ** vars, /**< original variables, including auxiliary variables */
 			int         naux  /**< number of auxiliary variables */);
 
+	/**
+	 * Set the auxiliary variable of each subproblem, so that each auxiliary variable
+	 * approximates the recourse of a cluster of subproblems. By default, subproblem s
+	 * is approximated by auxiliary variable s % naux.
+	 */
+	virtual void setAuxVarClusters(
+			const std::vector<int> & clusters /**< [in] auxiliary variable index of each subproblem */);
+
+	/**
+	 * Enable the dynamic aggregation of the optimality cuts. The auxiliary variables
+	 * are initially aggregated into a single group, which has a single optimality cut
+	 * on the sum of the auxiliary variables. A group is split in halves if the
+	 * aggregation cancels out more than refine_tol of the violations of its
+	 * disaggregated cuts, and the groups of which cuts have not been violated for
+	 * coarsen_age rounds are merged.
+	 */
+	virtual void setDynamicAggregation(
+			double refine_tol, /**< [in] relative violation lost by the aggregation to refine the group */
+			int    coarsen_age /**< [in] number of rounds without violation to coarsen the group */);
+
+	/** get number of groups of the auxiliary variables with aggregated cuts */
+	virtual int getNumAuxGroups();
+
+	/**
+	 * Manage the Benders cuts in a cut pool. A new cut is not added if a cut in the
+	 * pool is parallel and at least as strong, and the cuts that have not been tight
+	 * for max_age separation rounds are removed from the SCIP global cut pool every
+	 * purge_freq rounds. The cuts in the pool are removable from the LP.
+	 */
+	virtual void setCutPool(
+			double parallelism, /**< [in] minimum cosine of the parallel cuts */
+			int    max_age,     /**< [in] number of rounds at which a cut is not tight before purging */
+			int    purge_freq   /**< [in] number of rounds between purging */);
+
+	/**
+	 * Enable the in-out stabilization at the root node. The cuts are generated at the
+	 * convex combination alpha * center + (1 - alpha) * x of the stability center and the
+	 * LP solution x. The center moves to the separation point if the point is not cut off.
+	 * The weight alpha grows back to its initial value while the cuts separate x, and is
+	 * halved otherwise, in which case the cuts are generated at x as a fall-back.
+	 */
+	virtual void setInOutStabilization(
+			double alpha /**< [in] initial weight of the stability center in [0,1) */);
+
+	/** get number of fall-backs to the LP solution of the in-out stabilization */
+	virtual int getNumStabFallbacks() {return nfallbacks_;}
+
 protected:
 	virtual SCIP_RETCODE generate_Benders(
+		SCIP *scip,
+		SCIP_CONSHDLR *conshdlr,
+		SCIP_SOL *sol,
+		OsiCuts *cs,
+		bool update = false /**< update the aggregation groups */);
+
+	/** generate Benders cuts at the in-out separation point, and fall back to the solution if needed */
+	virtual SCIP_RETCODE generateStabilized(
 		SCIP *scip,
 		SCIP_CONSHDLR *conshdlr,
 		SCIP_SOL *sol,
 		OsiCuts *cs);
 
+	/** generate Benders cuts at a point, of which the efficacy is evaluated at the solution */
+	virtual void generateAtPoint(
+		double *point,       /**< [in] separation point */
+		const double *vals,  /**< [in] master solution */
+		OsiCuts *cs,         /**< [out] cuts generated */
+		bool update          /**< [in] update the aggregation groups */);
+
 	virtual SCIP_RETCODE sepaBenders(
 		SCIP *scip,
 		SCIP_CONSHDLR *conshdlr,
@@ -115,6 +181,33 @@ protected:
 			double *  cutrhs, /**< [in] cut right-hand side */
 			OsiCuts * cuts    /**< [out] cuts generated */);
 
+	/** find a cut in the pool that is parallel to and at least as strong as a cut, and violated by a solution */
+	virtual SCIP_RETCODE findPoolCut(
+			SCIP *scip,                       /**< [in] scip pointer */
+			SCIP_SOL *sol,                    /**< [in] solution (NULL for the LP solution) */
+			const CoinPackedVector & cutrow,  /**< [in] cut row */
+			double lb,                        /**< [in] cut lower bound */
+			int * id,                         /**< [out] index of the parallel cut in the pool, or -1 */
+			SCIP_ROW ** row                   /**< [out] row of the parallel cut if violated; NULL otherwise */);
+
+	/** store a cut row in the pool */
+	virtual SCIP_RETCODE storePoolCut(
+			SCIP *scip,                       /**< [in] scip pointer */
+			SCIP_ROW *row,                    /**< [in] cut row added to SCIP */
+			const CoinPackedVector & cutrow,  /**< [in] cut row */
+			double lb                         /**< [in] cut lower bound */);
+
+	/** age the cuts in the pool at a solution, and purge the old cuts periodically */
+	virtual SCIP_RETCODE updateCutPool(
+			SCIP *scip,   /**< [in] scip pointer */
+			SCIP_SOL *sol /**< [in] solution (NULL for the LP solution) */);
+
+	/** aggregate the optimality cuts of the auxiliary variables in the same group */
+	virtual void groupCuts(
+			const double * x, /**< [in] master solution */
+			OsiCuts * cuts,   /**< [in/out] cuts generated */
+			bool update       /**< [in] update the aggregation groups */);
+
 	virtual void write_statistics();
 
 protected:
@@ -126,6 +219,27 @@ protected:
 	int         naux_;             /**< number of auxiliary variables */
 	double*     probability_;      /**< array of probability */
 
+	/** cut aggregation */
+	std::vector<int> aux_index_;   /**< auxiliary variable index of each subproblem */
+	std::vector<int> aux_group_;   /**< group index of each auxiliary variable */
+	std::vector<int> group_age_;   /**< number of rounds without violated cut for each group */
+	bool        dynamic_aggr_;     /**< indicate whether the groups are updated dynamically */
+	double      refine_tol_;       /**< relative violation lost by aggregation to refine a group */
+	int         coarsen_age_;      /**< number of rounds without violation to coarsen a group */
+
+	/** cut pool */
+	DspCutPool * cutpool_;                /**< cut pool (NULL if not used) */
+	std::map<int, SCIP_ROW*> pool_rows_;  /**< captured rows of the cuts in the pool */
+	int         purge_freq_;       /**< number of rounds between purging */
+	int         nrounds_;          /**< number of separation rounds */
+	int         nfiltered_;        /**< number of cuts filtered by the pool */
+
+	/** in-out stabilization */
+	double      stab_alpha0_;      /**< initial weight of the stability center (0 if not used) */
+	double      stab_alpha_;       /**< current weight of the stability center */
+	std::vector<double> stab_center_; /**< stability center */
+	int         nfallbacks_;       /**< number of fall-backs to the solution */
+
 	/** simple statistics */
 	vector<string> names_statistics_;
 	unordered_map<string, int> count_statistics_;
@@ -9,6 +9,7 @@
 
 /** DSP */
 #include "Utility/DspMessage.h"
+#include "Utility/DspWasserstein.h"
 #include "Model/TssModel.h"
 #include "Solver/Benders/SCIPconshdlrDrBenders.h"
 #include "SolverInterface/DspOsiScip.h"
@@ -55,7 +56,9 @@ SCIP_RETCODE SCIPcreateConsDrBenders(
 
 /** default constructor */
 SCIPconshdlrDrBenders::SCIPconshdlrDrBenders(SCIP *scip, const char *name, int sepapriority, int param_seps_solver)
-	: SCIPconshdlrBenders(scip, name, sepapriority)
+	: SCIPconshdlrBenders(scip, name, sepapriority),
+	  drosolved_(false),
+	  closed_form_(false)
 {
 	switch (param_seps_solver)
 	{
@@ -210,7 +213,12 @@ void SCIPconshdlrDrBenders::create_distsepa_problem()
 
 	int nscen = model_->getNumSubproblems();
 	int nrefs = model_->getNumReferences();
-	int ncols = nscen + nscen * nrefs;
+
+	/** one transport column for each pair kept in the (sparsified) ambiguity set */
+	vector<int> start(nscen + 1, nscen);
+	for (int i = 0; i < nscen; ++i)
+		start[i + 1] = start[i] + model_->getWassersteinPairs(i)->getNumElements();
+	int ncols = start[nscen];
 	int nrows = 1 + nscen + nrefs + 1;
 
 	clbd = new double[ncols];
@@ -241,42 +249,48 @@ void SCIPconshdlrDrBenders::create_distsepa_problem()
 
 	vector<int> vind;
 	vector<double> velem;
-	vind.reserve(nscen * nrefs);
-	velem.reserve(nscen * nrefs);
+	vind.reserve(ncols);
+	velem.reserve(ncols);
 
 	// Wasserstein ball constraint
 	for (int i = 0; i < nscen; ++i)
-		for (int j = 0; j < nrefs; ++j)
+	{
+		const CoinPackedVector *pairs = model_->getWassersteinPairs(i);
+		for (int k = 0; k < pairs->getNumElements(); ++k)
 		{
-			vind.push_back(nscen + nrefs * i + j);
-			velem.push_back(model_->getWassersteinDist(j, i));
+			vind.push_back(start[i] + k);
+			velem.push_back(pairs->getElements()[k]);
 		}
-	mat->appendRow(nrefs * nscen, vind.data(), velem.data());
+	}
+	mat->appendRow(vind.size(), vind.data(), velem.data());
 
 	// marginal probability of scenario
-	velem.clear();
-	velem.push_back(-1.0);
-	for (int j = 0; j < nrefs; ++j)
-		velem.push_back(1.0);
 	for (int i = 0; i < nscen; ++i)
 	{
 		vind.clear();
+		velem.clear();
 		vind.push_back(i);
-		for (int j = 0; j < nrefs; ++j)
-			vind.push_back(nscen + nrefs * i + j);
-		mat->appendRow(nrefs + 1, vind.data(), velem.data());
+		velem.push_back(-1.0);
+		for (int k = start[i]; k < start[i + 1]; ++k)
+		{
+			vind.push_back(k);
+			velem.push_back(1.0);
+		}
+		mat->appendRow(vind.size(), vind.data(), velem.data());
 	}
 
 	// marginal probability of reference
-	velem.clear();
+	vector<vector<int> > refpairs(nrefs);
 	for (int i = 0; i < nscen; ++i)
-		velem.push_back(1.0);
+	{
+		const CoinPackedVector *pairs = model_->getWassersteinPairs(i);
+		for (int k = 0; k < pairs->getNumElements(); ++k)
+			refpairs[pairs->getIndices()[k]].push_back(start[i] + k);
+	}
 	for (int j = 0; j < nrefs; ++j)
 	{
-		vind.clear();
-		for (int i = 0; i < nscen; ++i)
-			vind.push_back(nscen + nrefs * i + j);
-		mat->appendRow(nscen, vind.data(), velem.data());
+		velem.assign(refpairs[j].size(), 1.0);
+		mat->appendRow(refpairs[j].size(), refpairs[j].data(), velem.data());
 	}
 
 	// probability summing up to one
@@ -294,6 +308,11 @@ void SCIPconshdlrDrBenders::create_distsepa_problem()
 	drosi_->si_->setObjSense(-1.0);
 	drosi_->setLogLevel(0);
 
+	/** The basis remains primal feasible after changing the objective coefficients. */
+	drosi_->si_->setHintParam(OsiDoDualInResolve, false, OsiHintTry);
+	drobj_.assign(nscen, 0.0);
+	drosolved_ = false;
+
 	END_TRY_CATCH(FREE_MEMORY)
 
 	FREE_MEMORY;
@@ -308,16 +327,65 @@ SCIP_RETCODE SCIPconshdlrDrBenders::computeProbability(
 	assert(drosi_);
 	assert(drosi_->si_);
 	assert(drosi_->si_->getNumCols() >= model_->getNumSubproblems());
-	// change objective function
-	for (int j = 0; j < model_->getNumSubproblems(); ++j)
-		drosi_->si_->setObjCoeff(j, recourse[j]);
-	DSPdebugMessage("updated distribution separation objective.\n");
 
-	// solve the distribution separation problem
-	drosi_->solve();
+	int nscen = model_->getNumSubproblems();
+
+	// closed-form solution for a single reference over the scenarios paired with it
+	if (closed_form_ && model_->getNumReferences() == 1)
+	{
+		vector<int> scen;
+		vector<double> rec, dist;
+		for (int j = 0; j < nscen; ++j)
+		{
+			const CoinPackedVector *pairs = model_->getWassersteinPairs(j);
+			if (pairs->getNumElements() == 0)
+				continue;
+			scen.push_back(j);
+			rec.push_back(recourse[j]);
+			dist.push_back(pairs->getElements()[0]);
+		}
+		vector<double> prob(scen.size());
+		if (DspWassersteinWorstCase(scen.size(), rec.data(), dist.data(), model_->getWassersteinSize(), prob.data()))
+		{
+			CoinZeroN(probability_, nscen);
+			for (unsigned k = 0; k < scen.size(); ++k)
+				probability_[scen[k]] = prob[k];
+			return SCIP_OKAY;
+		}
+		printf("Distribution separation problem is infeasible.\n");
+		return SCIP_ERROR;
+	}
+
+	// change the objective coefficients that differ from the last solve
+	vector<int> ind;
+	vector<double> val;
+	for (int j = 0; j < nscen; ++j)
+		if (!drosolved_ || recourse[j] != drobj_[j])
+		{
+			ind.push_back(j);
+			val.push_back(recourse[j]);
+			drobj_[j] = recourse[j];
+		}
+	DSPdebugMessage("updated %lu distribution separation objective coefficients.\n", ind.size());
+
+	// the probabilities are not changed
+	if (ind.size() == 0)
+		return SCIP_OKAY;
+	drosi_->setObjCoeffSet(ind.data(), ind.data() + ind.size(), val.data());
+
+	// solve the distribution separation problem from the last basis
+	if (drosolved_)
+	{
+		drosi_->resolve();
+		if (drosi_->status() != DSP_STAT_OPTIMAL)
+			drosi_->solve();
+	}
+	else
+		drosi_->solve();
 	DSPdebugMessage("distribution separation status: %d\n", drosi_->status());
 
-	if (drosi_->status() == DSP_STAT_OPTIMAL)
+	drosolved_ = drosi_->status() == DSP_STAT_OPTIMAL;
+	if (drosolved_)
 	{
 		for (int j = 0; j < model_->getNumSubproblems(); ++j)
 		{
@@ -35,6 +35,9 @@ public:
 	/** set model pointer */
 	virtual void setDecModel(DecModel *model);
 
+	/** use the closed-form solution of the distribution separation if there is a single reference */
+	virtual void setClosedForm(bool yes) {closed_form_ = yes;}
+
 protected:
 	/** evaluate recourse functions */
 	virtual SCIP_RETCODE evaluateRecourse(
@@ -64,6 +67,10 @@ protected:
 		SCIP_RESULT *result /**< [out] result */);
 
 	DspOsi *drosi_; /**< distribution separation problem */
+
+	std::vector<double> drobj_; /**< objective coefficients of the distribution separation problem */
+	bool drosolved_;            /**< indicate whether drosi_ has a basis to warm-start */
+	bool closed_form_;          /**< indicate whether to use the closed-form solution */
 };
 
 /** creates and captures a Benders constraint */
@@ -296,16 +296,11 @@ SCIP_RETCODE SCIPconshdlrIntBenders::tryPrimalSolution(
 	SCIP_Bool stored;
 	
 	// set a feasible value of the auxiliary variable
+	std::vector<double> weighted_recourse(naux_, 0.0);
+	for (int k = 0; k < model_->getNumSubproblems(); ++k)
+		weighted_recourse[aux_index_[k]] += recourse_values[k] * probability_[k];
 	for (int j = 0; j < naux_; ++j)
-	{
-		double weighted_recourse = 0.0;
-		for (int k = j; k < model_->getNumSubproblems(); k += naux_)
-		{
-			weighted_recourse += recourse_values[k] * probability_[k];
-			// DSPdebugMessage("---- s = %d, recourse_values = %e, probability_ %e\n", k, recourse_values[k], probability_[k]);
-		}
-		SCIP_CALL(SCIPsetSolVal(scip, sol, vars_[nvars_ - naux_ + j], weighted_recourse));
-	}
+		SCIP_CALL(SCIPsetSolVal(scip, sol, vars_[nvars_ - naux_ + j], weighted_recourse[j]));
 	// SCIPprintSol(scip, sol, NULL, FALSE);
 
 	// set the solution as a primal feasible solution
@@ -363,6 +358,10 @@ SCIP_RETCODE SCIPconshdlrIntBenders::addNoGoodCut(
 	/** add cut to global pool */
 	SCIP_CALL(SCIPaddPoolCut(scip, row));
 
+	/** keep track of the cut */
+	if (cutpool_)
+		SCIP_CALL(storePoolCut(scip, row, cutrow, rhs));
+
 	/** release the row */
 	SCIP_CALL(SCIPreleaseRow(scip, &row));
 
@@ -424,17 +423,18 @@ SCIP_RETCODE SCIPconshdlrIntBenders::addIntOptimalityCut(
 	SCIP_CALL(SCIPcacheRowExtensions(scip, row));
 
 	/** collect all non-zero coefficients */
+	CoinPackedVector cutrow;
 	for (int j = 0; j < nvars_ - naux_; ++j)
 	{
 		if (SCIPisFeasZero(scip, SCIPgetVarSol(scip, vars_[j])))
-			SCIP_CALL(SCIPaddVarToRow(scip, row, vars_[j], exact_recourse - recourse_lb));
+			cutrow.insert(j, exact_recourse - recourse_lb);
 		else
-			SCIP_CALL(SCIPaddVarToRow(scip, row, vars_[j], recourse_lb - exact_recourse));
+			cutrow.insert(j, recourse_lb - exact_recourse);
 	}
 	for (int j = 0; j < naux_; ++j)
-	{
-		SCIP_CALL(SCIPaddVarToRow(scip, row, vars_[nvars_ - naux_ + j], 1.0));
-	}
+		cutrow.insert(nvars_ - naux_ + j, 1.0);
+	for (int j = 0; j < cutrow.getNumElements(); ++j)
+		SCIP_CALL(SCIPaddVarToRow(scip, row, vars_[cutrow.getIndices()[j]], cutrow.getElements()[j]));
 
 	/** flush all changes before adding cut */
 	SCIP_CALL(SCIPflushRowExtensions(scip, row));
@@ -448,6 +448,10 @@ SCIP_RETCODE SCIPconshdlrIntBenders::addIntOptimalityCut(
 	/** add cut to global pool */
 	SCIP_CALL(SCIPaddPoolCut(scip, row));
 
+	/** keep track of the cut */
+	if (cutpool_)
+		SCIP_CALL(storePoolCut(scip, row, cutrow, rhs));
+
 	/** release the row */
 	SCIP_CALL(SCIPreleaseRow(scip, &row));
 
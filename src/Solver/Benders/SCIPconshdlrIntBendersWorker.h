@@ -30,7 +30,7 @@ protected:
 		double *x, /**< [in] master solution */
 		OsiCuts *cuts /**< [out] cuts generated */)
 	{
-		generateCutsBase(model_->getNumSubproblems(), nvars_, naux_, x, probability_, cuts);
+		generateCutsBase(model_->getNumSubproblems(), nvars_, naux_, &aux_index_[0], x, probability_, cuts);
 	}
 
 	/** evaluate recourse */
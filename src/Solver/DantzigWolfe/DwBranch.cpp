@@ -0,0 +1,212 @@
+/*
+ * DwBranch.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+//#define DSP_DEBUG
+
+#include <algorithm>
+#include <thread>
+#include "Solver/DantzigWolfe/DwBranch.h"
+#include "Model/TssModel.h"
+
+/** minimum distance to the new bound */
+static const double pcMinFrac = 1.0e-6;
+
+/** objective change given to an infeasible child in strong branching */
+static const double pcInfeasGain = 1.0e+20;
+
+/** product score of the down and up objective changes */
+static double pcScore(double dngain, double upgain) {
+	return CoinMax(dngain, pcMinFrac) * CoinMax(upgain, pcMinFrac);
+}
+
+void DwBranch::updatePseudocost(
+		const DspBranchObj* obj, /**< [in] branching object of the child node */
+		double childobj          /**< [in] objective value of the child node */) {
+	if (obj == NULL || obj->pcIndex_ < 0 || obj->pcRecorded_)
+		return;
+	if (obj->parentObj_ <= -COIN_DBL_MAX || childobj >= COIN_DBL_MAX)
+		return;
+	double gain = CoinMax(childobj - obj->parentObj_, 0.0);
+	addPseudocost(obj->pcIndex_, obj->direction_ > 0 ? 1 : 0, gain / CoinMax(obj->pcFrac_, pcMinFrac));
+	obj->pcRecorded_ = true;
+	DSPdebugMessage("Updated pseudocost of column %d (direction %d): gain %e\n", obj->pcIndex_, obj->direction_, gain);
+}
+
+double DwBranch::getPseudocost(int j, int dir) {
+	if (getNumPseudocostObs(j, dir) > 0)
+		return pcSum_[dir][j] / pcCount_[dir][j];
+	/** use the average over all the variables if not observed */
+	if (pcTotalCount_[dir] > 0)
+		return pcTotal_[dir] / pcTotalCount_[dir];
+	return 1.0;
+}
+
+void DwBranch::addPseudocost(int j, int dir, double pc) {
+	if (j >= static_cast<int>(pcSum_[dir].size())) {
+		pcSum_[dir].resize(j + 1, 0.0);
+		pcCount_[dir].resize(j + 1, 0);
+	}
+	pcSum_[dir][j] += pc;
+	pcCount_[dir][j]++;
+	pcTotal_[dir] += pc;
+	pcTotalCount_[dir]++;
+}
+
+int DwBranch::chooseCandidate(std::vector<DwBranchCand>& cands) {
+	int best = -1;
+
+	/** the default choice with the largest score */
+	if (model_->getParPtr()->getBoolParam("DW/BRANCH/PSEUDOCOST") == false) {
+		for (unsigned k = 0; k < cands.size(); ++k)
+			if (best < 0 || cands[k].score > cands[best].score)
+				best = k;
+		return best;
+	}
+
+	DwMaster* master = dynamic_cast<DwMaster*>(model_->getSolver());
+	DspMessage* message = master->getMessagePtr();
+	int reliability = model_->getParPtr()->getIntParam("DW/BRANCH/RELIABILITY");
+	int maxstrong = model_->getParPtr()->getIntParam("DW/BRANCH/MAX_STRONG");
+	double parentobj = master->getPrimalObjective();
+
+	std::vector<double> scores(cands.size());
+	std::vector<int> unreliable;
+	for (unsigned k = 0; k < cands.size(); ++k) {
+		int j = cands[k].index;
+		double dnfrac = CoinMax(cands[k].value - cands[k].downValue, pcMinFrac);
+		double upfrac = CoinMax(cands[k].upValue - cands[k].value, pcMinFrac);
+		scores[k] = pcScore(getPseudocost(j, 0) * dnfrac, getPseudocost(j, 1) * upfrac);
+		if (CoinMin(getNumPseudocostObs(j, 0), getNumPseudocostObs(j, 1)) < reliability)
+			unreliable.push_back(k);
+	}
+
+	/** strong branching on the unreliable candidates with the largest default scores */
+	if (unreliable.size() > static_cast<unsigned>(CoinMax(maxstrong, 0))) {
+		std::stable_sort(unreliable.begin(), unreliable.end(),
+				[&cands](int a, int b) {return cands[a].score > cands[b].score;});
+		unreliable.resize(CoinMax(maxstrong, 0));
+	}
+	if (unreliable.size() > 0) {
+		std::vector<DspBranchObj*> objs(2 * unreliable.size(), NULL);
+		std::vector<double> objvals;
+		for (unsigned i = 0; i < unreliable.size(); ++i)
+			createBranchingObjects(cands[unreliable[i]], objs[2*i], objs[2*i+1]);
+
+		evaluateChildren(objs, objvals);
+
+		for (unsigned i = 0; i < unreliable.size(); ++i) {
+			double gain[2];
+			for (int d = 0; d < 2; ++d) {
+				/** objs[2*i] is the up branch. */
+				DspBranchObj* obj = objs[2*i+1-d];
+				if (obj == NULL || objvals[2*i+1-d] >= COIN_DBL_MAX)
+					gain[d] = pcInfeasGain;
+				else {
+					gain[d] = CoinMax(objvals[2*i+1-d] - parentobj, 0.0);
+					updatePseudocost(obj, objvals[2*i+1-d]);
+				}
+			}
+			scores[unreliable[i]] = pcScore(gain[0], gain[1]);
+			DSPdebugMessage("Strong branching on column %d: down %e up %e\n", cands[unreliable[i]].index, gain[0], gain[1]);
+		}
+
+		for (unsigned i = 0; i < objs.size(); ++i)
+			FREE_PTR(objs[i]);
+	}
+
+	for (unsigned k = 0; k < cands.size(); ++k)
+		if (best < 0 || scores[k] > scores[best])
+			best = k;
+
+	message->print(2, "Reliability branching: %u candidates, %u strong branching, column %d (score %e)\n",
+			static_cast<unsigned>(cands.size()), static_cast<unsigned>(unreliable.size()), cands[best].index, scores[best]);
+
+	return best;
+}
+
+void DwBranch::evaluateChildren(
+		const std::vector<DspBranchObj*>& objs, /**< [in] branching objects */
+		std::vector<double>& objvals             /**< [out] objective values */) {
+
+	DwMaster* master = dynamic_cast<DwMaster*>(model_->getSolver());
+	OsiSolverInterface* si = master->getSiPtr();
+	double parentobj = master->getPrimalObjective();
+
+	TssModel* tss = NULL;
+	if (master->getModelPtr()->isStochastic())
+		tss = dynamic_cast<TssModel*>(master->getModelPtr());
+
+	objvals.assign(objs.size(), COIN_DBL_MAX);
+
+	/** The columns of the subproblem solutions out of the child bounds are fixed to zero. */
+	std::vector<OsiSolverInterface*> clones(objs.size(), NULL);
+	std::vector<double> dx(master->ncols_orig_, 0.0);
+	std::vector<char> present(master->ncols_orig_, 0);
+	for (unsigned i = 0; i < objs.size(); ++i) {
+		if (objs[i] == NULL) continue;
+		clones[i] = si->clone();
+		for (auto it = master->cols_generated_.begin(); it != master->cols_generated_.end(); it++) {
+			if (!(*it)->active_ || (*it)->master_index_ < 0 || (*it)->master_index_ >= si->getNumCols())
+				continue;
+			const CoinPackedVector& x = (*it)->x_;
+			for (int k = 0; k < x.getNumElements(); ++k) {
+				dx[x.getIndices()[k]] = x.getElements()[k];
+				present[x.getIndices()[k]] = 1;
+			}
+			for (int l = 0; l < objs[i]->getNumObjs(); ++l) {
+				if (objs[i]->getVector(l)->getNumElements() != 1) continue;
+				int j = objs[i]->getIndex(l);
+				if (!present[j]) {
+					/** A missing element is zero only if the column belongs to the block of the element. */
+					if (tss == NULL) continue;
+					int nfirst = tss->getNumScenarios() * tss->getNumCols(0);
+					int block = j < nfirst ? j / tss->getNumCols(0) : (j - nfirst) / tss->getNumCols(1);
+					if (block != (*it)->blockid_) continue;
+				}
+				if (dx[j] < objs[i]->getLb(l) - 1.0e-8 || dx[j] > objs[i]->getUb(l) + 1.0e-8) {
+					clones[i]->setColUpper((*it)->master_index_, 0.0);
+					break;
+				}
+			}
+			for (int k = 0; k < x.getNumElements(); ++k) {
+				dx[x.getIndices()[k]] = 0.0;
+				present[x.getIndices()[k]] = 0;
+			}
+		}
+	}
+
+	/** solve the restricted masters concurrently */
+	int nthreads = CoinMax(1, CoinMin(model_->getParPtr()->getIntParam("DW/BRANCH/THREADS"), static_cast<int>(objs.size())));
+	auto evaluate = [&](int t) {
+		for (unsigned i = t; i < objs.size(); i += nthreads) {
+			if (clones[i] == NULL) continue;
+			try {
+				clones[i]->resolve();
+				if (clones[i]->isProvenOptimal())
+					objvals[i] = clones[i]->getObjValue();
+				else if (clones[i]->isProvenPrimalInfeasible())
+					objvals[i] = COIN_DBL_MAX;
+				else
+					objvals[i] = parentobj;
+			} catch (const CoinError& e) {
+				objvals[i] = parentobj;
+			}
+		}
+	};
+	if (nthreads == 1)
+		evaluate(0);
+	else {
+		std::vector<std::thread> threads;
+		for (int t = 0; t < nthreads; ++t)
+			threads.push_back(std::thread(evaluate, t));
+		for (int t = 0; t < nthreads; ++t)
+			threads[t].join();
+	}
+
+	for (unsigned i = 0; i < clones.size(); ++i)
+		FREE_PTR(clones[i]);
+}
@@ -10,13 +10,41 @@
 
 #include "Solver/DantzigWolfe/DwModel.h"
 
+/** branching candidate */
+struct DwBranchCand {
+	int index;         /**< branching variable index */
+	double value;      /**< current value */
+	double downValue;  /**< upper bound of the down branch */
+	double upValue;    /**< lower bound of the up branch */
+	double score;      /**< score for the default choice (the larger the better) */
+
+	DwBranchCand(int j, double val, double dn, double up, double sc) :
+		index(j), value(val), downValue(dn), upValue(up), score(sc) {}
+};
+
+/**
+ * Base class of the branching rules.
+ *
+ * If DW/BRANCH/PSEUDOCOST is set, the branching candidate is chosen by reliability
+ * branching. The pseudocosts are the objective changes per unit change of the
+ * branching variable, observed in the child nodes. A candidate whose pseudocost has
+ * fewer than DW/BRANCH/RELIABILITY observations in either direction is evaluated by
+ * strong branching, where the child nodes are evaluated by the restricted master
+ * problem without column generation in DW/BRANCH/THREADS threads.
+ */
 class DwBranch {
 public:
 	/** default constructor */
-	DwBranch() : model_(NULL) {}
+	DwBranch() : model_(NULL) {
+		pcTotal_[0] = pcTotal_[1] = 0.0;
+		pcTotalCount_[0] = pcTotalCount_[1] = 0;
+	}
 
 	/** default constructor with solver */
-	DwBranch(DwModel* model) : model_(model) {}
+	DwBranch(DwModel* model) : model_(model) {
+		pcTotal_[0] = pcTotal_[1] = 0.0;
+		pcTotalCount_[0] = pcTotalCount_[1] = 0;
+	}
 
 	/** default destructor */
 	virtual ~DwBranch() {
@@ -28,9 +56,53 @@ public:
     virtual bool chooseBranchingObjects(
     			std::vector<DspBranchObj*>& branchingObjs /**< [out] branching objects */) = 0;
 
+    /** record the objective value of a child node for the pseudocost */
+    virtual void updatePseudocost(
+    		const DspBranchObj* obj, /**< [in] branching object of the child node */
+			double childobj          /**< [in] objective value of the child node */);
+
+protected:
+
+    /** create the up and down branching objects of a candidate (NULL if a branch is empty) */
+    virtual void createBranchingObjects(
+    		const DwBranchCand& cand, /**< [in] branching candidate */
+			DspBranchObj*& branchingUp, /**< [out] up branch */
+			DspBranchObj*& branchingDn  /**< [out] down branch */) {
+    	branchingUp = NULL;
+    	branchingDn = NULL;
+    }
+
+    /** choose a branching candidate and return its position */
+    virtual int chooseCandidate(std::vector<DwBranchCand>& cands);
+
+    /**
+     * evaluate the child nodes by the restricted master problem without column generation;
+     * COIN_DBL_MAX is returned for a child whose restricted master is infeasible.
+     */
+    virtual void evaluateChildren(
+    		const std::vector<DspBranchObj*>& objs, /**< [in] branching objects */
+			std::vector<double>& objvals             /**< [out] objective values */);
+
+    /** pseudocost of a variable in a direction (0: down, 1: up) */
+    double getPseudocost(int j, int dir);
+
+    /** number of pseudocost observations of a variable in a direction (0: down, 1: up) */
+    int getNumPseudocostObs(int j, int dir) {
+    	return j < static_cast<int>(pcCount_[dir].size()) ? pcCount_[dir][j] : 0;
+    }
+
+    /** add a pseudocost observation */
+    void addPseudocost(int j, int dir, double pc);
+
 protected:
 
     DwModel* model_;
+
+    /**@name pseudocosts for down (0) and up (1) directions */
+    std::vector<double> pcSum_[2];  /**< sum of observed pseudocosts */
+    std::vector<int> pcCount_[2];   /**< number of observations */
+    double pcTotal_[2];             /**< sum over all the variables */
+    int pcTotalCount_[2];           /**< number of observations over all the variables */
 };
 
 #endif /* SRC_SOLVER_DANTZIGWOLFE_DWBRANCH_H_ */
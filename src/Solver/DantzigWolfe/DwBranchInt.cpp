@@ -14,9 +14,8 @@ bool DwBranchInt::chooseBranchingObjects(
 		std::vector<DspBranchObj*>& branchingObjs /**< [out] branching objects */) {
 	int findPhase = 0;
 	bool branched = false;
-	double dist, maxdist = 1.0e-6;
-	int branchingIndex = -1;
-	double branchingValue;
+	double dist;
+	int branchingCand = -1;
 
 	DecSolver* solver = model_->getSolver();
 	DwMaster* master = dynamic_cast<DwMaster*>(solver);
@@ -24,9 +23,11 @@ bool DwBranchInt::chooseBranchingObjects(
 
 	/** smip branching */
 	int ncols_first_stage = -1;   /**< number of first-stage columns in dd form */
-	int branchingFirstStage = -1; /**< branching index in first stage */
 	TssModel* tss = NULL;
 
+	/** branching candidates */
+	std::vector<DwBranchCand> cands;
+
 	DspBranchObj* branchingUp = NULL;
 	DspBranchObj* branchingDn = NULL;
 
@@ -40,19 +41,19 @@ bool DwBranchInt::chooseBranchingObjects(
 	DSPdebugMessage("ncols_first_stage %d\n", ncols_first_stage);
 
 	findPhase = 0;
-	while (findPhase < 2 && branchingIndex < 0) {
-		/** most fractional value */
+	while (findPhase < 2 && branchingCand < 0) {
+		/** fractional values; the default choice is the most fractional one. */
+		cands.clear();
 		for (int j = 0; j < master->ncols_orig_; ++j) {
 			if (findPhase == 0 && j > ncols_first_stage)
 				break;
 			if (master->ctype_orig_[j] == 'C') continue;
 			dist = fabs(primsol[j] - floor(primsol[j] + 0.5));
-			if (dist > maxdist) {
-				maxdist = dist;
-				branchingIndex = j;
-				branchingValue = primsol[j];
-			}
+			if (dist > 1.0e-6)
+				cands.push_back(DwBranchCand(j, primsol[j], floor(primsol[j]), ceil(primsol[j]), dist));
 		}
+		if (cands.size() > 0)
+			branchingCand = chooseCandidate(cands);
 
 #if 0
 		/** for the first pass of smip, look through expected first-stage integer variable values */
@@ -75,44 +76,12 @@ bool DwBranchInt::chooseBranchingObjects(
 		findPhase++;
 	}
 
-	if (branchingIndex > -1) {
+	if (branchingCand > -1) {
 
 		branched = true;
 
-		/** get branching index in first stage */
-		if (branchingIndex < ncols_first_stage)
-			branchingFirstStage = branchingIndex % tss->getNumCols(0);
-
 		/** creating branching objects */
-		branchingUp = new DspBranchObj();
-		branchingDn = new DspBranchObj();
-		for (int j = 0; j < master->ncols_orig_; ++j) {
-			if (master->ctype_orig_[j] == 'C') continue;
-			/** NOTE: branching on all the first-stage variables if SMIP */
-			if (branchingIndex == j || (tss != NULL && branchingFirstStage == j % tss->getNumCols(0) && j < ncols_first_stage)) {
-				DSPdebugMessage("Creating branch objects on column %d (value %e): [%e,%e] and [%e,%e]\n", 
-					j, branchingValue, ceil(branchingValue), master->cubd_node_[j], master->clbd_node_[j], floor(branchingValue));
-				branchingUp->push_back(j, ceil(branchingValue), master->cubd_node_[j]);
-				branchingDn->push_back(j, master->clbd_node_[j], floor(branchingValue));
-			} else if (master->clbd_node_[j] > master->clbd_orig_[j] || master->cubd_node_[j] < master->cubd_orig_[j]) {
-				/** store any bound changes made in parent nodes */
-				DSPdebugMessage("Adjusting bound change on column %d: [%e,%e]\n", j, master->clbd_node_[j], master->cubd_node_[j]);
-				branchingUp->push_back(j, master->clbd_node_[j], master->cubd_node_[j]);
-				branchingDn->push_back(j, master->clbd_node_[j], master->cubd_node_[j]);
-			}
-		}
-
-		/** set best dual bounds */
-		branchingUp->bestBound_ = master->getBestDualObjective();
-		branchingDn->bestBound_ = master->getBestDualObjective();
-
-		/** assign best dual solutions */
-		branchingUp->dualsol_.assign(master->getBestDualSolution(), master->getBestDualSolution() + master->nrows_);
-		branchingDn->dualsol_.assign(master->getBestDualSolution(), master->getBestDualSolution() + master->nrows_);
-
-		/** set branching directions */
-		branchingUp->direction_ = 1;
-		branchingDn->direction_ = -1;
+		createBranchingObjects(cands[branchingCand], branchingUp, branchingDn);
 
 		/** add branching objects */
 		branchingObjs.push_back(branchingUp);
@@ -125,3 +94,69 @@ bool DwBranchInt::chooseBranchingObjects(
 
 	return branched;
 }
+
+void DwBranchInt::createBranchingObjects(
+		const DwBranchCand& cand, /**< [in] branching candidate */
+		DspBranchObj*& branchingUp, /**< [out] up branch */
+		DspBranchObj*& branchingDn  /**< [out] down branch */) {
+
+	DecSolver* solver = model_->getSolver();
+	DwMaster* master = dynamic_cast<DwMaster*>(solver);
+
+	int branchingIndex = cand.index;
+	double branchingValue = cand.value;
+
+	/** smip branching */
+	int ncols_first_stage = -1;   /**< number of first-stage columns in dd form */
+	int branchingFirstStage = -1; /**< branching index in first stage */
+	TssModel* tss = NULL;
+
+	if (solver->getModelPtr()->isStochastic()) {
+		/** two-stage stochastic model */
+		tss = dynamic_cast<TssModel*>(solver->getModelPtr());
+		ncols_first_stage = tss->getNumScenarios() * tss->getNumCols(0);
+	}
+
+	/** get branching index in first stage */
+	if (branchingIndex < ncols_first_stage)
+		branchingFirstStage = branchingIndex % tss->getNumCols(0);
+
+	/** creating branching objects */
+	branchingUp = new DspBranchObj();
+	branchingDn = new DspBranchObj();
+	for (int j = 0; j < master->ncols_orig_; ++j) {
+		if (master->ctype_orig_[j] == 'C') continue;
+		/** NOTE: branching on all the first-stage variables if SMIP */
+		if (branchingIndex == j || (tss != NULL && branchingFirstStage == j % tss->getNumCols(0) && j < ncols_first_stage)) {
+			DSPdebugMessage("Creating branch objects on column %d (value %e): [%e,%e] and [%e,%e]\n", 
+				j, branchingValue, ceil(branchingValue), master->cubd_node_[j], master->clbd_node_[j], floor(branchingValue));
+			branchingUp->push_back(j, ceil(branchingValue), master->cubd_node_[j]);
+			branchingDn->push_back(j, master->clbd_node_[j], floor(branchingValue));
+		} else if (master->clbd_node_[j] > master->clbd_orig_[j] || master->cubd_node_[j] < master->cubd_orig_[j]) {
+			/** store any bound changes made in parent nodes */
+			DSPdebugMessage("Adjusting bound change on column %d: [%e,%e]\n", j, master->clbd_node_[j], master->cubd_node_[j]);
+			branchingUp->push_back(j, master->clbd_node_[j], master->cubd_node_[j]);
+			branchingDn->push_back(j, master->clbd_node_[j], master->cubd_node_[j]);
+		}
+	}
+
+	/** set best dual bounds */
+	branchingUp->bestBound_ = master->getBestDualObjective();
+	branchingDn->bestBound_ = master->getBestDualObjective();
+
+	/** assign best dual solutions */
+	branchingUp->dualsol_.assign(master->getBestDualSolution(), master->getBestDualSolution() + master->nrows_);
+	branchingDn->dualsol_.assign(master->getBestDualSolution(), master->getBestDualSolution() + master->nrows_);
+
+	/** set branching directions */
+	branchingUp->direction_ = 1;
+	branchingDn->direction_ = -1;
+
+	/** set pseudocost information */
+	branchingUp->pcIndex_ = branchingIndex;
+	branchingDn->pcIndex_ = branchingIndex;
+	branchingUp->pcFrac_ = cand.upValue - branchingValue;
+	branchingDn->pcFrac_ = branchingValue - cand.downValue;
+	branchingUp->parentObj_ = master->getPrimalObjective();
+	branchingDn->parentObj_ = master->getPrimalObjective();
+}
@@ -25,6 +25,13 @@ public:
     virtual bool chooseBranchingObjects(
     			std::vector<DspBranchObj*>& branchingObjs /**< [out] branching objects */);
 
+protected:
+
+    /** create the up and down branching objects of a candidate */
+    virtual void createBranchingObjects(
+    		const DwBranchCand& cand, /**< [in] branching candidate */
+			DspBranchObj*& branchingUp, /**< [out] up branch */
+			DspBranchObj*& branchingDn  /**< [out] down branch */);
 };
 
 #endif /* SRC_SOLVER_DANTZIGWOLFE_DWBRANCH_H_ */
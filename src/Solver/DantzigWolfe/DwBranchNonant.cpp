@@ -22,14 +22,13 @@ bool DwBranchNonant::chooseBranchingObjects(
 	if (tss_ == NULL) return false;
 
 	int findPhase = 0;
-	double maxdev = 0.0;
 	bool branched = false;
-	int branchingIndex = -1;
-	double branchingValue, branchingDownValue, branchingUpValue;
+	int branchingCand = -1;
+	double branchingDownValue, branchingUpValue;
 
 	std::vector<double> refsol; // reference solution
 	std::vector<double> devsol; // devations from the refsol
-	std::vector<std::vector<double>> densesol; // dense solution vector
+	std::vector<DwBranchCand> cands; // branching candidates
 
 	DspBranchObj* branchingUp = NULL;
 	DspBranchObj* branchingDn = NULL;
@@ -53,15 +52,13 @@ bool DwBranchNonant::chooseBranchingObjects(
 #endif
 
 	findPhase = model_->getParPtr()->getBoolParam("DW/BRANCH/INTEGER_FIRST") ? 0 : 1;
-	while (findPhase < 2 && branchingIndex < 0) {
-		/** most fractional value */
+	while (findPhase < 2 && branchingCand < 0) {
+		/** deviated values; the default choice is the most deviated one. */
+		cands.clear();
 		for (int j = 0; j < tss_->getNumCols(0); ++j) {
 			if (findPhase == 0 && master_->ctype_orig_[j] == 'C')
 				break;
-			if (devsol[j] > CoinMax(epsilon_, maxdev)) {
-				maxdev = devsol[j];
-				branchingIndex = j;
-				branchingValue = refsol[j];
+			if (devsol[j] > epsilon_) {
 				if (tss_->getCtypeCore(0)[j] == 'C') {
 					branchingDownValue = refsol[j] - epsilonBB_;
 					branchingUpValue = refsol[j] + epsilonBB_;
@@ -69,58 +66,30 @@ bool DwBranchNonant::chooseBranchingObjects(
 					branchingDownValue = floor(refsol[j]);
 					branchingUpValue = ceil(refsol[j]);
 				}
+				cands.push_back(DwBranchCand(j, refsol[j], branchingDownValue, branchingUpValue, devsol[j]));
 			}
 		}
+		if (cands.size() > 0)
+			branchingCand = chooseCandidate(cands);
 		findPhase++;
 	}
-	DSPdebugMessage("maxdev %e\n", maxdev);
 
-	if (branchingIndex > -1) {
+	if (branchingCand > -1) {
+		const DwBranchCand& cand = cands[branchingCand];
 
 		branched = true;
 
 		message->print(2, "Creating branch objects on column %d (value %e, maxdev %e): [%e,%e] and [%e,%e]\n", 
-			branchingIndex, branchingValue, maxdev, master_->clbd_node_[branchingIndex], branchingDownValue, branchingUpValue, master_->cubd_node_[branchingIndex]);
+			cand.index, cand.value, cand.score, master_->clbd_node_[cand.index], cand.downValue, cand.upValue, master_->cubd_node_[cand.index]);
 
 		/** creating branching objects */
-		branchingUp = new DspBranchObj();
-		branchingDn = new DspBranchObj();
-		for (int j = 0; j < tss_->getNumCols(0) * tss_->getNumScenarios(); ++j) {
-			if (branchingIndex == j % tss_->getNumCols(0)) {
-				branchingUp->push_back(j, CoinMin(branchingUpValue, master_->cubd_node_[j]), master_->cubd_node_[j]);
-				branchingDn->push_back(j, master_->clbd_node_[j], CoinMax(master_->clbd_node_[j], branchingDownValue));
-			} else if (master_->clbd_node_[j] > master_->clbd_orig_[j] || master_->cubd_node_[j] < master_->cubd_orig_[j]) {
-				/** store any bound changes made in parent nodes */
-				//DSPdebugMessage("Adjusting bound change on column %d: [%e,%e]\n", j, master_->clbd_node_[j], master_->cubd_node_[j]);
-				branchingUp->push_back(j, master_->clbd_node_[j], master_->cubd_node_[j]);
-				branchingDn->push_back(j, master_->clbd_node_[j], master_->cubd_node_[j]);
-			}
-		}
-
-		/** set best dual bounds */
-		branchingUp->bestBound_ = master_->getBestDualObjective();
-		branchingDn->bestBound_ = master_->getBestDualObjective();
-
-		/** assign best dual solutions */
-		branchingUp->dualsol_.assign(master_->getBestDualSolution(), master_->getBestDualSolution() + master_->nrows_);
-		branchingDn->dualsol_.assign(master_->getBestDualSolution(), master_->getBestDualSolution() + master_->nrows_);
-
-		/** set branching directions */
-		branchingUp->direction_ = 1;
-		branchingDn->direction_ = -1;
-
-		branchingUp->solEstimate_ = maxdev;
-		branchingDn->solEstimate_ = maxdev;
+		createBranchingObjects(cand, branchingUp, branchingDn);
 
 		/** add branching objects */
-		if (branchingUpValue <= master_->cubd_node_[branchingIndex])
+		if (branchingUp)
 			branchingObjs.push_back(branchingUp);
-		else
-			FREE_PTR(branchingUp);
-		if (master_->clbd_node_[branchingIndex] <= branchingDownValue)
+		if (branchingDn)
 			branchingObjs.push_back(branchingDn);
-		else
-			FREE_PTR(branchingDn);
 	} else {
 		DSPdebugMessage("No branch object is found.\n");
 	}
@@ -130,6 +99,58 @@ bool DwBranchNonant::chooseBranchingObjects(
 	return branched;
 }
 
+void DwBranchNonant::createBranchingObjects(
+		const DwBranchCand& cand, /**< [in] branching candidate */
+		DspBranchObj*& branchingUp, /**< [out] up branch */
+		DspBranchObj*& branchingDn  /**< [out] down branch */) {
+
+	int branchingIndex = cand.index;
+
+	/** creating branching objects */
+	branchingUp = new DspBranchObj();
+	branchingDn = new DspBranchObj();
+	for (int j = 0; j < tss_->getNumCols(0) * tss_->getNumScenarios(); ++j) {
+		if (branchingIndex == j % tss_->getNumCols(0)) {
+			branchingUp->push_back(j, CoinMin(cand.upValue, master_->cubd_node_[j]), master_->cubd_node_[j]);
+			branchingDn->push_back(j, master_->clbd_node_[j], CoinMax(master_->clbd_node_[j], cand.downValue));
+		} else if (master_->clbd_node_[j] > master_->clbd_orig_[j] || master_->cubd_node_[j] < master_->cubd_orig_[j]) {
+			/** store any bound changes made in parent nodes */
+			//DSPdebugMessage("Adjusting bound change on column %d: [%e,%e]\n", j, master_->clbd_node_[j], master_->cubd_node_[j]);
+			branchingUp->push_back(j, master_->clbd_node_[j], master_->cubd_node_[j]);
+			branchingDn->push_back(j, master_->clbd_node_[j], master_->cubd_node_[j]);
+		}
+	}
+
+	/** set best dual bounds */
+	branchingUp->bestBound_ = master_->getBestDualObjective();
+	branchingDn->bestBound_ = master_->getBestDualObjective();
+
+	/** assign best dual solutions */
+	branchingUp->dualsol_.assign(master_->getBestDualSolution(), master_->getBestDualSolution() + master_->nrows_);
+	branchingDn->dualsol_.assign(master_->getBestDualSolution(), master_->getBestDualSolution() + master_->nrows_);
+
+	/** set branching directions */
+	branchingUp->direction_ = 1;
+	branchingDn->direction_ = -1;
+
+	branchingUp->solEstimate_ = cand.score;
+	branchingDn->solEstimate_ = cand.score;
+
+	/** set pseudocost information */
+	branchingUp->pcIndex_ = branchingIndex;
+	branchingDn->pcIndex_ = branchingIndex;
+	branchingUp->pcFrac_ = cand.upValue - cand.value;
+	branchingDn->pcFrac_ = cand.value - cand.downValue;
+	branchingUp->parentObj_ = master_->getPrimalObjective();
+	branchingDn->parentObj_ = master_->getPrimalObjective();
+
+	/** drop an empty branch */
+	if (cand.upValue > master_->cubd_node_[branchingIndex])
+		FREE_PTR(branchingUp);
+	if (master_->clbd_node_[branchingIndex] > cand.downValue)
+		FREE_PTR(branchingDn);
+}
+
 void DwBranchNonant::getRefSol(std::vector<double>& refsol) {
 	refsol.resize(tss_->getNumCols(0), 0.0);
 	for (int j = 0; j < tss_->getNumCols(0) * tss_->getNumScenarios(); ++j) {
@@ -38,6 +38,12 @@ public:
 
 protected:
 
+    /** create the up and down branching objects of a candidate (NULL if a branch is empty) */
+    virtual void createBranchingObjects(
+    		const DwBranchCand& cand, /**< [in] branching candidate */
+			DspBranchObj*& branchingUp, /**< [out] up branch */
+			DspBranchObj*& branchingDn  /**< [out] down branch */);
+
 	/** epsilon value for branching on continuous variables */
 	double epsilon_ = 1.0e-6;
 	double epsilonBB_ = 1.0e-6;
@@ -11,6 +11,8 @@
 //#include "SolverInterface/OoqpEps.h"
 #include "Solver/DantzigWolfe/DwMaster.h"
 #include "Utility/DspUtility.h"
+#include "Utility/DspProfiler.h"
+#include "Utility/DspCheckpoint.h"
 
 DwMaster::DwMaster(DwWorker* worker):
 DecSolver(worker->model_, worker->par_, worker->message_),
@@ -27,6 +29,8 @@ mat_orig_(NULL),
 branchObj_(NULL),
 itercnt_(0),
 ngenerated_(0),
+nevals_fix_(0),
+init_cols_added_(false),
 t_start_(0.0),
 t_total_(0.0),
 t_master_(0.0),
@@ -64,6 +68,8 @@ branchObj_(rhs.branchObj_),
 bestprimsol_orig_(rhs.bestprimsol_orig_),
 itercnt_(rhs.itercnt_),
 ngenerated_(rhs.ngenerated_),
+nevals_fix_(rhs.nevals_fix_),
+init_cols_added_(rhs.init_cols_added_),
 log_time_(rhs.log_time_),
 log_bestdual_bounds_(rhs.log_bestdual_bounds_),
 log_bestprim_bounds_(rhs.log_bestprim_bounds_),
@@ -112,6 +118,7 @@ DwMaster& DwMaster::operator=(const DwMaster& rhs) {
 	branchObj_ = rhs.branchObj_;
 	itercnt_ = rhs.itercnt_;
 	ngenerated_ = rhs.ngenerated_;
+	init_cols_added_ = rhs.init_cols_added_;
 	t_start_ = rhs.t_start_;
 	t_total_ = rhs.t_total_;
 	t_master_ = rhs.t_master_;
@@ -340,6 +347,7 @@ DSP_RTN_CODE DwMaster::solve() {
 	BGN_TRY_CATCH
 
 	itercnt_ = 0;
+	nevals_fix_ = 0;
 	t_start_ = CoinGetTimeOfDay();
 	t_total_ = 0.0;
 	t_master_ = 0.0;
@@ -527,6 +535,7 @@ DSP_RTN_CODE DwMaster::gutsOfSolve() {
 				DSP_RTN_CHECK_RTN_CODE(generateColsByFix(stored_solutions_.size() - prev_nsols));
 
 				t_colgen_ += CoinGetTimeOfDay() - stime;
+				DSP_PROFILE_TIME("dw/colgen", CoinGetTimeOfDay() - stime);
 
 				/** subproblem solution may declare infeasibility. */
 				for (auto st = status_subs_.begin(); st != status_subs_.end(); st++) {
@@ -554,6 +563,7 @@ DSP_RTN_CODE DwMaster::gutsOfSolve() {
 		stime = CoinGetTimeOfDay();
 		DSP_RTN_CHECK_RTN_CODE(solveMaster());
 		t_master_ += CoinGetTimeOfDay() - stime;
+		DSP_PROFILE_TIME("dw/master_solve", CoinGetTimeOfDay() - stime);
 		t_total_ = CoinGetTimeOfDay() - t_start_;
 
 		/** print information and increment iteration */
@@ -817,9 +827,14 @@ DSP_RTN_CODE DwMaster::generateCols() {
 		for (unsigned i = 0; i < subsols.size(); ++i)
 			recent_subsols_.push_back(subsols[i]);
 
+		/** add the initial columns first */
+		int num_initial = 0;
+		DSP_RTN_CHECK_RTN_CODE(addInitialCols(num_initial));
+
 		/** create and add columns */
 		DSP_RTN_CHECK_RTN_CODE(
 				addCols(subinds, status_subs_, subcxs, subobjs, subsols));
+		ngenerated_ += num_initial;
 
 		if (model_->isStochastic() && 
 			par_->getIntParam("DW/MAX_EVAL_UB") > 0 &&
@@ -866,65 +881,104 @@ DSP_RTN_CODE DwMaster::generateColsByFix(
 
 	if (model_->isStochastic() == false) 
 		return DSP_RTN_OK;
+
+	/** limit the number of evaluations at this node */
+	int budget = par_->getIntParam("DW/EVAL_UB/BUDGET");
+	if (budget >= 0)
+		nsols = CoinMin(nsols, budget - nevals_fix_);
 	if (nsols <= 0)
 		return DSP_RTN_OK;
 
 	/** column generation info */
+	std::vector<int> cands;
 	std::vector<int> subinds;
 	std::vector<int> substatuses;
 	std::vector<double> subobjs;
 	std::vector<CoinPackedVector*> subsols;
-	std::vector<CoinPackedVector*> solutions_to_evaluate(nsols, NULL);
+
+	/** columns of a single candidate */
+	std::vector<int> candinds;
+	std::vector<int> candstatuses;
+	std::vector<double> candobjs;
+	std::vector<CoinPackedVector*> candsols;
 
 	BGN_TRY_CATCH
 
 	TssModel* tss = dynamic_cast<TssModel*>(model_);
+	int ncols_first_stage = tss->getNumCols(0);
 
 	// set time limit
 	double sub_timlim = par_->getDblParam("DW/SUB/TIME_LIM");
 
-	for (unsigned i = stored_solutions_.size() - 1, j = 0; i >= stored_solutions_.size() - nsols; --i)
-		solutions_to_evaluate[j++] = stored_solutions_[i];
+	/** number of solutions evaluated together */
+	int batch_size = CoinMax(1, par_->getIntParam("DW/EVAL_UB/BATCH"));
+	std::vector<double> first_stage_solutions_dense;
 
-	std::vector<double> first_stage_solution_dense(tss->getNumCols(0));
-	for (unsigned i = 0; i < solutions_to_evaluate.size(); ++i) {
-		/** generate columns */
-		std::fill(first_stage_solution_dense.begin(), first_stage_solution_dense.end(), 0.0);
-		for (int j = 0; j < solutions_to_evaluate[i]->getNumElements(); ++j)
-			first_stage_solution_dense[solutions_to_evaluate[i]->getIndices()[j]] = solutions_to_evaluate[i]->getElements()[j];
+	for (int first = 0; first < nsols; first += batch_size) {
+		int ncands = CoinMin(batch_size, nsols - first);
 
+		/** dense solutions in LIFO way */
+		first_stage_solutions_dense.assign(ncands * ncols_first_stage, 0.0);
+		for (int k = 0; k < ncands; ++k) {
+			const CoinPackedVector* sol = stored_solutions_[stored_solutions_.size() - 1 - first - k];
+			for (int j = 0; j < sol->getNumElements(); ++j)
+				first_stage_solutions_dense[k * ncols_first_stage + sol->getIndices()[j]] = sol->getElements()[j];
+		}
+
+		/** generate columns */
 		worker_->setTimeLimit(CoinMin(sub_timlim, time_remains_ - (CoinGetTimeOfDay() - t_start_)));
 		DSP_RTN_CHECK_RTN_CODE(
-				worker_->generateColsByFix(&first_stage_solution_dense[0], subinds, substatuses, subobjs, subsols));
-
-		/** any subproblem primal/dual infeasible? */
-		bool isInfeasibleFix = false;
-		for (auto status = substatuses.begin(); status != substatuses.end(); status++)
-			if (*status == DSP_STAT_PRIM_INFEASIBLE ||
-				*status == DSP_STAT_DUAL_INFEASIBLE) {
-				isInfeasibleFix = true;
-				break;
+				worker_->generateColsByFix(ncands, &first_stage_solutions_dense[0],
+						cands, subinds, substatuses, subobjs, subsols));
+		nevals_fix_ += ncands;
+		DSP_PROFILE_COUNT("dw/eval_ub_fix", ncands);
+
+		for (int k = 0; k < ncands; ++k) {
+			/** collect the columns of candidate k */
+			for (unsigned i = 0; i < cands.size(); ++i) {
+				if (cands[i] != k) continue;
+				candinds.push_back(subinds[i]);
+				candstatuses.push_back(substatuses[i]);
+				candobjs.push_back(subobjs[i]);
+				candsols.push_back(subsols[i]);
 			}
 
-		if (!isInfeasibleFix) {
-			/** create and add columns */
-			DSP_RTN_CHECK_RTN_CODE(
-					addCols(subinds, substatuses, subobjs, subobjs, subsols));
-
-			double newbound = 0.0;
-			for (auto it = subobjs.begin(); it != subobjs.end(); it++)
-				newbound += *it;
-			if (newbound < bestprimobj_) {
-				message_->print(3, "  Found new primal bound %e (< %e)\n", newbound, bestprimobj_);
-				bestprimobj_ = newbound;
-				bestprimsol_orig_.assign(ncols_orig_, 0.0);
-				for (unsigned s = 0; s < subsols.size(); s++)
-					for (int j = 0; j < subsols[s]->getNumElements(); ++j)
-						bestprimsol_orig_[subsols[s]->getIndices()[j]] = subsols[s]->getElements()[j];
+			/** any subproblem primal/dual infeasible? */
+			bool isInfeasibleFix = false;
+			for (auto status = candstatuses.begin(); status != candstatuses.end(); status++)
+				if (*status == DSP_STAT_PRIM_INFEASIBLE ||
+					*status == DSP_STAT_DUAL_INFEASIBLE) {
+					isInfeasibleFix = true;
+					break;
+				}
+
+			if (!isInfeasibleFix) {
+				/** create and add columns */
+				DSP_RTN_CHECK_RTN_CODE(
+						addCols(candinds, candstatuses, candobjs, candobjs, candsols));
+
+				double newbound = 0.0;
+				for (auto it = candobjs.begin(); it != candobjs.end(); it++)
+					newbound += *it;
+				if (newbound < bestprimobj_) {
+					message_->print(3, "  Found new primal bound %e (< %e)\n", newbound, bestprimobj_);
+					bestprimobj_ = newbound;
+					bestprimsol_orig_.assign(ncols_orig_, 0.0);
+					for (unsigned s = 0; s < candsols.size(); s++)
+						for (int j = 0; j < candsols[s]->getNumElements(); ++j)
+							bestprimsol_orig_[candsols[s]->getIndices()[j]] = candsols[s]->getElements()[j];
+				}
 			}
+
+			/** solutions are freed with subsols */
+			candinds.clear();
+			candstatuses.clear();
+			candobjs.clear();
+			candsols.clear();
 		}
 
 		/** clean up */
+		cands.clear();
 		subinds.clear();
 		substatuses.clear();
 		subobjs.clear();
@@ -936,15 +990,72 @@ DSP_RTN_CODE DwMaster::generateColsByFix(
 	// reset time limit
 	par_->setDblParam("DW/SUB/TIME_LIM", sub_timlim);
 
-	/** clear solution vector */
-	for (unsigned i = 0; i < solutions_to_evaluate.size(); ++i)
-		solutions_to_evaluate[i] = NULL;
-	solutions_to_evaluate.clear();
-
 	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
 	return DSP_RTN_OK;
 }
 
+DSP_RTN_CODE DwMaster::addInitialCols(
+		int& num_added /**< [out] number of columns added to the master */) {
+#define FREE_MEMORY \
+	for (unsigned i = 0; i < subsols.size(); ++i) \
+		FREE_PTR(subsols[i]);
+
+	std::vector<int> subinds;
+	std::vector<int> substatuses;
+	std::vector<double> subcxs;
+	std::vector<double> subobjs;
+	std::vector<CoinPackedVector*> subsols;
+
+	num_added = 0;
+	if (init_cols_added_)
+		return DSP_RTN_OK;
+
+	BGN_TRY_CATCH
+
+	init_cols_added_ = true;
+
+	/** The column pool is restored from the checkpoint. */
+	if (par_->getStrParam("DW/RESTART/FILE").size() > 0)
+		return DSP_RTN_OK;
+
+	/** initial columns */
+	if (par_->getDblPtrParamSize("DW/INIT_COLS") > 0) {
+		DSP_RTN_CHECK_RTN_CODE(
+				worker_->createCols(par_->getDblPtrParamSize("DW/INIT_COLS"), par_->getDblPtrParam("DW/INIT_COLS"),
+						subinds, subcxs, subsols));
+
+		/** The columns are added regardless of their reduced costs. */
+		substatuses.assign(subinds.size(), DSP_STAT_OPTIMAL);
+		subobjs.assign(subinds.size(), -COIN_DBL_MAX);
+		DSP_RTN_CHECK_RTN_CODE(addCols(subinds, substatuses, subcxs, subobjs, subsols));
+		num_added += ngenerated_;
+		message_->print(1, "Added %d initial columns.\n", ngenerated_);
+	}
+
+	/** initial incumbent */
+	if (par_->getDblPtrParamSize("INIT_INCUMBENT") > 0) {
+		if (model_->isStochastic()) {
+			const double* x = par_->getDblPtrParam("INIT_INCUMBENT");
+			CoinPackedVector* first_stage_solution = new CoinPackedVector;
+			for (int j = 0; j < par_->getDblPtrParamSize("INIT_INCUMBENT"); ++j)
+				if (fabs(x[j]) > 1.0e-8)
+					first_stage_solution->insert(j, x[j]);
+			stored_solutions_.push_back(first_stage_solution);
+			ngenerated_ = 0;
+			DSP_RTN_CHECK_RTN_CODE(generateColsByFix(1));
+			num_added += ngenerated_;
+		} else
+			message_->print(1, "The initial incumbent is ignored for a non-stochastic model.\n");
+	}
+
+	END_TRY_CATCH_RTN(FREE_MEMORY,DSP_RTN_ERR)
+
+	FREE_MEMORY
+
+	return DSP_RTN_OK;
+#undef FREE_MEMORY
+}
+
 DSP_RTN_CODE DwMaster::addCols(
 		std::vector<int>& indices,           /**< [in] subproblem indices corresponding to cols*/
 		std::vector<int>& statuses,          /**< [in] subproblem solution status */
@@ -1437,3 +1548,78 @@ DspOsi * DwMaster::createDspOsi() {
 	
 	return osi;
 }
+
+DSP_RTN_CODE DwMaster::writeColumnPool(std::ostream& os) {
+	std::vector<int> inds;
+	std::vector<double> elems;
+
+	BGN_TRY_CATCH
+
+	DspCheckpointWrite(os, "ncols", static_cast<int>(cols_generated_.size()));
+	for (auto it = cols_generated_.begin(); it != cols_generated_.end(); it++) {
+		DspCheckpointWrite(os, "colblock", (*it)->blockid_);
+		const CoinPackedVector& x = (*it)->x_;
+		DspCheckpointWrite(os, "colxind", std::vector<int>(x.getIndices(), x.getIndices() + x.getNumElements()));
+		DspCheckpointWrite(os, "colxval", std::vector<double>(x.getElements(), x.getElements() + x.getNumElements()));
+
+		/** branching rows differ by node and are recomputed when the column is reused */
+		inds.clear();
+		elems.clear();
+		for (int i = 0; i < (*it)->col_.getNumElements(); ++i) {
+			if ((*it)->col_.getIndices()[i] < nrows_core_) {
+				inds.push_back((*it)->col_.getIndices()[i]);
+				elems.push_back((*it)->col_.getElements()[i]);
+			}
+		}
+		DspCheckpointWrite(os, "colind", inds);
+		DspCheckpointWrite(os, "colval", elems);
+		DspCheckpointWrite(os, "colobj", (*it)->obj_);
+		DspCheckpointWrite(os, "collb", (*it)->lb_);
+		DspCheckpointWrite(os, "colub", (*it)->ub_);
+	}
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DwMaster::readColumnPool(std::istream& is) {
+	int ncols, blockid;
+	std::vector<int> xind, colind;
+	std::vector<double> xval, colval;
+	double obj, lb, ub;
+
+	BGN_TRY_CATCH
+
+	DspCheckpointRead(is, "ncols", ncols);
+	for (int k = 0; k < ncols; ++k) {
+		DspCheckpointRead(is, "colblock", blockid);
+		DspCheckpointRead(is, "colxind", xind);
+		DspCheckpointRead(is, "colxval", xval);
+		DspCheckpointRead(is, "colind", colind);
+		DspCheckpointRead(is, "colval", colval);
+		DspCheckpointRead(is, "colobj", obj);
+		DspCheckpointRead(is, "collb", lb);
+		DspCheckpointRead(is, "colub", ub);
+
+		/** check if the column belongs to this problem */
+		bool valid = blockid >= 0 && blockid < nrows_conv_ &&
+				xind.size() == xval.size() && colind.size() == colval.size();
+		for (unsigned j = 0; valid && j < xind.size(); ++j)
+			valid = xind[j] >= 0 && xind[j] < ncols_orig_;
+		for (unsigned i = 0; valid && i < colind.size(); ++i)
+			valid = colind[i] >= 0 && colind[i] < nrows_core_;
+		if (!valid)
+			throw CoinError("The column pool does not match the problem", "readColumnPool", "DwMaster");
+
+		cols_generated_.push_back(new DwCol(blockid, -1,
+				CoinPackedVector(xind.size(), xind.data(), xval.data()),
+				CoinPackedVector(colind.size(), colind.data(), colval.data()),
+				obj, lb, ub, false));
+	}
+	message_->print(1, "Restored %d columns to the pool.\n", ncols);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
@@ -90,6 +90,12 @@ public:
 	/** set branching objects */
 	virtual void setBranchingObjects(const DspBranchObj* branchobj);
 
+	/** write the generated columns to a checkpoint */
+	virtual DSP_RTN_CODE writeColumnPool(std::ostream& os);
+
+	/** read the generated columns from a checkpoint; they stay inactive until reused at a node. */
+	virtual DSP_RTN_CODE readColumnPool(std::istream& is);
+
 protected:
 
     /** create DspOsi for master */
@@ -139,6 +145,13 @@ protected:
     virtual DSP_RTN_CODE generateColsByFix(
         int nsols /**< [in] number of solutions to evaluate in LIFO way */);
 
+    /**
+     * add the initial columns in DW/INIT_COLS and evaluate the initial incumbent in INIT_INCUMBENT
+     * by fixing the first-stage variables. This is done only once, when the first columns are generated.
+     */
+    virtual DSP_RTN_CODE addInitialCols(
+        int& num_added /**< [out] number of columns added to the master */);
+
     /** calculate piA */
     virtual DSP_RTN_CODE calculatePiA(
 			std::vector<double>& piA /**< [out] pi^T A */);
@@ -229,6 +242,8 @@ public:
 
     int itercnt_;
     int ngenerated_;
+    int nevals_fix_; /**< number of stored solutions evaluated by fixing at the current node */
+    bool init_cols_added_; /**< whether the initial columns have been added */
 
     std::vector<double> log_time_;
     std::vector<double> log_bestdual_bounds_;
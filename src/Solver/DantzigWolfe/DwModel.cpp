@@ -11,6 +11,7 @@
 #include "Solver/DantzigWolfe/DwHeuristic.h"
 #include "Solver/DantzigWolfe/DwBranchInt.h"
 #include "Model/TssModel.h"
+#include "Utility/DspProfiler.h"
 
 DwModel::DwModel(): DspModel(), heuristic_time_elapsed_(0.0), branch_(NULL) {}
 
@@ -51,6 +52,28 @@ DSP_RTN_CODE DwModel::initBranch() {
 	return DSP_RTN_OK;
 }
 
+DSP_RTN_CODE DwModel::writeCheckpoint(std::ostream& os) {
+	BGN_TRY_CATCH
+
+	DSP_RTN_CHECK_THROW(DspModel::writeCheckpoint(os));
+	DSP_RTN_CHECK_THROW(dynamic_cast<DwMaster*>(solver_)->writeColumnPool(os));
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DwModel::readCheckpoint(std::istream& is) {
+	BGN_TRY_CATCH
+
+	DSP_RTN_CHECK_THROW(DspModel::readCheckpoint(is));
+	DSP_RTN_CHECK_THROW(dynamic_cast<DwMaster*>(solver_)->readColumnPool(is));
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
 DSP_RTN_CODE DwModel::initHeuristic() {
 	BGN_TRY_CATCH
 
@@ -134,6 +157,7 @@ DSP_RTN_CODE DwModel::solve() {
 			primsol_ = primsol;
 
 			heuristic_time_elapsed_ += CoinGetTimeOfDay() - heuristic_stime;
+			DSP_PROFILE_TIME("dw/heuristic", CoinGetTimeOfDay() - heuristic_stime);
 		}
 
 		break;
@@ -219,3 +243,8 @@ void DwModel::getRefSol(std::vector<double>& refsol) {
 bool DwModel::chooseBranchingObjects(std::vector<DspBranchObj*>& branchingObjs) {
 	return branch_->chooseBranchingObjects(branchingObjs);
 }
+
+void DwModel::updatePseudocost(const DspBranchObj* obj, double childobj) {
+	if (branch_)
+		branch_->updatePseudocost(obj, childobj);
+}
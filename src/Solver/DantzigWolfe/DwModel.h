@@ -32,6 +32,11 @@ public:
 
     virtual bool chooseBranchingObjects(
     			std::vector<DspBranchObj*>& branchingObjs /**< [out] branching objects */);
+
+    /** record the objective value of a child node for the pseudocost */
+    virtual void updatePseudocost(
+    		const DspBranchObj* obj, /**< [in] branching object of the child node */
+			double childobj          /**< [in] objective value of the child node */);
 				
     /** calculate and return reference solution */
     virtual void getRefSol(std::vector<double>& refsol);
@@ -50,6 +55,12 @@ protected:
 	/** parse Dantzig-Wolfe solution from the master */
 	virtual DSP_RTN_CODE parseDantzigWolfeSolution();
 
+	/** write the checkpoint entries including the column pool */
+	virtual DSP_RTN_CODE writeCheckpoint(std::ostream& os);
+
+	/** read the checkpoint entries including the column pool */
+	virtual DSP_RTN_CODE readCheckpoint(std::istream& is);
+
 public:
 
 	double heuristic_time_elapsed_;
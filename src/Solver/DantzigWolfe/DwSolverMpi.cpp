@@ -75,6 +75,9 @@ DSP_RTN_CODE DwSolverMpi::init() {
 		/** initialize the model */
 		DSP_RTN_CHECK_THROW(alps_->init());
 
+		/** resume from a checkpoint */
+		DSP_RTN_CHECK_THROW(alps_->restart());
+
 		/** parameter setting */
 		DspParams* par = alps_->getSolver()->getParPtr();
 		alps_->AlpsPar()->setEntry(AlpsParams::searchStrategy, par->getIntParam("ALPS/SEARCH_STRATEGY"));
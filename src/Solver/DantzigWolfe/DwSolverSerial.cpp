@@ -79,6 +79,9 @@ DSP_RTN_CODE DwSolverSerial::init() {
 	/** initialize the model */
 	DSP_RTN_CHECK_THROW(alps_->init());
 
+	/** resume from a checkpoint */
+	DSP_RTN_CHECK_THROW(alps_->restart());
+
 	/** parameter setting */
 	DspParams* par = alps_->getSolver()->getParPtr();
 	alps_->AlpsPar()->setEntry(AlpsParams::searchStrategy, par->getIntParam("ALPS/SEARCH_STRATEGY"));
@@ -140,6 +143,12 @@ DSP_RTN_CODE DwSolverSerial::solve() {
 			}
 		}
 	}
+
+	/** keep the open nodes to continue the search in the next run */
+	if (status_ == DSP_STAT_LIM_ITERorTIME)
+		DSP_RTN_CHECK_THROW(alps_->checkpoint(alpsBroker.getIncumbentValue(),
+				solution ? solution->solution_ : std::vector<double>()));
+
 	bestprimobj_ = alpsBroker.getBestQuality();
 	if (alpsstatus == AlpsExitStatusOptimal)
 		bestdualobj_ = bestprimobj_;
@@ -7,19 +7,23 @@
 
 // #define DSP_DEBUG
 
-#include "SolverInterface/DspOsiScip.h"
-#include "SolverInterface/DspOsiCpx.h"
-#include "SolverInterface/DspOsiGrb.h"
+#include "SolverInterface/DspOsiFactory.h"
 #include "Solver/DantzigWolfe/DwWorker.h"
 #include "Model/TssModel.h"
 #include "Utility/DspUtility.h"
+#include "Utility/DspProfiler.h"
+#include <thread>
+#include <algorithm>
 
 DwWorker::DwWorker(DecModel * model, DspParams * par, DspMessage * message) :
 		model_(model),
 		par_(par),
 		message_(message),
 		osi_(NULL),
-		sub_objs_(NULL) {
+		sub_objs_(NULL),
+		sub_clbd_(NULL),
+		sub_cubd_(NULL),
+		coupled_(NULL) {
 
 	/** parameters */
 	parProcIdxSize_ = par_->getIntPtrParamSize("ARR_PROC_IDX");
@@ -41,39 +45,8 @@ DwWorker::DwWorker(DecModel * model, DspParams * par, DspMessage * message) :
 
 	/** create solver interface */
 	osi_ = new DspOsi* [parProcIdxSize_];
-	switch(par_->getIntParam("DW/SUB/SOLVER")) {
-	case OsiCpx:
-#ifdef DSP_HAS_CPX
-		for (int i = 0; i < parProcIdxSize_; ++i)
-			osi_[i] = new DspOsiCpx();
-#else
-		throw CoinError("Cplex is not available.", "DwWorker", "DwWorker.cpp");
-#endif
-		break;
-	case OsiGrb:
-#ifdef DSP_HAS_GRB
-		for (int i = 0; i < parProcIdxSize_; ++i)
-			osi_[i] = new DspOsiGrb();
-#else
-		throw CoinError("Gurobi is not available.", "DwWorker", "DwWorker.cpp");
-#endif
-		break;
-	case OsiScip:
-#ifdef DSP_HAS_SCIP
-		for (int i = 0; i < parProcIdxSize_; ++i)
-			osi_[i] = new DspOsiScip();
-#else
-		throw CoinError("Scip is not available.", "DwWorker", "DwWorker.cpp");
-#endif
-		break;
-	default:
-		throw CoinError("Invalid paramter value", "DwWorker", "DwWorker.cpp");
-		break;
-	}
-
-	/** set display */
-	for (int i = 0; i < parProcIdxSize_; ++i) 
-		osi_[i]->setLogLevel(par_->getIntParam("DW/SUB/SOLVER/LOG_LEVEL"));
+	for (int i = 0; i < parProcIdxSize_; ++i)
+		osi_[i] = createDspOsi();
 
 	/** subproblem objective coefficients */
 	sub_objs_ = new double* [parProcIdxSize_];
@@ -84,17 +57,7 @@ DwWorker::DwWorker(DecModel * model, DspParams * par, DspMessage * message) :
 		sub_objs_[i] = NULL;
 		sub_clbd_[i] = NULL;
 		sub_cubd_[i] = NULL;
-
-		/** indicate whether columns are coupled with the master or not. */
-		coupled_[i] = new bool [model_->getNumCouplingCols()];
-		CoinFillN(coupled_[i], model_->getNumCouplingCols(), false);
-
-		int nccols = model_->getNumSubproblemCouplingCols(parProcIdx_[i]);
-		const int* ccols = model_->getSubproblemCouplingColIndices(parProcIdx_[i]);
-		DSPdebugMessage("Subproblem(%d) coupling columns:\n", parProcIdx_[i]);
-		DSPdebug(DspMessage::printArray(nccols, ccols));
-		for (int j = 0; j < nccols; ++j)
-			coupled_[i][ccols[j]] = true;
+		setCoupledColumns(i);
 	}
 
 	/** create subproblems */
@@ -115,7 +78,45 @@ DwWorker::~DwWorker() {
 	}
 }
 
+DspOsi* DwWorker::createDspOsi() {
+	/** The subproblems evaluated by the threads need their own solver environments. */
+	DspOsi* osi = DspOsiFactory::create(par_->getIntParam("DW/SUB/SOLVER"),
+			par_->getIntParam("DW/EVAL_UB/THREADS") > 1);
+
+	/** set display */
+	osi->setLogLevel(par_->getIntParam("DW/SUB/SOLVER/LOG_LEVEL"));
+
+	return osi;
+}
+
+void DwWorker::setCoupledColumns(int s) {
+	/** indicate whether columns are coupled with the master or not. */
+	coupled_[s] = new bool [model_->getNumCouplingCols()];
+	CoinFillN(coupled_[s], model_->getNumCouplingCols(), false);
+
+	int nccols = model_->getNumSubproblemCouplingCols(parProcIdx_[s]);
+	const int* ccols = model_->getSubproblemCouplingColIndices(parProcIdx_[s]);
+	DSPdebugMessage("Subproblem(%d) coupling columns:\n", parProcIdx_[s]);
+	DSPdebug(DspMessage::printArray(nccols, ccols));
+	for (int j = 0; j < nccols; ++j)
+		coupled_[s][ccols[j]] = true;
+}
+
 DSP_RTN_CODE DwWorker::createSubproblems() {
+	BGN_TRY_CATCH
+
+	num_timelim_stops_.assign(parProcIdxSize_, 0);
+	sub_times_.assign(parProcIdxSize_, 0.0);
+
+	for (int s = 0; s < parProcIdxSize_; ++s)
+		DSP_RTN_CHECK_RTN_CODE(createSubproblem(s));
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DwWorker::createSubproblem(int s) {
 #define FREE_MEMORY        \
 	FREE_PTR(mat);    \
 	FREE_ARRAY_PTR(ctype); \
@@ -133,70 +134,63 @@ DSP_RTN_CODE DwWorker::createSubproblems() {
 	if (model_->isStochastic())
 		tss = dynamic_cast<TssModel*>(model_);
 
-	num_timelim_stops_.assign(parProcIdxSize_, 0);
-
-	for (int s = 0; s < parProcIdxSize_; ++s) {
-		if (model_->isStochastic()) {
-			DSP_RTN_CHECK_RTN_CODE(
-					model_->decompose(1, &parProcIdx_[s], 0, NULL, NULL, NULL,
-							mat, sub_clbd_[s], sub_cubd_[s], ctype, sub_objs_[s], rlbd, rubd));
-			for (int j = 0; j < tss->getNumCols(0); ++j)
-				sub_objs_[s][j] *= tss->getProbability()[parProcIdx_[s]];
-		} else {
-			DSP_RTN_CHECK_RTN_CODE(
-					model_->copySubprob(parProcIdx_[s], mat, sub_clbd_[s], sub_cubd_[s], ctype, sub_objs_[s], rlbd, rubd));
-			DSPdebug(mat->verifyMtx(4));
-
-			/** fix zeros for non-coupling columns */
-			for (int j = 0; j < model_->getNumCouplingCols(); ++j) {
-				if (coupled_[s][j] == false) {
-					sub_clbd_[s][j] = 0.0;
-					sub_cubd_[s][j] = 0.0;
-					sub_objs_[s][j] = 0.0;
-				}
+	if (model_->isStochastic()) {
+		DSP_RTN_CHECK_RTN_CODE(
+				model_->decompose(1, &parProcIdx_[s], 0, NULL, NULL, NULL,
+						mat, sub_clbd_[s], sub_cubd_[s], ctype, sub_objs_[s], rlbd, rubd));
+		for (int j = 0; j < tss->getNumCols(0); ++j)
+			sub_objs_[s][j] *= tss->getProbability()[parProcIdx_[s]];
+	} else {
+		DSP_RTN_CHECK_RTN_CODE(
+				model_->copySubprob(parProcIdx_[s], mat, sub_clbd_[s], sub_cubd_[s], ctype, sub_objs_[s], rlbd, rubd));
+		DSPdebug(mat->verifyMtx(4));
+
+		/** fix zeros for non-coupling columns */
+		for (int j = 0; j < model_->getNumCouplingCols(); ++j) {
+			if (coupled_[s][j] == false) {
+				sub_clbd_[s][j] = 0.0;
+				sub_cubd_[s][j] = 0.0;
+				sub_objs_[s][j] = 0.0;
 			}
 		}
-		DSPdebugMessage("sub_objs_[%d]:\n", parProcIdx_[s]);
-		DSPdebug(DspMessage::printArray(model_->getNumCouplingCols(), sub_objs_[s]));
-
-		/** load problem to si */
-		osi_[s]->si_->loadProblem(*mat, sub_clbd_[s], sub_cubd_[s], sub_objs_[s], rlbd, rubd);
-
-		/** set integers */
-		int nintegers = 0;
-		for (int j = 0; j < osi_[s]->si_->getNumCols(); ++j) {
-			if (ctype[j] != 'C') {
-				osi_[s]->si_->setInteger(j);
-				nintegers++;
-			}
+	}
+	DSPdebugMessage("sub_objs_[%d]:\n", parProcIdx_[s]);
+	DSPdebug(DspMessage::printArray(model_->getNumCouplingCols(), sub_objs_[s]));
+
+	/** load problem to si */
+	osi_[s]->si_->loadProblem(*mat, sub_clbd_[s], sub_cubd_[s], sub_objs_[s], rlbd, rubd);
+
+	/** set integers */
+	int nintegers = 0;
+	for (int j = 0; j < osi_[s]->si_->getNumCols(); ++j) {
+		if (ctype[j] != 'C') {
+			osi_[s]->si_->setInteger(j);
+			nintegers++;
 		}
+	}
 
-		osi_[s]->setLogLevel(par_->getIntParam("DW/SUB/SOLVER/LOG_LEVEL"));
+	osi_[s]->setLogLevel(par_->getIntParam("DW/SUB/SOLVER/LOG_LEVEL"));
 
-		/** set parameters */
-		osi_[s]->setRelMipGap(par_->getDblParam("DW/SUB/GAPTOL"));
-		osi_[s]->setTimeLimit(par_->getDblParam("DW/SUB/TIME_LIM"));
-		osi_[s]->setNumCores(par_->getIntParam("DW/SUB/THREADS"));
+	/** set parameters */
+	osi_[s]->setRelMipGap(par_->getDblParam("DW/SUB/GAPTOL"));
+	osi_[s]->setTimeLimit(par_->getDblParam("DW/SUB/TIME_LIM"));
+	osi_[s]->setNumCores(par_->getIntParam("DW/SUB/THREADS"));
 
-		/** TODO: Is this option critical to performance? */
-		// CPXsetintparam(cpx->getEnvironmentPtr(), CPX_PARAM_ADVIND, par_->getIntParam("DW/SUB/ADVIND"));
+	/** TODO: Is this option critical to performance? */
+	// CPXsetintparam(cpx->getEnvironmentPtr(), CPX_PARAM_ADVIND, par_->getIntParam("DW/SUB/ADVIND"));
 
-		/** initial solve */
-		osi_[s]->solve();
+	/** initial solve */
+	osi_[s]->solve();
 
 #ifdef DSP_DEBUG
-		if (s >= 0) {
-			/** write MPS */
-			char ofname[128];
-			sprintf(ofname, "sub%d.mps", parProcIdx_[s]);
-			DSPdebugMessage("Writing MPS file: %s\n", ofname);
-			osi_[s]->si_->writeMps(ofname);
-		}
-#endif
-
-		/** free memory */
-		FREE_MEMORY
+	if (s >= 0) {
+		/** write MPS */
+		char ofname[128];
+		sprintf(ofname, "sub%d.mps", parProcIdx_[s]);
+		DSPdebugMessage("Writing MPS file: %s\n", ofname);
+		osi_[s]->si_->writeMps(ofname);
 	}
+#endif
 
 	END_TRY_CATCH_RTN(FREE_MEMORY,DSP_RTN_ERR)
 
@@ -354,12 +348,82 @@ DSP_RTN_CODE DwWorker::generateCols(
 	return DSP_RTN_OK;
 }
 
+DSP_RTN_CODE DwWorker::createCols(
+		int size,                            /**< [in] size of records */
+		const double* records,               /**< [in] records of subproblem solutions */
+		std::vector<int>& indices,           /**< [out] subproblem indices */
+		std::vector<double>& cxs,            /**< [out] solution times original objective coefficients */
+		std::vector<CoinPackedVector*>& sols /**< [out] subproblem coupling column solutions */) {
+	TssModel* tss = NULL;
+
+	BGN_TRY_CATCH
+
+	if (model_->isStochastic())
+		tss = dynamic_cast<TssModel*>(model_);
+
+	for (int pos = 0; pos + 1 < size; ) {
+		int sind = static_cast<int>(records[pos]);
+		int ncols = static_cast<int>(records[pos+1]);
+		const double* x = records + pos + 2;
+		pos += 2 + ncols;
+		if (pos > size)
+			throw CoinError("Invalid records of subproblem solutions", "createCols", "DwWorker");
+
+		/** find the subproblem of this worker */
+		int s = std::find(parProcIdx_, parProcIdx_ + parProcIdxSize_, sind) - parProcIdx_;
+		if (s == parProcIdxSize_)
+			continue;
+		if (ncols != osi_[s]->si_->getNumCols())
+			throw CoinError("Invalid number of columns in the subproblem solution", "createCols", "DwWorker");
+
+		/** subproblem objective value */
+		double cx = 0.0;
+		for (int j = 0; j < ncols; ++j)
+			cx += sub_objs_[s][j] * x[j];
+
+		/** subproblem coupling solution */
+		CoinPackedVector* sol = new CoinPackedVector;
+		sol->reserve(ncols);
+		for (int j = 0; j < ncols; ++j) {
+			if (fabs(x[j]) > 1.0e-8) {
+				if (model_->isStochastic()) {
+					if (j < tss->getNumCols(0))
+						sol->insert(sind * tss->getNumCols(0) + j, x[j]);
+					else
+						sol->insert((tss->getNumScenarios()-1) * tss->getNumCols(0) + sind * tss->getNumCols(1) + j, x[j]);
+				} else
+					sol->insert(j, x[j]);
+			}
+		}
+
+		indices.push_back(sind);
+		cxs.push_back(cx);
+		sols.push_back(sol);
+	}
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
 DSP_RTN_CODE DwWorker::generateColsByFix(
 		const double* x,                     /**< [in] solution to fix */
 		std::vector<int>& indices,           /**< [out] subproblem indices */
 		std::vector<int>& statuses,          /**< [out] solution status */
 		std::vector<double>& objs,           /**< [out] subproblem objective values */
 		std::vector<CoinPackedVector*>& sols /**< [out] subproblem coupling column solutions */) {
+	std::vector<int> cands;
+	return generateColsByFix(1, x, cands, indices, statuses, objs, sols);
+}
+
+DSP_RTN_CODE DwWorker::generateColsByFix(
+		int ncands,                          /**< [in] number of solutions to fix */
+		const double* xs,                    /**< [in] solutions to fix (ncands by number of first-stage columns) */
+		std::vector<int>& cands,             /**< [out] candidate indices */
+		std::vector<int>& indices,           /**< [out] subproblem indices */
+		std::vector<int>& statuses,          /**< [out] solution status */
+		std::vector<double>& objs,           /**< [out] subproblem objective values */
+		std::vector<CoinPackedVector*>& sols /**< [out] subproblem coupling column solutions */) {
 
 	/** run only for stochastic models */
 	if (model_->isStochastic() == false)
@@ -367,10 +431,17 @@ DSP_RTN_CODE DwWorker::generateColsByFix(
 
 	BGN_TRY_CATCH
 
-	double objval;
-	CoinPackedVector* sol = NULL;
-	TssModel* tss = dynamic_cast<TssModel*>(model_);
-	int ncols_first_stage = tss->getNumCols(0);
+	/** cleanup */
+	cands.clear();
+	indices.clear();
+	statuses.clear();
+	objs.clear();
+	for (unsigned i = 0; i < sols.size(); ++i)
+		FREE_PTR(sols[i]);
+	sols.clear();
+
+	if (ncands <= 0 || parProcIdxSize_ <= 0)
+		return DSP_RTN_OK;
 
 	/** set objective function */
 	for (int s = 0; s < parProcIdxSize_; ++s) {
@@ -380,32 +451,89 @@ DSP_RTN_CODE DwWorker::generateColsByFix(
 		}
 	}
 
-	/** fix column bounds */
-	for (int s = 0; s < parProcIdxSize_; ++s) {
-		for (int j = 0; j < ncols_first_stage; ++j)
-			osi_[s]->si_->setColBounds(j, x[j], x[j]);
+	/** results of candidate k for subproblem s at k * parProcIdxSize_ + s */
+	int nresults = ncands * parProcIdxSize_;
+	std::vector<int> _statuses(nresults, DSP_STAT_UNKNOWN);
+	std::vector<double> _objs(nresults, 0.0);
+	std::vector<CoinPackedVector*> _sols(nresults, NULL);
+
+	/** A solver instance is not shared by threads, so the threads split the subproblems. */
+	int nthreads = CoinMax(1, CoinMin(par_->getIntParam("DW/EVAL_UB/THREADS"), parProcIdxSize_));
+	std::vector<DSP_RTN_CODE> rtns(nthreads, DSP_RTN_OK);
+	auto evaluate = [&](int t) {
+		/** candidate-major buffers are filled with stride parProcIdxSize_ by evaluateFix */
+		for (int s = t; s < parProcIdxSize_ && rtns[t] == DSP_RTN_OK; s += nthreads)
+			rtns[t] = evaluateFix(s, ncands, xs, &_statuses[s], &_objs[s], &_sols[s]);
+	};
+	if (nthreads == 1)
+		evaluate(0);
+	else {
+		std::vector<std::thread> threads;
+		for (int t = 0; t < nthreads; ++t)
+			threads.push_back(std::thread(evaluate, t));
+		for (int t = 0; t < nthreads; ++t)
+			threads[t].join();
 	}
 
-	/** solve subproblems */
-	DSP_RTN_CHECK_RTN_CODE(solveSubproblems());
+	/** reset subproblems */
+	DSP_RTN_CHECK_RTN_CODE(resetSubproblems());
 
-	/** cleanup and reserve memory*/
-	indices.clear();
-	statuses.clear();
-	objs.clear();
-	for (unsigned i = 0; i < sols.size(); ++i)
-		FREE_PTR(sols[i]);
-	sols.clear();
-	indices.reserve(parProcIdxSize_);
-	statuses.reserve(parProcIdxSize_);
-	objs.reserve(parProcIdxSize_);
-	sols.reserve(parProcIdxSize_);
+	for (int t = 0; t < nthreads; ++t) {
+		if (rtns[t] != DSP_RTN_OK) {
+			for (int i = 0; i < nresults; ++i)
+				FREE_PTR(_sols[i]);
+			return rtns[t];
+		}
+	}
 
-	for (int s = 0; s < parProcIdxSize_; ++s) {
-		int sind = parProcIdx_[s];
+	/** construct output arguments */
+	cands.reserve(nresults);
+	indices.reserve(nresults);
+	statuses.reserve(nresults);
+	objs.reserve(nresults);
+	sols.reserve(nresults);
+	for (int k = 0; k < ncands; ++k) {
+		for (int s = 0; s < parProcIdxSize_; ++s) {
+			int i = k * parProcIdxSize_ + s;
+			cands.push_back(k);
+			indices.push_back(parProcIdx_[s]);
+			statuses.push_back(_statuses[i]);
+			objs.push_back(_objs[i]);
+			sols.push_back(_sols[i]);
+			_sols[i] = NULL;
+		}
+	}
 
-		/** add subproblem index */
-		indices.push_back(sind);
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DwWorker::evaluateFix(
+		int s,                     /**< [in] subproblem index of this worker */
+		int ncands,                /**< [in] number of solutions to fix */
+		const double* xs,          /**< [in] solutions to fix */
+		int* statuses,             /**< [out] solution status for each candidate */
+		double* objs,              /**< [out] subproblem objective value for each candidate */
+		CoinPackedVector** sols    /**< [out] subproblem solution for each candidate */) {
+
+	BGN_TRY_CATCH
+
+	TssModel* tss = dynamic_cast<TssModel*>(model_);
+	int ncols_first_stage = tss->getNumCols(0);
+	int sind = parProcIdx_[s];
+
+	for (int k = 0; k < ncands; ++k) {
+		/** output location of candidate k */
+		int i = k * parProcIdxSize_;
+		const double* x = xs + k * ncols_first_stage;
+
+		/** fix column bounds */
+		for (int j = 0; j < ncols_first_stage; ++j)
+			osi_[s]->si_->setColBounds(j, x[j], x[j]);
+
+		/** solve subproblem */
+		DSP_RTN_CHECK_RTN_CODE(solveSubproblem(s, -1.0));
 
 		/** store solution status */
 		int status = osi_[s]->status();
@@ -417,14 +545,15 @@ DSP_RTN_CODE DwWorker::generateColsByFix(
 		}
 
 		DSPdebugMessage("sind %d status %d\n", sind, status);
-		statuses.push_back(status);
+		statuses[i] = status;
 
 		if (!osi_[s]->si_->isAbandoned() && !osi_[s]->si_->isProvenPrimalInfeasible()) {
-			sol = new CoinPackedVector;
+			double objval = 0.0;
+			CoinPackedVector* sol = new CoinPackedVector;
 			sol->reserve(osi_[s]->si_->getNumCols());
 
 			if (!osi_[s]->si_->isProvenDualInfeasible()) {
-				const double* xs = osi_[s]->si_->getColSolution();
+				const double* xsub = osi_[s]->si_->getColSolution();
 
 				/** subproblem objective value */
 				if (osi_[s]->si_->getNumIntegers())
@@ -435,9 +564,7 @@ DSP_RTN_CODE DwWorker::generateColsByFix(
 
 				/** subproblem coupling solution */
 				for (int j = 0; j < osi_[s]->si_->getNumCols(); ++j) {
-					double xval = xs[j];
-					//if (sub_clbd_[s][j] == sub_cubd_[s][j])
-					//	printf("sind %d j %d [%e, %e, %e]\n", sind, j, sub_clbd_[s][j], xval, sub_cubd_[s][j]);
+					double xval = xsub[j];
 					if (fabs(xval) > 1.0e-8) {
 						if (j < tss->getNumCols(0))
 							sol->insert(sind * tss->getNumCols(0) + j, xval);
@@ -448,20 +575,16 @@ DSP_RTN_CODE DwWorker::generateColsByFix(
 			}
 
 			/** store objective and solution */
-			objs.push_back(objval);
-			sols.push_back(sol);
-			sol = NULL;
+			objs[i] = objval;
+			sols[i] = sol;
 		} else {
 			message_->print(5, "generateColsByFix: Unexpected subproblem status (block: %d, status: %d)\n", sind, status);
 			/** store dummies */
-			objs.push_back(0.0);
-			sols.push_back(new CoinPackedVector);
+			objs[i] = 0.0;
+			sols[i] = new CoinPackedVector;
 		}
 	}
 
-	/** reset subproblems */
-	DSP_RTN_CHECK_RTN_CODE(resetSubproblems());
-
 	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
 
 	return DSP_RTN_OK;
@@ -607,32 +730,49 @@ DSP_RTN_CODE DwWorker::solveSubproblems() {
 	}
 
 	/** TODO: That's it? Dual infeasible??? */
-	for (int s = 0; s < parProcIdxSize_; ++s) {
-		if (osi_[s]->si_->getNumIntegers() > 0) {
-
-			/** increase time limit */
-			if (max_stops > 0)
-				osi_[s]->setTimeLimit(timlim);
-
-			/** solve */
-			osi_[s]->solve();
-			DSPdebugMessage("MILP subproblem %d status %d\n", parProcIdx_[s], osi_[s]->status());
-			
-			if (osi_[s]->si_->isProvenDualInfeasible()) {
-				/** If primal unbounded, ray may not be immediately available.
-				 * But, it becomes available if it is solved one more time.
-				 * This is probably because the resolve() above behaved as initialSolve(),
-				 * in which case presolve determines unboundedness without solve.
-				 */
-				osi_[s]->si_->resolve();
-			}
-		} else {
-			/** solve LP relaxation */
+	for (int s = 0; s < parProcIdxSize_; ++s)
+		DSP_RTN_CHECK_RTN_CODE(solveSubproblem(s, max_stops > 0 ? timlim : -1.0));
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DwWorker::solveSubproblem(
+		int s,        /**< [in] subproblem index of this worker */
+		double timlim /**< [in] time limit to set for MILP (ignored if not positive) */) {
+	double walltime = CoinGetTimeOfDay();
+
+	BGN_TRY_CATCH
+
+	DSP_PROFILE_SCOPE_INDEX("dw/pricing_block", parProcIdx_[s]);
+	if (osi_[s]->si_->getNumIntegers() > 0) {
+
+		/** increase time limit */
+		if (timlim > 0)
+			osi_[s]->setTimeLimit(timlim);
+
+		/** solve */
+		osi_[s]->solve();
+		DSPdebugMessage("MILP subproblem %d status %d\n", parProcIdx_[s], osi_[s]->status());
+
+		if (osi_[s]->si_->isProvenDualInfeasible()) {
+			/** If primal unbounded, ray may not be immediately available.
+			 * But, it becomes available if it is solved one more time.
+			 * This is probably because the resolve() above behaved as initialSolve(),
+			 * in which case presolve determines unboundedness without solve.
+			 */
 			osi_[s]->si_->resolve();
-			DSPdebugMessage("LP relaxation subproblem %d status %d\n", parProcIdx_[s], osi_[s]->status());
 		}
+	} else {
+		/** solve LP relaxation */
+		osi_[s]->si_->resolve();
+		DSPdebugMessage("LP relaxation subproblem %d status %d\n", parProcIdx_[s], osi_[s]->status());
 	}
 
+	/** measured for rebalancing the subproblems */
+	sub_times_[s] += CoinGetTimeOfDay() - walltime;
+
 	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
 
 	return DSP_RTN_OK;
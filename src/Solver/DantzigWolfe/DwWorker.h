@@ -47,6 +47,34 @@ public:
 			std::vector<double>& objs,           /**< [out] subproblem objective values */
 			std::vector<CoinPackedVector*>& sols /**< [out] subproblem coupling column solutions */);
 
+	/**
+	 * generate variables by fixing each of the given solutions (e.g., upper bounding for SMIP)
+	 *
+	 * The outputs are ordered by candidate, and cands gives the candidate index of each output.
+	 * The subproblems are distributed to DW/EVAL_UB/THREADS threads, each of which evaluates
+	 * all the candidates for its subproblems.
+	 */
+	virtual DSP_RTN_CODE generateColsByFix(
+			int ncands,                          /**< [in] number of solutions to fix */
+			const double* xs,                    /**< [in] solutions to fix (ncands by number of first-stage columns) */
+			std::vector<int>& cands,             /**< [out] candidate indices */
+			std::vector<int>& indices,           /**< [out] subproblem indices */
+			std::vector<int>& statuses,          /**< [out] solution status */
+			std::vector<double>& objs,           /**< [out] subproblem objective values */
+			std::vector<CoinPackedVector*>& sols /**< [out] subproblem coupling column solutions */);
+
+	/**
+	 * create the columns of the given subproblem solutions (e.g., initial columns). The solutions
+	 * are given as records [block, number of columns, solution], and the records of the blocks
+	 * that are not assigned to this worker are ignored.
+	 */
+	virtual DSP_RTN_CODE createCols(
+			int size,                            /**< [in] size of records */
+			const double* records,               /**< [in] records of subproblem solutions */
+			std::vector<int>& indices,           /**< [out] subproblem indices */
+			std::vector<double>& cxs,            /**< [out] solution times original objective coefficients */
+			std::vector<CoinPackedVector*>& sols /**< [out] subproblem coupling column solutions */);
+
 	/** get number of total subproblems */
 	virtual int getNumSubprobs() {return nsubprobs_;}
 
@@ -75,9 +103,18 @@ private:
 
 protected:
 
+	/** create a solver interface for a subproblem */
+	virtual DspOsi* createDspOsi();
+
+	/** allocate and set the coupling column indicators of a subproblem */
+	virtual void setCoupledColumns(int s /**< [in] subproblem index of this worker */);
+
 	/** create subproblems */
 	virtual DSP_RTN_CODE createSubproblems();
 
+	/** create a subproblem */
+	virtual DSP_RTN_CODE createSubproblem(int s /**< [in] subproblem index of this worker */);
+
 	/**
 	 * This calculates and sets the objective coefficients for the subproblems.
 	 */
@@ -88,6 +125,20 @@ protected:
 	/** solve subproblems */
 	virtual DSP_RTN_CODE solveSubproblems();
 
+	/** solve a subproblem */
+	virtual DSP_RTN_CODE solveSubproblem(
+			int s,        /**< [in] subproblem index of this worker */
+			double timlim /**< [in] time limit to set for MILP (ignored if not positive) */);
+
+	/** evaluate the candidate solutions for a subproblem */
+	virtual DSP_RTN_CODE evaluateFix(
+			int s,                     /**< [in] subproblem index of this worker */
+			int ncands,                /**< [in] number of solutions to fix */
+			const double* xs,          /**< [in] solutions to fix */
+			int* statuses,             /**< [out] solution status for each candidate */
+			double* objs,              /**< [out] subproblem objective value for each candidate */
+			CoinPackedVector** sols    /**< [out] subproblem solution for each candidate */);
+
 	/** reset subproblems */
 	virtual DSP_RTN_CODE resetSubproblems();
 
@@ -114,6 +165,8 @@ protected:
 
 	std::vector<int> num_timelim_stops_; /**< number of stops due to time limit */
 
+	std::vector<double> sub_times_; /**< wall clock time spent on each subproblem */
+
 	std::vector<std::vector<int>> added_rowids_; /**< added row ids */
 };
 
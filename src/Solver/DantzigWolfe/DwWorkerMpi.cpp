@@ -6,8 +6,10 @@
  */
 
 //#define DSP_DEBUG
+#include <algorithm>
 #include "Model/TssModel.h"
 #include "Solver/DantzigWolfe/DwWorkerMpi.h"
+#include "Utility/DspLoadBalance.h"
 
 DwWorkerMpi::DwWorkerMpi(
 		DecModel * model,
@@ -15,7 +17,7 @@ DwWorkerMpi::DwWorkerMpi(
 		DspMessage * message,
 		MPI_Comm comm):
 DwWorker(model, par, message),
-comm_(comm), resetTimeIncrement_(0) {
+comm_(comm), resetTimeIncrement_(0), ngenerated_(0) {
 	MPI_Comm_rank(comm_, &comm_rank_);
 	MPI_Comm_size(comm_, &comm_size_);
 
@@ -36,6 +38,14 @@ comm_(comm), resetTimeIncrement_(0) {
 	if (comm_rank_ == 0)
 		DSPdebugMessage("Number of subproblems: %d\n", nsubprobs_);
 #endif
+
+	/** Rebalancing requires every rank to have the whole model and each subproblem in a single rank. */
+	parRebalanceFreq_ = par_->getIntParam("DW/REBALANCE/FREQ");
+	if (parRebalanceFreq_ > 0 && (!model_->isStochastic() || nsubprobs_ != model_->getNumSubproblems())) {
+		if (comm_rank_ == 0)
+			message_->print(0, "Warning: Rebalancing subproblems is disabled. It requires a stochastic model with each subproblem in a single process.\n");
+		parRebalanceFreq_ = 0;
+	}
 }
 
 DwWorkerMpi::~DwWorkerMpi() {
@@ -44,6 +54,7 @@ DwWorkerMpi::~DwWorkerMpi() {
 
 DSP_RTN_CODE DwWorkerMpi::receiver() {
 	int signal;
+	std::vector<int> cands;
 	std::vector<int> indices;
 	std::vector<int> statuses;
 	std::vector<double> cxs;
@@ -75,11 +86,16 @@ DSP_RTN_CODE DwWorkerMpi::receiver() {
 			break;
 		case sig_generateColsByFix:
 			DSP_RTN_CHECK_RTN_CODE(
-					generateColsByFix(NULL, indices, statuses, objs, sols));
+					generateColsByFix(0, NULL, cands, indices, statuses, objs, sols));
+			cands.clear();
 			indices.clear();
 			statuses.clear();
 			cxs.clear();
 			objs.clear();
+			for (size_t i = 0; i < sols.size(); ++i) {
+				delete sols[i];
+				sols[i] = NULL;
+			}
 			sols.clear();
 			break;
 		case sig_setColBounds:
@@ -221,6 +237,11 @@ DSP_RTN_CODE DwWorkerMpi::generateCols(
 		_sols.clear();
 	}
 
+	/** rebalance the subproblems at the iteration boundary */
+	ngenerated_++;
+	if (parRebalanceFreq_ > 0 && ngenerated_ % parRebalanceFreq_ == 0)
+		DSP_RTN_CHECK_RTN_CODE(rebalance());
+
 	END_TRY_CATCH_RTN(FREE_MEMORY,DSP_RTN_ERR)
 
 	FREE_MEMORY
@@ -230,7 +251,9 @@ DSP_RTN_CODE DwWorkerMpi::generateCols(
 }
 
 DSP_RTN_CODE DwWorkerMpi::generateColsByFix(
-		const double* x,                     /**< [in] solution to fix */
+		int ncands,                          /**< [in] number of solutions to fix */
+		const double* xs,                    /**< [in] solutions to fix (ncands by number of first-stage columns) */
+		std::vector<int>& cands,             /**< [out] candidate indices */
 		std::vector<int>& indices,           /**< [out] subproblem indices */
 		std::vector<int>& statuses,          /**< [out] solution status */
 		std::vector<double>& objs,           /**< [out] subproblem objective values */
@@ -238,7 +261,8 @@ DSP_RTN_CODE DwWorkerMpi::generateColsByFix(
 #define FREE_MEMORY \
 		FREE_ARRAY_PTR(recvcounts) \
 		FREE_ARRAY_PTR(displs) \
-		FREE_ARRAY_PTR(_x) \
+		FREE_ARRAY_PTR(_xs) \
+		FREE_ARRAY_PTR(_cands) \
 		FREE_ARRAY_PTR(_indices) \
 		FREE_ARRAY_PTR(_statuses) \
 		FREE_ARRAY_PTR(_objs) \
@@ -246,11 +270,13 @@ DSP_RTN_CODE DwWorkerMpi::generateColsByFix(
 			FREE_PTR(_sols[i]); \
 		}
 
-	int* recvcounts = NULL; /**< number of subproblems for each rank */
+	int* recvcounts = NULL; /**< number of results for each rank */
 	int* displs = NULL;     /**< displacement for each receive buffer */
+	int nresults;           /**< number of results in this rank */
 
 	/** temporary arrays to collect data from ranks */
-	double* _x = NULL;
+	double* _xs = NULL;
+	int* _cands = NULL;
 	int* _indices = NULL;
 	int* _statuses = NULL;
 	double* _objs = NULL;
@@ -264,37 +290,37 @@ DSP_RTN_CODE DwWorkerMpi::generateColsByFix(
 
 	TssModel* tss = dynamic_cast<TssModel*>(model_);
 
-	/** memory for solution to evalute */
-	_x = new double [tss->getNumCols(0)];
-
 	if (comm_rank_ == 0) {
 		/** send signal */
 		int sig = sig_generateColsByFix;
 		DSPdebugMessage("Rank %d sends signal %d.\n", comm_rank_, sig);
 		MPI_Bcast(&sig, 1, MPI_INT, 0, comm_);
+	}
+
+	/** The whole batch is sent at once, and each rank evaluates all the candidates for its subproblems. */
+	MPI_Bcast(&ncands, 1, MPI_INT, 0, comm_);
+	_xs = new double [ncands * tss->getNumCols(0)];
+	if (comm_rank_ == 0) {
+		CoinCopyN(xs, ncands * tss->getNumCols(0), _xs);
 
 		recvcounts = new int [comm_size_];
 		displs = new int [comm_size_];
-		_indices = new int [nsubprobs_];
-		_statuses = new int [nsubprobs_];
-		_objs = new double [nsubprobs_];
-
-		CoinCopyN(x, tss->getNumCols(0), _x);
+		_cands = new int [ncands * nsubprobs_];
+		_indices = new int [ncands * nsubprobs_];
+		_statuses = new int [ncands * nsubprobs_];
+		_objs = new double [ncands * nsubprobs_];
 	}
-
-	MPI_Bcast(_x, tss->getNumCols(0), MPI_DOUBLE, 0, comm_);
+	MPI_Bcast(_xs, ncands * tss->getNumCols(0), MPI_DOUBLE, 0, comm_);
 
 	/** actual function to generate columns */
-	if (parProcIdxSize_ > 0)
-	{
-		DSP_RTN_CHECK_RTN_CODE(
-			DwWorker::generateColsByFix(_x, indices, statuses, objs, sols));
-		DSPdebugMessage("Rank %d generated %lu indices, %lu statuses, %lu objs, and %lu sols.\n",
-								comm_rank_, indices.size(), statuses.size(), objs.size(), sols.size());
-	}
+	DSP_RTN_CHECK_RTN_CODE(
+		DwWorker::generateColsByFix(ncands, _xs, cands, indices, statuses, objs, sols));
+	DSPdebugMessage("Rank %d generated %lu indices, %lu statuses, %lu objs, and %lu sols.\n",
+							comm_rank_, indices.size(), statuses.size(), objs.size(), sols.size());
 
-	/** The root rank gathers the number of subproblems for each process. */
-	MPI_Gather(&parProcIdxSize_, 1, MPI_INT, recvcounts, 1, MPI_INT, 0, comm_);
+	/** The root rank gathers the number of results for each process. */
+	nresults = indices.size();
+	MPI_Gather(&nresults, 1, MPI_INT, recvcounts, 1, MPI_INT, 0, comm_);
 
 	/** calculate displacement of the receive buffer */
 	if (comm_rank_ == 0) {
@@ -304,21 +330,27 @@ DSP_RTN_CODE DwWorkerMpi::generateColsByFix(
 	}
 
 	/** synchronize information */
-	MPI_Gatherv(&indices[0], parProcIdxSize_, MPI_INT,
+	MPI_Gatherv(cands.data(), nresults, MPI_INT,
+			_cands, recvcounts, displs, MPI_INT, 0, comm_);
+	MPI_Gatherv(indices.data(), nresults, MPI_INT,
 			_indices, recvcounts, displs, MPI_INT, 0, comm_);
-	MPI_Gatherv(&statuses[0], parProcIdxSize_, MPI_INT,
+	MPI_Gatherv(statuses.data(), nresults, MPI_INT,
 			_statuses, recvcounts, displs, MPI_INT, 0, comm_);
-	MPI_Gatherv(&objs[0], parProcIdxSize_, MPI_DOUBLE,
+	MPI_Gatherv(objs.data(), nresults, MPI_DOUBLE,
 			_objs, recvcounts, displs, MPI_DOUBLE, 0, comm_);
 	MPIgatherCoinPackedVectors(comm_, sols, _sols);
 
 	/** construct output arguments */
 	if (comm_rank_ == 0) {
+		cands.clear();
 		indices.clear();
 		statuses.clear();
 		objs.clear();
+		for (unsigned i = 0; i < sols.size(); ++i)
+			FREE_PTR(sols[i]);
 		sols.clear();
-		for (int i = 0; i < nsubprobs_; ++i) {
+		for (int i = 0; i < ncands * nsubprobs_; ++i) {
+			cands.push_back(_cands[i]);
 			indices.push_back(_indices[i]);
 			statuses.push_back(_statuses[i]);
 			objs.push_back(_objs[i]);
@@ -437,3 +469,188 @@ void DwWorkerMpi::addRow(const CoinPackedVector* vec, double lb, double ub) {
 	FREE_MEMORY
 #undef FREE_MEMORY
 }
+
+DSP_RTN_CODE DwWorkerMpi::rebalance() {
+#define FREE_MEMORY \
+	FREE_2D_PTR(noldprocidx, oldosi) \
+	FREE_2D_ARRAY_PTR(noldprocidx, oldobjs) \
+	FREE_2D_ARRAY_PTR(noldprocidx, oldclbd) \
+	FREE_2D_ARRAY_PTR(noldprocidx, oldcubd) \
+	FREE_2D_ARRAY_PTR(noldprocidx, oldcoupled) \
+	for (unsigned i = 0; i < rows.size(); ++i) { \
+		FREE_PTR(rows[i]); \
+	}
+
+	int nsubs = model_->getNumSubproblems();
+
+	/** subproblems in this rank before rebalancing */
+	int noldprocidx = parProcIdxSize_;
+	std::vector<int> oldprocidx(parProcIdx_, parProcIdx_ + parProcIdxSize_);
+	DspOsi** oldosi = NULL;
+	double** oldobjs = NULL;
+	double** oldclbd = NULL;
+	double** oldcubd = NULL;
+	bool** oldcoupled = NULL;
+	std::vector<std::vector<int>> oldrowids;
+
+	std::vector<CoinPackedVector*> rows;
+
+	BGN_TRY_CATCH
+
+	/** gather the solution times accumulated since the last rebalancing */
+	std::vector<int> counts(comm_size_), displs(comm_size_, 0);
+	MPI_Allgather(&parProcIdxSize_, 1, MPI_INT, counts.data(), 1, MPI_INT, comm_);
+	for (int i = 1; i < comm_size_; ++i)
+		displs[i] = displs[i-1] + counts[i-1];
+	std::vector<int> allidx(nsubs);
+	std::vector<double> alltimes(nsubs);
+	MPI_Allgatherv(oldprocidx.data(), parProcIdxSize_, MPI_INT,
+			allidx.data(), counts.data(), displs.data(), MPI_INT, comm_);
+	MPI_Allgatherv(sub_times_.data(), parProcIdxSize_, MPI_DOUBLE,
+			alltimes.data(), counts.data(), displs.data(), MPI_DOUBLE, comm_);
+	std::fill(sub_times_.begin(), sub_times_.end(), 0.0);
+
+	std::vector<double> times(nsubs, 0.0);
+	std::vector<int> owners(nsubs, -1), newowners;
+	for (int i = 0; i < comm_size_; ++i)
+		for (int k = displs[i]; k < displs[i] + counts[i]; ++k) {
+			times[allidx[k]] = alltimes[k];
+			owners[allidx[k]] = i;
+		}
+
+	/** Every rank computes the same assignment from the same times. */
+	double tol = par_->getDblParam("DW/REBALANCE/TOL");
+	double imbalance = DspLoadImbalance(comm_size_, times, owners);
+	int nmoves = 0;
+	if (imbalance > 1.0 + tol)
+		nmoves = DspLoadAssign(comm_size_, times, owners, tol, newowners);
+	if (nmoves == 0)
+		return DSP_RTN_OK;
+
+	/** new subproblems of this rank */
+	std::vector<int> newprocidx;
+	for (int s = 0; s < nsubs; ++s)
+		if (newowners[s] == comm_rank_)
+			newprocidx.push_back(s);
+	int nnew = newprocidx.size();
+
+	/** swap in the new arrays; the subproblems kept in this rank are moved over */
+	oldosi = osi_;
+	oldobjs = sub_objs_;
+	oldclbd = sub_clbd_;
+	oldcubd = sub_cubd_;
+	oldcoupled = coupled_;
+	oldrowids.swap(added_rowids_);
+	osi_ = NULL;
+	sub_objs_ = NULL;
+	sub_clbd_ = NULL;
+	sub_cubd_ = NULL;
+	coupled_ = NULL;
+	if (nnew > 0) {
+		osi_ = new DspOsi* [nnew];
+		sub_objs_ = new double* [nnew];
+		sub_clbd_ = new double* [nnew];
+		sub_cubd_ = new double* [nnew];
+		coupled_ = new bool* [nnew];
+	}
+	added_rowids_.resize(nnew);
+	for (int t = 0; t < nnew; ++t) {
+		osi_[t] = NULL;
+		sub_objs_[t] = NULL;
+		sub_clbd_[t] = NULL;
+		sub_cubd_[t] = NULL;
+		coupled_[t] = NULL;
+		int s = std::find(oldprocidx.begin(), oldprocidx.end(), newprocidx[t]) - oldprocidx.begin();
+		if (s < noldprocidx) {
+			osi_[t] = oldosi[s];
+			sub_objs_[t] = oldobjs[s];
+			sub_clbd_[t] = oldclbd[s];
+			sub_cubd_[t] = oldcubd[s];
+			coupled_[t] = oldcoupled[s];
+			added_rowids_[t] = oldrowids[s];
+			oldosi[s] = NULL;
+			oldobjs[s] = NULL;
+			oldclbd[s] = NULL;
+			oldcubd[s] = NULL;
+			oldcoupled[s] = NULL;
+		}
+	}
+
+	/** set parameters */
+	par_->setIntPtrParamSize("ARR_PROC_IDX", nnew);
+	for (int t = 0; t < nnew; ++t)
+		par_->setIntPtrParam("ARR_PROC_IDX", t, newprocidx[t]);
+	parProcIdxSize_ = nnew;
+	parProcIdx_ = par_->getIntPtrParam("ARR_PROC_IDX");
+	num_timelim_stops_.assign(nnew, 0);
+	sub_times_.assign(nnew, 0.0);
+
+	/**
+	 * The moving subproblems are processed in the same order by all the ranks,
+	 * so that the blocking sends and receives are matched.
+	 */
+	for (int sind = 0; sind < nsubs; ++sind) {
+		if (owners[sind] == newowners[sind])
+			continue;
+		if (owners[sind] == comm_rank_) {
+			int s = std::find(oldprocidx.begin(), oldprocidx.end(), sind) - oldprocidx.begin();
+			OsiSolverInterface* si = oldosi[s]->si_;
+			int ncols = si->getNumCols();
+			int nrows = oldrowids[s].size();
+
+			/** send the column bounds and the rows added for branching */
+			std::vector<double> buf(2 * ncols + 2 * nrows);
+			CoinCopyN(oldclbd[s], ncols, &buf[0]);
+			CoinCopyN(oldcubd[s], ncols, &buf[ncols]);
+			for (int i = 0; i < nrows; ++i) {
+				int r = oldrowids[s][i];
+				const CoinShallowPackedVector row = si->getMatrixByRow()->getVector(r);
+				rows.push_back(new CoinPackedVector(row.getNumElements(), row.getIndices(), row.getElements()));
+				buf[2 * ncols + i] = si->getRowLower()[r];
+				buf[2 * ncols + nrows + i] = si->getRowUpper()[r];
+			}
+			DSP_RTN_CHECK_THROW(MPIsendCoinPackedVectors(comm_, newowners[sind], rows, DSP_MPI_TAG_MIGRATE));
+			MPI_Send(buf.data(), buf.size(), MPI_DOUBLE, newowners[sind], DSP_MPI_TAG_MIGRATE, comm_);
+			for (unsigned i = 0; i < rows.size(); ++i)
+				FREE_PTR(rows[i]);
+			rows.clear();
+		} else if (newowners[sind] == comm_rank_) {
+			int t = std::find(newprocidx.begin(), newprocidx.end(), sind) - newprocidx.begin();
+
+			/** create the subproblem from the model */
+			osi_[t] = createDspOsi();
+			setCoupledColumns(t);
+			DSP_RTN_CHECK_THROW(createSubproblem(t));
+			OsiSolverInterface* si = osi_[t]->si_;
+			int ncols = si->getNumCols();
+
+			/** receive the column bounds and the rows added for branching */
+			DSP_RTN_CHECK_THROW(MPIrecvCoinPackedVectors(comm_, owners[sind], rows, DSP_MPI_TAG_MIGRATE));
+			int nrows = rows.size();
+			std::vector<double> buf(2 * ncols + 2 * nrows);
+			MPI_Recv(buf.data(), buf.size(), MPI_DOUBLE, owners[sind], DSP_MPI_TAG_MIGRATE, comm_, MPI_STATUS_IGNORE);
+			CoinCopyN(&buf[0], ncols, sub_clbd_[t]);
+			CoinCopyN(&buf[ncols], ncols, sub_cubd_[t]);
+			for (int j = 0; j < ncols; ++j)
+				si->setColBounds(j, sub_clbd_[t][j], sub_cubd_[t][j]);
+			for (int i = 0; i < nrows; ++i) {
+				si->addRow(*rows[i], buf[2 * ncols + i], buf[2 * ncols + nrows + i]);
+				added_rowids_[t].push_back(si->getNumRows() - 1);
+			}
+			for (unsigned i = 0; i < rows.size(); ++i)
+				FREE_PTR(rows[i]);
+			rows.clear();
+		}
+	}
+
+	if (comm_rank_ == 0)
+		message_->print(1, "Rebalanced subproblems: %d moved, load imbalance %.2f -> %.2f\n",
+				nmoves, imbalance, DspLoadImbalance(comm_size_, times, newowners));
+
+	END_TRY_CATCH_RTN(FREE_MEMORY,DSP_RTN_ERR)
+
+	FREE_MEMORY
+
+	return DSP_RTN_OK;
+#undef FREE_MEMORY
+}
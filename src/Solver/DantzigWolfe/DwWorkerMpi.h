@@ -34,9 +34,13 @@ public:
 			std::vector<double>& objs,           /**< [out] subproblem objective values */
 			std::vector<CoinPackedVector*>& sols /**< [out] subproblem coupling column solutions */);
 
-	/** generate variables by fixing some of the varialbes (e.g., upper bounding for SMIP) */
+	using DwWorker::generateColsByFix;
+
+	/** generate variables by fixing each of the given solutions (e.g., upper bounding for SMIP) */
 	virtual DSP_RTN_CODE generateColsByFix(
-			const double* x,                     /**< [in] solution to fix */
+			int ncands,                          /**< [in] number of solutions to fix */
+			const double* xs,                    /**< [in] solutions to fix (ncands by number of first-stage columns) */
+			std::vector<int>& cands,             /**< [out] candidate indices */
 			std::vector<int>& indices,           /**< [out] subproblem indices */
 			std::vector<int>& statuses,          /**< [out] solution status */
 			std::vector<double>& objs,           /**< [out] subproblem objective values */
@@ -67,6 +71,15 @@ public:
 
 protected:
 
+	/**
+	 * This reassigns the subproblems to the ranks by the solution times measured since
+	 * the last call, if the load imbalance exceeds DW/REBALANCE/TOL. A subproblem moved
+	 * to another rank is created there from the model, and its column bounds and the rows
+	 * added for branching are sent from the previous rank. This is called by all the ranks
+	 * at the end of every DW/REBALANCE/FREQ calls of generateCols.
+	 */
+	virtual DSP_RTN_CODE rebalance();
+
 	MPI_Comm comm_;
 	int comm_rank_;
 	int comm_size_;
@@ -74,6 +87,9 @@ protected:
 	int npiA_; /**< size of piA vector */
 	double* piA_; /**< local piA vector */
 	int resetTimeIncrement_;
+
+	int ngenerated_;        /**< number of calls to generate columns */
+	int parRebalanceFreq_;  /**< number of column generations between rebalancing (0 to disable) */
 };
 
 #endif /* SRC_SOLVER_DANTZIGWOLFE_DWWORKERMPI_H_ */
@@ -32,6 +32,8 @@ numIterations_(0),
 numNodes_(0),
 iterlim_(COIN_INT_MAX) {
 	message_->logLevel_ = par_->getIntParam("LOG_LEVEL");
+	message_->setPrefix(par_->getBoolParam("LOG_PREFIX"));
+	message_->setAsync(par_->getBoolParam("LOG_ASYNC"));
 }
 
 DecSolver::DecSolver(const DecSolver&rhs) :
@@ -5,21 +5,28 @@
  *      Author: kibaekkim
  */
 
+#include <cmath>
 #include "DspConfig.h"
-#include "Model/TssModel.h"
+#include "Model/DecTssModel.h"
 #include "Solver/Deterministic/DeDriver.h"
 #include "SolverInterface/DspOsiCpx.h"
 #include "SolverInterface/DspOsiGrb.h"
 #include "SolverInterface/DspOsiScip.h"
+#include "Utility/DspScenarioReduction.h"
 
 DeDriver::DeDriver(
 		DecModel *   model,  /**< model pointer */
 		DspParams *  par,    /**< parameters */
 		DspMessage * message /**< message pointer */):
-DecSolver(model,par,message) {}
+DecSolver(model,par,message),
+pre_offset_(0.0) {}
 
 DeDriver::DeDriver(const DeDriver& rhs) :
-DecSolver(rhs) {}
+DecSolver(rhs),
+scen_rep_(rhs.scen_rep_),
+pre_cols_(rhs.pre_cols_),
+pre_sol_(rhs.pre_sol_),
+pre_offset_(rhs.pre_offset_) {}
 
 DeDriver::~DeDriver()
 {}
@@ -66,7 +73,11 @@ DSP_RTN_CODE DeDriver::run()
 	BGN_TRY_CATCH
 
 	/** get DE model */
-	DSP_RTN_CHECK_THROW(model_->getFullModel(mat, clbd, cubd, ctype, obj, rlbd, rubd));
+	if (model_->isStochastic() &&
+		(par_->getBoolParam("DE/PRESOLVE") || par_->getIntParam("DE/REDUCE/NSCEN") > 0))
+		DSP_RTN_CHECK_THROW(getReducedModel(mat, clbd, cubd, ctype, obj, rlbd, rubd));
+	else
+		DSP_RTN_CHECK_THROW(model_->getFullModel(mat, clbd, cubd, ctype, obj, rlbd, rubd));
 
 	if (model_->isStochastic())
 	{
@@ -91,7 +102,7 @@ DSP_RTN_CODE DeDriver::run()
 		}
 		if (par_->getBoolPtrParam("RELAX_INTEGRALITY")[1])
 		{
-			CoinFillN(ctype + tssModel->getNumCols(0), tssModel->getNumScenarios() * tssModel->getNumCols(1), 'C');
+			CoinFillN(ctype + tssModel->getNumCols(0), mat->getNumCols() - tssModel->getNumCols(0), 'C');
 		}
 	}
 	else
@@ -108,6 +119,10 @@ DSP_RTN_CODE DeDriver::run()
 		}
 	}
 
+	/** presolve */
+	if (par_->getBoolParam("DE/PRESOLVE"))
+		DSP_RTN_CHECK_THROW(presolve(mat, clbd, cubd, ctype, obj, rlbd, rubd));
+
 	/** create DspOsi */
 	osi_ = createDspOsi();
 	if (!osi_) throw CoinError("Failed to create DspOsi", "run", "DeDriver");
@@ -156,8 +171,8 @@ DSP_RTN_CODE DeDriver::run()
 	   	status_ == DSP_STAT_LIM_ITERorTIME)
 	{
 		/** objective bounds */
-		bestprimobj_ = osi_->getPrimObjValue();
-		bestdualobj_ = osi_->getDualObjValue();
+		bestprimobj_ = osi_->getPrimObjValue() + pre_offset_;
+		bestdualobj_ = osi_->getDualObjValue() + pre_offset_;
 
 		/** solution */
 		if (osi_->si_->getColSolution())
@@ -165,10 +180,8 @@ DSP_RTN_CODE DeDriver::run()
 			DSPdebugMessage("bestprimsol_=\n");
 			// DspMessage::printArray(osi_->si_->getNumCols(), osi_->si_->getColSolution());
 			
-			// make sure that the solution vector has enough space.
-			if (primsol_.size() < osi_->si_->getNumCols())
-				primsol_.resize(osi_->si_->getNumCols());
-			CoinCopyN(osi_->si_->getColSolution(), osi_->si_->getNumCols(), &primsol_[0]);
+			/** solution of the full extensive form */
+			postsolve(osi_->si_->getColSolution(), primsol_);
 			bestprimsol_ = primsol_;
 		}
 
@@ -197,6 +210,256 @@ DSP_RTN_CODE DeDriver::finalize() {
 	return DSP_RTN_OK;
 }
 
+DSP_RTN_CODE DeDriver::getReducedModel(
+		CoinPackedMatrix *& mat,
+		double *& clbd,
+		double *& cubd,
+		char   *& ctype,
+		double *& obj,
+		double *& rlbd,
+		double *& rubd)
+{
+	BGN_TRY_CATCH
+
+	DecTssModel * tss = dynamic_cast<DecTssModel *>(model_);
+	if (!tss) throw CoinError("Scenario reduction requires a stochastic model", "getReducedModel", "DeDriver");
+
+	int nscen = tss->getNumScenarios();
+	std::vector<double> prob(tss->getProbability(), tss->getProbability() + nscen);
+
+	/** merge the identical scenarios, compared by their exact data */
+	std::vector<int> rep(nscen);
+	CoinIotaN(&rep[0], nscen, 0);
+	if (par_->getBoolParam("DE/PRESOLVE"))
+	{
+		std::vector<std::vector<double> > data(nscen);
+		for (int s = 0; s < nscen; ++s)
+			DSP_RTN_CHECK_THROW(tss->getScenarioData(s, data[s], true));
+		int ndistinct = DspMergeIdenticalScenarios(data, rep);
+		message_->print(1, "[DE] Merged %d identical scenarios.\n", nscen - ndistinct);
+	}
+
+	/** distinct scenarios with the merged probabilities */
+	std::vector<int> distinct;
+	std::vector<int> index(nscen, -1);
+	for (int s = 0; s < nscen; ++s)
+		if (rep[s] == s)
+		{
+			index[s] = distinct.size();
+			distinct.push_back(s);
+		}
+	int ndistinct = distinct.size();
+	std::vector<double> dprob(ndistinct, 0.0);
+	for (int s = 0; s < nscen; ++s)
+		dprob[index[rep[s]]] += prob[s];
+
+	/** forward selection on the distinct scenarios */
+	std::vector<int> selected(ndistinct);
+	CoinIotaN(&selected[0], ndistinct, 0);
+	int nselect = par_->getIntParam("DE/REDUCE/NSCEN");
+	if (nselect > 0 && nselect < ndistinct)
+	{
+		std::vector<std::vector<double> > data(ndistinct);
+		for (int k = 0; k < ndistinct; ++k)
+			DSP_RTN_CHECK_THROW(tss->getScenarioData(distinct[k], data[k]));
+		/** Euclidean distance of the scenario data */
+		std::function<double(int,int)> distance = [&data](int k, int l) {
+			double d = 0.0;
+			for (unsigned i = 0; i < data[k].size(); ++i)
+				d += (data[k][i] - data[l][i]) * (data[k][i] - data[l][i]);
+			return sqrt(d);
+		};
+		double dist = DspForwardSelection(nselect, ndistinct, distance, dprob, selected);
+		/** The objective error is bounded by dist times the Lipschitz constant of the recourse function in the scenario data. */
+		message_->print(1, "[DE] Selected %d of %d scenarios (Kantorovich distance %e).\n", nselect, ndistinct, dist);
+	}
+
+	/** reduced scenarios and their probabilities */
+	std::vector<int> kept;
+	std::vector<int> position(ndistinct, -1);
+	std::vector<double> reduced_prob(nscen, 0.0);
+	for (int k = 0; k < ndistinct; ++k)
+		if (selected[k] == k)
+		{
+			position[k] = kept.size();
+			kept.push_back(distinct[k]);
+		}
+	for (int k = 0; k < ndistinct; ++k)
+		reduced_prob[distinct[selected[k]]] += dprob[k];
+	scen_rep_.resize(nscen);
+	for (int s = 0; s < nscen; ++s)
+		scen_rep_[s] = position[selected[index[rep[s]]]];
+
+	/** extensive form weighted by the reduced probabilities */
+	tss->setProbability(&reduced_prob[0]);
+	DSP_RTN_CODE rtn = tss->decompose(kept.size(), &kept[0], 0, NULL, NULL, NULL,
+			mat, clbd, cubd, ctype, obj, rlbd, rubd);
+	tss->setProbability(&prob[0]);
+	DSP_RTN_CHECK_THROW(rtn);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DeDriver::presolve(
+		CoinPackedMatrix *& mat,
+		double *& clbd,
+		double *& cubd,
+		char   *& ctype,
+		double *& obj,
+		double *& rlbd,
+		double *& rubd)
+{
+	const double tol = 1.0e-9;
+
+	BGN_TRY_CATCH
+
+	int ncols = mat->getNumCols();
+	int nrows = mat->getNumRows();
+	std::vector<bool> colkept(ncols, true);
+	std::vector<bool> rowkept(nrows, true);
+	pre_sol_.assign(ncols, 0.0);
+	pre_offset_ = 0.0;
+
+	/** fixed columns */
+	for (int j = 0; j < ncols; ++j)
+		if (clbd[j] == cubd[j])
+		{
+			colkept[j] = false;
+			pre_sol_[j] = clbd[j];
+			pre_offset_ += obj[j] * clbd[j];
+		}
+
+	/** shift the row bounds by the fixed columns, and remove the rows of which
+	 * activities are within the bounds for any values of the other columns */
+	CoinPackedMatrix rowmat;
+	if (mat->isColOrdered())
+		rowmat.reverseOrderedCopyOf(*mat);
+	else
+		rowmat = *mat;
+	std::vector<int> colcount(ncols, 0);
+	for (int i = 0; i < nrows; ++i)
+	{
+		CoinBigIndex start = rowmat.getVectorStarts()[i];
+		int length = rowmat.getVectorSize(i);
+		double minact = 0.0, maxact = 0.0;
+		int ninfmin = 0, ninfmax = 0;
+		for (int k = 0; k < length; ++k)
+		{
+			int j = rowmat.getIndices()[start + k];
+			double a = rowmat.getElements()[start + k];
+			if (colkept[j] == false)
+			{
+				if (rlbd[i] > -COIN_DBL_MAX) rlbd[i] -= a * pre_sol_[j];
+				if (rubd[i] < COIN_DBL_MAX) rubd[i] -= a * pre_sol_[j];
+				continue;
+			}
+			double lo = a > 0 ? clbd[j] : cubd[j];
+			double up = a > 0 ? cubd[j] : clbd[j];
+			if (fabs(lo) >= 1.0e+20) ninfmin++; else minact += a * lo;
+			if (fabs(up) >= 1.0e+20) ninfmax++; else maxact += a * up;
+		}
+		bool lower_ok = rlbd[i] <= -1.0e+20 || (ninfmin == 0 && minact >= rlbd[i] - tol * (1.0 + fabs(rlbd[i])));
+		bool upper_ok = rubd[i] >= 1.0e+20 || (ninfmax == 0 && maxact <= rubd[i] + tol * (1.0 + fabs(rubd[i])));
+		if (lower_ok && upper_ok)
+			rowkept[i] = false;
+		else
+			for (int k = 0; k < length; ++k)
+				colcount[rowmat.getIndices()[start + k]]++;
+	}
+
+	/** empty columns at their best bounds */
+	for (int j = 0; j < ncols; ++j)
+	{
+		if (colkept[j] == false || colcount[j] > 0) continue;
+		double val;
+		if (obj[j] > 0 && clbd[j] > -1.0e+20)
+			val = clbd[j];
+		else if (obj[j] < 0 && cubd[j] < 1.0e+20)
+			val = cubd[j];
+		else if (obj[j] == 0)
+			val = clbd[j] > -1.0e+20 ? clbd[j] : (cubd[j] < 1.0e+20 ? cubd[j] : 0.0);
+		else
+			continue; /**< unbounded; left to the solver */
+		colkept[j] = false;
+		pre_sol_[j] = val;
+		pre_offset_ += obj[j] * val;
+	}
+
+	/** delete the columns and rows */
+	std::vector<int> delcols, delrows;
+	pre_cols_.clear();
+	for (int j = 0; j < ncols; ++j)
+	{
+		if (colkept[j])
+		{
+			clbd[pre_cols_.size()] = clbd[j];
+			cubd[pre_cols_.size()] = cubd[j];
+			ctype[pre_cols_.size()] = ctype[j];
+			obj[pre_cols_.size()] = obj[j];
+			pre_cols_.push_back(j);
+		}
+		else
+			delcols.push_back(j);
+	}
+	int nkept = 0;
+	for (int i = 0; i < nrows; ++i)
+	{
+		if (rowkept[i])
+		{
+			rlbd[nkept] = rlbd[i];
+			rubd[nkept] = rubd[i];
+			nkept++;
+		}
+		else
+			delrows.push_back(i);
+	}
+	if (delcols.size() > 0)
+		mat->deleteCols(delcols.size(), &delcols[0]);
+	if (delrows.size() > 0)
+		mat->deleteRows(delrows.size(), &delrows[0]);
+
+	message_->print(1, "[DE] Presolve removed %d columns and %d rows.\n", (int) delcols.size(), (int) delrows.size());
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+void DeDriver::postsolve(const double * x, std::vector<double> & sol)
+{
+	/** solution before presolve */
+	std::vector<double> xred;
+	if (pre_sol_.size() > 0)
+	{
+		xred = pre_sol_;
+		for (unsigned k = 0; k < pre_cols_.size(); ++k)
+			xred[pre_cols_[k]] = x[k];
+	}
+	else
+		xred.assign(x, x + osi_->si_->getNumCols());
+
+	/** scenario blocks of the representing scenarios */
+	if (scen_rep_.size() > 0)
+	{
+		TssModel * tss = dynamic_cast<TssModel *>(model_);
+		int ncols0 = tss->getNumCols(0);
+		int ncols1 = tss->getNumCols(1);
+		sol.resize(ncols0 + scen_rep_.size() * ncols1);
+		CoinCopyN(&xred[0], ncols0, &sol[0]);
+		for (unsigned s = 0; s < scen_rep_.size(); ++s)
+			CoinCopyN(&xred[ncols0 + scen_rep_[s] * ncols1], ncols1, &sol[ncols0 + s * ncols1]);
+	}
+	else
+	{
+		/** make sure that the solution vector has enough space. */
+		if (sol.size() < xred.size())
+			sol.resize(xred.size());
+		CoinCopyN(&xred[0], xred.size(), &sol[0]);
+	}
+}
+
 void DeDriver::writeExtMps(const char * name)
 {
 #define FREE_MEMORY       \
@@ -49,6 +49,37 @@ public:
 private:
 
 	virtual DspOsi * createDspOsi();
+
+	/** Get the extensive form on the scenarios reduced by merging the identical scenarios
+	 * and/or forward selection, where each scenario takes the probabilities of the
+	 * scenarios it represents. */
+	DSP_RTN_CODE getReducedModel(
+			CoinPackedMatrix *& mat, /**< [out] constraint matrix */
+			double *& clbd,          /**< [out] column lower bounds */
+			double *& cubd,          /**< [out] column upper bounds */
+			char   *& ctype,         /**< [out] column types */
+			double *& obj,           /**< [out] objective coefficients */
+			double *& rlbd,          /**< [out] row lower bounds */
+			double *& rubd           /**< [out] row upper bounds */);
+
+	/** Remove the fixed columns, the rows made redundant by the column bounds, and then
+	 * the columns left empty, which are set to their best bounds. */
+	DSP_RTN_CODE presolve(
+			CoinPackedMatrix *& mat, /**< [in/out] constraint matrix */
+			double *& clbd,          /**< [in/out] column lower bounds */
+			double *& cubd,          /**< [in/out] column upper bounds */
+			char   *& ctype,         /**< [in/out] column types */
+			double *& obj,           /**< [in/out] objective coefficients */
+			double *& rlbd,          /**< [in/out] row lower bounds */
+			double *& rubd           /**< [in/out] row upper bounds */);
+
+	/** Recover the solution of the full extensive form from the solution of the reduced one. */
+	void postsolve(const double * x, std::vector<double> & sol);
+
+	std::vector<int> scen_rep_;   /**< reduced scenario representing each scenario (empty if not reduced) */
+	std::vector<int> pre_cols_;   /**< columns kept by presolve (empty if not presolved) */
+	std::vector<double> pre_sol_; /**< values of the columns removed by presolve */
+	double pre_offset_;           /**< objective value of the columns removed by presolve */
 };
 
 #endif /* SRC_SOLVER_DETERMINISTIC_DEDRIVER_H_ */
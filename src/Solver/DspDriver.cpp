@@ -16,6 +16,8 @@ DspDriver::DspDriver(DspParams * par, DecModel * model):
 {
 	/** create message */
 	message_ = new DspMessage(par_->getIntParam("LOG_LEVEL"));
+	message_->setPrefix(par_->getBoolParam("LOG_PREFIX"));
+	message_->setAsync(par_->getBoolParam("LOG_ASYNC"));
 }
 
 DspDriver::~DspDriver()
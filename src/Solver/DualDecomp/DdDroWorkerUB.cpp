@@ -4,6 +4,8 @@
 #include "SolverInterface/DspOsiCpx.h"
 #include "SolverInterface/DspOsiGrb.h"
 #include "SolverInterface/DspOsiScip.h"
+#include <thread>
+#include <atomic>
 
 #ifdef DSP_HAS_SCIP
 #include "Solver/DualDecomp/SCIPconshdlrBendersDd.h"
@@ -12,6 +14,7 @@
 DdDroWorkerUB::DdDroWorkerUB(const DdDroWorkerUB &rhs) : DdWorkerUB(rhs)
 {
 	osi_dro_ = rhs.osi_dro_->clone();
+	dro_row_start_ = rhs.dro_row_start_;
 }
 
 DdDroWorkerUB::~DdDroWorkerUB()
@@ -77,15 +80,20 @@ DSP_RTN_CODE DdDroWorkerUB::createProblem()
 	}
 
 	/** create DRO upper bounding problem */
+	/** one row for each transport pair kept in the (sparsified) ambiguity set */
 	int ncols_dro = 1 + model_->getNumReferences();
-	int nrows_dro = model_->getNumReferences() * tss->getNumScenarios();
+	int nrows_dro = model_->getNumWassersteinPairs();
 	int nzcnt_dro = 0;
+	dro_row_start_.resize(tss->getNumScenarios() + 1);
+	dro_row_start_[0] = 0;
 	for (int k = 0; k < tss->getNumScenarios(); ++k)
 	{
-		for (int s = 0; s < model_->getNumReferences(); ++s)
+		const CoinPackedVector *pairs = model_->getWassersteinPairs(k);
+		dro_row_start_[k + 1] = dro_row_start_[k] + pairs->getNumElements();
+		for (int s = 0; s < pairs->getNumElements(); ++s)
 		{
 			// alpha
-			if (model_->getWassersteinDist(s, k) > 0)
+			if (pairs->getElements()[s] > 0)
 				nzcnt_dro++;
 
 			// beta_s
@@ -122,17 +130,19 @@ DSP_RTN_CODE DdDroWorkerUB::createProblem()
 	int rnum = 0;
 	for (int k = 0; k < tss->getNumScenarios(); ++k)
 	{
-		for (int s = 0; s < model_->getNumReferences(); ++s)
+		const CoinPackedVector *pairs = model_->getWassersteinPairs(k);
+		for (int p = 0; p < pairs->getNumElements(); ++p)
 		{
-			rnum = k * model_->getNumReferences() + s;
+			int s = pairs->getIndices()[p];
+			rnum = dro_row_start_[k] + p;
 
 			bgn_dro[rnum] = pos_dro;
 
 			// alpha
-			if (model_->getWassersteinDist(s, k) > 0)
+			if (pairs->getElements()[p] > 0)
 			{
 				ind_dro[pos_dro] = 0;
-				elem_dro[pos_dro] = model_->getWassersteinDist(s, k);
+				elem_dro[pos_dro] = pairs->getElements()[p];
 				pos_dro++;
 			}
 
@@ -208,7 +218,6 @@ DSP_RTN_CODE DdDroWorkerUB::solve()
 {
 	double cputime;
 	double walltime;
-	char lpfilename[128];
 
 	BGN_TRY_CATCH
 
@@ -218,57 +227,22 @@ DSP_RTN_CODE DdDroWorkerUB::solve()
 	double total_walltime = 0.0;
 	int nsubprobs = par_->getIntPtrParamSize("ARR_PROC_IDX");
 
-	for (unsigned s = 0; s < nsubprobs; ++s)
-	{
-		cputime = CoinCpuTime();
-		walltime = CoinGetTimeOfDay();
-
-		/** set time limit */
-		osi_[s]->setTimeLimit(
-			CoinMin(CoinMax(0.01, time_remains_),
-					par_->getDblParam("DD/SUB/TIME_LIM")));
-
-#ifdef DSP_DEBUG
-		/* write in lp file to see whether the quadratic rows are successfully added to the model or not */
-		sprintf(lpfilename, "DdDroWorkerUB_scen%d.lp", s);
-		osi_[s]->writeProb(lpfilename, NULL);
-#endif
-
-		/** solve */
-		osi_[s]->solve();
+	cputime = CoinCpuTime();
+	walltime = CoinGetTimeOfDay();
 
-		/** check status. there might be unexpected results. */
-		int status = osi_[s]->status();
-		DSPdebugMessage("status = %d\n", status);
-		switch (status)
-		{
-		case DSP_STAT_OPTIMAL:
-		case DSP_STAT_LIM_ITERorTIME:
-		case DSP_STAT_STOPPED_GAP:
-		case DSP_STAT_STOPPED_NODE:
-		case DSP_STAT_STOPPED_TIME:
-			break;
-		default:
-			status_ = DSP_STAT_MW_STOP;
-			message_->print(10,
-							"Warning: subproblem %d solution status is %d\n", s,
-							status);
-			break;
-		}
-		if (status_ == DSP_STAT_MW_STOP)
-		{
-			primobj = COIN_DBL_MAX;
-			dualobj = -COIN_DBL_MAX;
-			break;
-		}
+	/** solve the scenario subproblems */
+	DSP_RTN_CHECK_THROW(solveSubproblems());
+	if (status_ == DSP_STAT_MW_STOP)
+	{
+		primobj = COIN_DBL_MAX;
+		dualobj = -COIN_DBL_MAX;
+	}
 
-		CoinCopyN(osi_[s]->si_->getColSolution(), osi_[s]->si_->getNumCols(), &primsols_[s][0]);
-		total_cputime += CoinCpuTime() - cputime;
-		total_walltime += CoinGetTimeOfDay() - walltime;
+	total_cputime += CoinCpuTime() - cputime;
+	total_walltime += CoinGetTimeOfDay() - walltime;
 
-		/** consume time */
-		time_remains_ -= CoinGetTimeOfDay() - walltime;
-	}
+	/** consume time */
+	time_remains_ -= CoinGetTimeOfDay() - walltime;
 
 	cputime = CoinCpuTime();
 	walltime = CoinGetTimeOfDay();
@@ -279,10 +253,10 @@ DSP_RTN_CODE DdDroWorkerUB::solve()
 		assert(nsubprobs == model_->getNumSubproblems());
 		for (int k = 0; k < nsubprobs; ++k)
 		{
-			// printf("rlbd[%d] = %e\n", k * model_->getNumReferences(), osi_[k]->si_->getObjValue());
-			for (int s = 0; s < model_->getNumReferences(); ++s)
+			// printf("rlbd[%d] = %e\n", dro_row_start_[k], osi_[k]->si_->getObjValue());
+			for (int r = dro_row_start_[k]; r < dro_row_start_[k + 1]; ++r)
 			{
-				osi_dro_->si_->setRowLower(k * model_->getNumReferences() + s, osi_[k]->si_->getObjValue());
+				osi_dro_->si_->setRowLower(r, osi_[k]->si_->getObjValue());
 			}
 		}
 		osi_dro_->solve();
@@ -325,3 +299,102 @@ DSP_RTN_CODE DdDroWorkerUB::solve()
 
 	return DSP_RTN_OK;
 }
+
+DSP_RTN_CODE DdDroWorkerUB::solveSubproblems()
+{
+	BGN_TRY_CATCH
+
+	int nsubprobs = par_->getIntPtrParamSize("ARR_PROC_IDX");
+	const int *proc_idx = par_->getIntPtrParam("ARR_PROC_IDX");
+	double time_lim = par_->getDblParam("DD/SUB/TIME_LIM");
+	double time_remains = time_remains_;
+	double walltime = CoinGetTimeOfDay();
+
+	/** A solver instance is not shared by threads, so the threads split the subproblems. */
+	int nthreads = CoinMax(1, CoinMin(par_->getIntParam("DD/UB/THREADS"), nsubprobs));
+	std::vector<int> statuses(nsubprobs, DSP_STAT_UNKNOWN);
+	std::vector<DSP_RTN_CODE> rtns(nthreads, DSP_RTN_OK);
+	std::atomic<bool> stop(false);
+	auto solveSubproblem = [&](int t) {
+		try
+		{
+			for (int s = t; s < nsubprobs && !stop; s += nthreads)
+			{
+				/** set time limit */
+				osi_[s]->setTimeLimit(
+					CoinMin(CoinMax(0.01, time_remains - (CoinGetTimeOfDay() - walltime)), time_lim));
+
+#ifdef DSP_DEBUG
+				/* write in lp file to see whether the quadratic rows are successfully added to the model or not */
+				char lpfilename[128];
+				sprintf(lpfilename, "DdDroWorkerUB_scen%d.lp", proc_idx[s]);
+				osi_[s]->writeProb(lpfilename, NULL);
+#endif
+
+				/** solve */
+				osi_[s]->solve();
+
+				/** The remaining subproblems are skipped once any of them is not solved. */
+				statuses[s] = osi_[s]->status();
+				switch (statuses[s])
+				{
+				case DSP_STAT_OPTIMAL:
+				case DSP_STAT_LIM_ITERorTIME:
+				case DSP_STAT_STOPPED_GAP:
+				case DSP_STAT_STOPPED_NODE:
+				case DSP_STAT_STOPPED_TIME:
+					CoinCopyN(osi_[s]->si_->getColSolution(), osi_[s]->si_->getNumCols(), &primsols_[s][0]);
+					break;
+				default:
+					stop = true;
+					break;
+				}
+			}
+		}
+		catch (...)
+		{
+			rtns[t] = DSP_RTN_ERR;
+			stop = true;
+		}
+	};
+	if (nthreads == 1)
+		solveSubproblem(0);
+	else
+	{
+		std::vector<std::thread> threads;
+		for (int t = 0; t < nthreads; ++t)
+			threads.push_back(std::thread(solveSubproblem, t));
+		for (int t = 0; t < nthreads; ++t)
+			threads[t].join();
+	}
+
+	for (int t = 0; t < nthreads; ++t)
+		if (rtns[t] != DSP_RTN_OK)
+			return rtns[t];
+
+	/** check status. there might be unexpected results. */
+	for (int s = 0; s < nsubprobs; ++s)
+	{
+		DSPdebugMessage("sind %d, status %d\n", proc_idx[s], statuses[s]);
+		switch (statuses[s])
+		{
+		case DSP_STAT_UNKNOWN: /**< skipped */
+		case DSP_STAT_OPTIMAL:
+		case DSP_STAT_LIM_ITERorTIME:
+		case DSP_STAT_STOPPED_GAP:
+		case DSP_STAT_STOPPED_NODE:
+		case DSP_STAT_STOPPED_TIME:
+			break;
+		default:
+			status_ = DSP_STAT_MW_STOP;
+			message_->print(10,
+							"Warning: subproblem %d solution status is %d\n", s,
+							statuses[s]);
+			break;
+		}
+	}
+
+	END_TRY_CATCH_RTN(;, DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
@@ -49,8 +49,13 @@ protected:
 
 	/** Set the objective function for each subproblem */
 	virtual DSP_RTN_CODE setObjective();
+
+	/** Solve the scenario subproblems of this worker concurrently over DD/UB/THREADS
+	 *  threads, and set status_ to DSP_STAT_MW_STOP if any of them is not solved. */
+	virtual DSP_RTN_CODE solveSubproblems();
 	
 	DspOsi *osi_dro_; /**< solver interface for DRO upper bound */
+	std::vector<int> dro_row_start_; /**< index of the first DRO row of each scenario */
 };
 
 #endif /* SRC_SOLVER_DUALDECOMP_DDDROWORKERUB_H_ */
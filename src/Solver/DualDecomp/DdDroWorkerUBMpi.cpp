@@ -67,59 +67,22 @@ DSP_RTN_CODE DdDroWorkerUBMpi::solve()
 	int nsubprobs = par_->getIntPtrParamSize("ARR_PROC_IDX");
 	statuses = new int[comm_size_];
 
-	for (unsigned s = 0; s < nsubprobs; ++s)
-	{
-		cputime = CoinCpuTime();
-		walltime = CoinGetTimeOfDay();
-
-		/** set time limit */
-		osi_[s]->setTimeLimit(
-			CoinMin(CoinMax(0.01, time_remains_),
-					par_->getDblParam("DD/SUB/TIME_LIM")));
-
-#ifdef DSP_DEBUG
-		/* write in lp file to see whether the quadratic rows are successfully added to the model or not */
-		sprintf(lpfilename, "DdDroWorkerUBMpi_scen%d.lp", par_->getIntPtrParam("ARR_PROC_IDX")[s]);
-		osi_[s]->writeProb(lpfilename, NULL);
-#endif
-
-		/** solve */
-		osi_[s]->solve();
-
-		/** check status. there might be unexpected results. */
-		int status = osi_[s]->status();
-		DSPdebugMessage("Rank %d: sind %d, status %d\n", comm_rank_, par_->getIntPtrParam("ARR_PROC_IDX")[s], status);
-		switch (status)
-		{
-		case DSP_STAT_OPTIMAL:
-		case DSP_STAT_LIM_ITERorTIME:
-		case DSP_STAT_STOPPED_GAP:
-		case DSP_STAT_STOPPED_NODE:
-		case DSP_STAT_STOPPED_TIME:
-			break;
-		default:
-			status_ = DSP_STAT_MW_STOP;
-			message_->print(10,
-							"Warning: subproblem %d solution status is %d\n", s,
-							status);
-			break;
-		}
-
-		/** consume time */
-		total_cputime += CoinCpuTime() - cputime;
-		total_walltime += CoinGetTimeOfDay() - walltime;
-		time_remains_ -= CoinGetTimeOfDay() - walltime;
-
-		if (status_ == DSP_STAT_MW_STOP)
-		{
-			primobj = COIN_DBL_MAX;
-			dualobj = -COIN_DBL_MAX;
-			break;
-		}
+	cputime = CoinCpuTime();
+	walltime = CoinGetTimeOfDay();
 
-		CoinCopyN(osi_[s]->si_->getColSolution(), osi_[s]->si_->getNumCols(), &primsols_[s][0]);
+	/** solve the scenario subproblems */
+	DSP_RTN_CHECK_THROW(solveSubproblems());
+	if (status_ == DSP_STAT_MW_STOP)
+	{
+		primobj = COIN_DBL_MAX;
+		dualobj = -COIN_DBL_MAX;
 	}
 
+	/** consume time */
+	total_cputime += CoinCpuTime() - cputime;
+	total_walltime += CoinGetTimeOfDay() - walltime;
+	time_remains_ -= CoinGetTimeOfDay() - walltime;
+
 	// gather status_ to all processes
 	MPI_Allgather(&status_, 1, MPI_INT, statuses, 1, MPI_INT, comm_);
 	for (int s = 0; s < comm_size_; ++s)
@@ -185,13 +148,11 @@ DSP_RTN_CODE DdDroWorkerUBMpi::solve()
 			for (int k = 0; k < model_->getNumSubproblems(); ++k)
 			{
 				DSPdebugMessage("subprob_ids[%d] = %d, rlbd[%d] = %e\n", k, subprob_ids[k],
-								subprob_ids[k] * model_->getNumReferences(),
+								dro_row_start_[subprob_ids[k]],
 								recvbuf[k]);
-				for (int s = 0; s < model_->getNumReferences(); ++s)
+				for (int r = dro_row_start_[subprob_ids[k]]; r < dro_row_start_[subprob_ids[k] + 1]; ++r)
 				{
-					osi_dro_->si_->setRowLower(
-						subprob_ids[k] * model_->getNumReferences() + s,
-						recvbuf[k]);
+					osi_dro_->si_->setRowLower(r, recvbuf[k]);
 				}
 			}
 #ifdef DSP_DEBUG
@@ -8,6 +8,9 @@
 // #define DSP_DEBUG
 #include "Utility/DspUtility.h"
 #include "Solver/DualDecomp/DdMW.h"
+#include "Model/TssModel.h"
+#include "Utility/DspCheckpoint.h"
+#include "Utility/DspProfiler.h"
 
 DdMW::DdMW(
 		DecModel *   model,  /**< model pointer */
@@ -22,6 +25,8 @@ parFeasCuts_(-1),
 parOptCuts_(-1), 
 parEvalUb_(-1), 
 parTimeLimit_(0),
+parCheckpointFreq_(0),
+initIncumbentStored_(false),
 itercode_(' '), 
 itercnt_(0), 
 iterstime_(0.0) {
@@ -37,9 +42,12 @@ parFeasCuts_(rhs.parFeasCuts_),
 parOptCuts_(rhs.parOptCuts_), 
 parEvalUb_(rhs.parEvalUb_), 
 parTimeLimit_(rhs.parTimeLimit_),
+parCheckpointFreq_(rhs.parCheckpointFreq_),
+initIncumbentStored_(rhs.initIncumbentStored_),
 itercode_(rhs.itercode_), 
 itercnt_(rhs.itercnt_), 
 iterstime_(rhs.iterstime_),
+ubSolutions_(rhs.ubSolutions_),
 s_itertime_(rhs.s_itertime_),
 s_masterobj_(rhs.s_masterobj_),
 s_bestprimobj_(rhs.s_bestprimobj_),
@@ -50,10 +58,6 @@ s_bestdualobj_(rhs.s_bestdualobj_) {
 	for (unsigned i = 0; i < rhs.worker_.size(); ++i)
 		worker_.push_back(rhs.worker_[i]->clone());
 
-	// copy solutions
-	for (unsigned i = 0; i < rhs.ubSolutions_.size(); ++i)
-		ubSolutions_.push_back(new CoinPackedVector(*(rhs.ubSolutions_[i])));
-
 	// copy cuts
 	cutsToAdd_ = new OsiCuts(*(rhs.cutsToAdd_));
 }
@@ -73,11 +77,6 @@ DdMW::~DdMW() {
 	par_     = NULL;
 	message_ = NULL;
 
-	// free solution
-	for (unsigned i = 0; i < ubSolutions_.size(); ++i)
-		FREE_PTR(ubSolutions_[i]);
-	ubSolutions_.clear();
-
 	// free cuts
 	FREE_PTR(cutsToAdd_);
 }
@@ -106,6 +105,13 @@ DSP_RTN_CODE DdMW::init()
 	parOptCuts_   = par_->getIntParam("DD/OPT_CUTS");
 	parEvalUb_    = par_->getIntParam("DD/EVAL_UB");
 	parTimeLimit_ = par_->getDblParam("DD/WALL_LIM");
+	parCheckpointFreq_ = par_->getIntParam("DD/CHECKPOINT/FREQ");
+	if (par_->getStrParam("DD/CHECKPOINT/FILE").size() == 0)
+		parCheckpointFreq_ = 0;
+
+	/** bound the pool of solutions evaluated for upper bounds */
+	ubSolutions_.setCapacity(par_->getIntParam("DD/UB_POOL_SIZE"));
+	initIncumbentStored_ = false;
 
 	if (model_->isDro())
 	{
@@ -122,8 +128,7 @@ DSP_RTN_CODE DdMW::finalize() {
 	BGN_TRY_CATCH
 
 	/** delete local solutions */
-	for (unsigned i = 0; i < ubSolutions_.size(); ++i)
-		FREE_PTR(ubSolutions_[i]);
+	ubSolutions_.clear();
 
 	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
 
@@ -137,6 +142,9 @@ DSP_RTN_CODE DdMW::storeCouplingSolutions(Solutions& stored)
 	/** maximum number of solutions to evaluate */
        	int max_stores = par_->getIntParam("DD/MAX_EVAL_UB");
 
+	/** evaluate the initial incumbent first */
+	DSP_RTN_CHECK_THROW(storeInitialIncumbent(stored));
+
 	/** store solutions to distribute */
 	for (int s = 0; s < model_->getNumSubproblems(); ++s)
 	{
@@ -149,14 +157,13 @@ DSP_RTN_CODE DdMW::storeCouplingSolutions(Solutions& stored)
 		DSPdebugMessage2("solution[%d] nx %d:\n", s, nx);
 		DSPdebug2(message_->printArray(nx, master_->subsolution_[s]));
 
-		CoinPackedVector * x = duplicateSolution(
-				nx, master_->subsolution_[s], ubSolutions_);
+		CoinPackedVector * x = duplicateSolution(nx, master_->subsolution_[s]);
 		if (x != NULL)
 		{
 			DSPdebugMessage2("Coupling solution:\n");
 			DSPdebug2(DspMessage::printArray(nx, master_->subsolution_[s]));
 			/** store solution */
-			ubSolutions_.push_back(x);
+			ubSolutions_.insert(x);
 			stored.push_back(x);
 			/** count */
 			max_stores--;
@@ -169,10 +176,30 @@ DSP_RTN_CODE DdMW::storeCouplingSolutions(Solutions& stored)
 	return DSP_RTN_OK;
 }
 
+DSP_RTN_CODE DdMW::storeInitialIncumbent(Solutions& stored)
+{
+	if (initIncumbentStored_ || par_->getDblPtrParamSize("INIT_INCUMBENT") <= 0)
+		return DSP_RTN_OK;
+
+	BGN_TRY_CATCH
+
+	initIncumbentStored_ = true;
+	CoinPackedVector * x = duplicateSolution(
+			par_->getDblPtrParamSize("INIT_INCUMBENT"), par_->getDblPtrParam("INIT_INCUMBENT"));
+	if (x != NULL)
+	{
+		ubSolutions_.insert(x);
+		stored.push_back(x);
+	}
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
 CoinPackedVector * DdMW::duplicateSolution(
-		int size,           /**< size of array */
-		const double * x,   /**< current solution */
-		Solutions solutions /**< solution pool to check duplication */)
+		int size,        /**< size of array */
+		const double * x /**< current solution */)
 {
 	assert(x);
 	bool dup = false;
@@ -186,7 +213,7 @@ CoinPackedVector * DdMW::duplicateSolution(
 	DSPdebug({
 		DSPdebugMessage("Number of elements in xvec: %d\n", xvec->getNumElements());
 		message_->printArray(xvec);});
-	dup = duplicateVector(xvec, solutions);
+	dup = ubSolutions_.find(*xvec) != NULL;
 	DSPdebugMessage("duplicateVector: %s\n", dup ? "true" : "false");
 
 	/** free if duplicate */
@@ -195,6 +222,135 @@ CoinPackedVector * DdMW::duplicateSolution(
 	return xvec;
 }
 
+DSP_RTN_CODE DdMW::writeCheckpoint()
+{
+	if (parCheckpointFreq_ <= 0 || itercnt_ % parCheckpointFreq_ != 0)
+		return DSP_RTN_OK;
+
+	BGN_TRY_CATCH
+
+	double stime = CoinGetTimeOfDay();
+	std::string filename = par_->getStrParam("DD/CHECKPOINT/FILE");
+
+	/** The previous checkpoint is replaced only after the new one is completely written. */
+	ofstream myfile((filename + ".tmp").c_str());
+	DspCheckpointWrite(myfile, "DSP_DD_CHECKPOINT", 1);
+	DspCheckpointWrite(myfile, "nsubprobs", model_->getNumSubproblems());
+	DspCheckpointWrite(myfile, "ncouplingrows", model_->getNumCouplingRows());
+	DspCheckpointWrite(myfile, "itercnt", itercnt_);
+	DSP_RTN_CHECK_THROW(master_->writeCheckpoint(myfile));
+	myfile.close();
+
+	if (myfile.fail() || !DspCheckpointCommit(filename))
+		message_->print(0, "Warning: failed to write the checkpoint %s\n", filename.c_str());
+	else
+		message_->print(2, "Wrote the checkpoint %s at iteration %d (%.2f sec).\n",
+				filename.c_str(), itercnt_, CoinGetTimeOfDay() - stime);
+	DSP_PROFILE_TIME("dd/checkpoint", CoinGetTimeOfDay() - stime);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DdMW::readCheckpoint()
+{
+	if (!isRestart())
+		return DSP_RTN_OK;
+
+	BGN_TRY_CATCH
+
+	int version, nsubprobs, ncouplingrows;
+	std::string filename = par_->getStrParam("DD/RESTART/FILE");
+
+	ifstream myfile(filename.c_str());
+	if (!myfile.is_open())
+		throw CoinError("Failed to open the checkpoint " + filename, "readCheckpoint", "DdMW");
+	DspCheckpointRead(myfile, "DSP_DD_CHECKPOINT", version);
+	DspCheckpointRead(myfile, "nsubprobs", nsubprobs);
+	DspCheckpointRead(myfile, "ncouplingrows", ncouplingrows);
+	if (version != 1 || nsubprobs != model_->getNumSubproblems() || ncouplingrows != model_->getNumCouplingRows())
+		throw CoinError("The checkpoint " + filename + " does not match the model", "readCheckpoint", "DdMW");
+	DspCheckpointRead(myfile, "itercnt", itercnt_);
+	DSP_RTN_CHECK_THROW(master_->readCheckpoint(myfile));
+	myfile.close();
+
+	message_->print(1, "Resumed from the checkpoint %s at iteration %d.\n", filename.c_str(), itercnt_);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DdMW::setInitialMultipliers()
+{
+	if (!isWarmStart())
+		return DSP_RTN_OK;
+
+	BGN_TRY_CATCH
+
+	/** The parameter may be set without the validation of the C API. */
+	if (par_->getDblPtrParamSize("DD/INIT_MULTIPLIERS") != model_->getNumCouplingRows())
+		throw CoinError("The initial multipliers do not match the model", "setInitialMultipliers", "DdMW");
+	DSP_RTN_CHECK_THROW(master_->setInitialMultipliers(par_->getDblPtrParam("DD/INIT_MULTIPLIERS")));
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+void DdMW::packTrialPoint(
+		std::vector<double> & buf,   /**< [out] packed trial point */
+		std::vector<int> &    displs /**< [out] position of each subproblem in buf */)
+{
+	const double * thetas = master_->getPrimalSolution();
+	const double * Ps = NULL;
+	if (model_->isStochastic())
+	{
+		TssModel * tss = dynamic_cast<TssModel*>(model_);
+		if (model_->isDro())
+			Ps = thetas + master_->getNumCols() - tss->getNumScenarios();
+		else
+			Ps = tss->getProbability();
+	}
+
+	buf.clear();
+	displs.assign(model_->getNumSubproblems() + 1, 0);
+	for (int s = 0; s < model_->getNumSubproblems(); ++s)
+	{
+		const double * lambda = master_->getLambda(s);
+		buf.push_back(thetas[s]);
+		buf.insert(buf.end(), lambda, lambda + model_->getNumSubproblemCouplingRows(s));
+		if (Ps)
+			buf.push_back(Ps[s]);
+		displs[s+1] = buf.size();
+	}
+}
+
+DSP_RTN_CODE DdMW::applyTrialPoint(
+		DdWorkerLB *                workerlb,   /**< LB worker */
+		const std::vector<double> & buf,        /**< packed trial point */
+		const std::vector<int> &    displs,     /**< position of each subproblem in buf */
+		double                      bestprimobj /**< best primal objective */)
+{
+	BGN_TRY_CATCH
+
+	for (unsigned k = 0; k < workerlb->subprobs_.size(); ++k)
+	{
+		int sindex = workerlb->subprobs_[k]->sind_;
+		const double * point = &buf[displs[sindex]];
+		double probability = -1.0;
+		if (model_->isStochastic())
+			probability = buf[displs[sindex+1] - 1];
+		workerlb->subprobs_[k]->theta_ = point[0];
+		DSP_RTN_CHECK_THROW(workerlb->subprobs_[k]->updateProblem(point + 1, probability, bestprimobj));
+	}
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
 void DdMW::printHeaderInfo() {
 	/**
 	 * PRINT DISPLAY
@@ -209,9 +365,13 @@ void DdMW::printHeaderInfo() {
 	message_->print(1, "* dualobj  = best dual objective function value.\n");
 	message_->print(1, "* a.gap(%) = Approximate gap between master and dualobj.\n");
 	message_->print(1, "* d.gap(%) = Duality gap between primobj and dualobj.\n");
-	message_->print(1, "* times    = wall clock time in seconds.\n\n");
-	message_->print(1, "  %4s  %13s  %13s  %13s  %8s  %8s  %6s\n",
+	message_->print(1, "* times    = wall clock time in seconds.\n");
+	printExtraHeaderLegend();
+	message_->print(1, "\n");
+	message_->print(1, "  %4s  %13s  %13s  %13s  %8s  %8s  %6s",
 			"iter", "master", "primobj", "dualobj", "a.gap(%)", "d.gap(%)", "time");
+	printExtraHeaderInfo();
+	message_->print(1, "\n");
 }
 
 void DdMW::printIterInfo()
@@ -240,7 +400,9 @@ void DdMW::printIterInfo()
 		message_->print(1, "  %8.2f", dualitygap*100);
 	else
 		message_->print(1, "  %8s", "Large");
-	message_->print(1, "  %6.1f\n", CoinGetTimeOfDay() - iterstime_);
+	message_->print(1, "  %6.1f", CoinGetTimeOfDay() - iterstime_);
+	printExtraIterInfo();
+	message_->print(1, "\n");
 
 	s_itertime_.push_back(CoinGetTimeOfDay() - iterstime_);
 	s_masterobj_.push_back(primobj);
@@ -254,6 +416,19 @@ void DdMW::writeIterInfo(const char * filename)
 
 	ofstream myfile;
 	myfile.open(filename);
+
+	if (par_->getStrParam("OUTPUT/FORMAT") == "json")
+	{
+		const char * names[] = {"iter", "masterobj", "bestprimobj", "bestdualobj", "time"};
+		for (unsigned i = 0; i < s_itertime_.size(); ++i)
+		{
+			double values[] = {static_cast<double>(i), s_masterobj_[i], s_bestprimobj_[i], s_bestdualobj_[i], s_itertime_[i]};
+			DspMessage::writeJsonRecord(myfile, 5, names, values);
+		}
+		myfile.close();
+		return;
+	}
+
 	myfile << "Iteration";
 	myfile << ",MasterObj";
 	myfile << ",BestPrimalObj";
@@ -9,6 +9,7 @@
 #define SRC_SOLVER_DECDDMW_H_
 
 #include "Solver/BaseMasterWorker.h"
+#include "Utility/DspSolutionPool.h"
 #include "Solver/DualDecomp/DdMaster.h"
 #include "Solver/DualDecomp/DdWorker.h"
 #include "Solver/DualDecomp/DdWorkerLB.h"
@@ -69,11 +70,51 @@ protected:
 	/** store coupling solution */
 	DSP_RTN_CODE storeCouplingSolutions(Solutions & stored);
 
-	/** check whether solution is duplicate or not; return NULL if duplicate */
+	/** store the initial incumbent in INIT_INCUMBENT to evaluate, only once */
+	DSP_RTN_CODE storeInitialIncumbent(Solutions & stored);
+
+	/** check whether solution is in ubSolutions_ or not; return NULL if duplicate */
 	CoinPackedVector * duplicateSolution(
-			int size,           /**< size of array */
-			const double * x,   /**< current solution */
-			Solutions solutions /**< solution pool to check duplication */);
+			int size,        /**< size of array */
+			const double * x /**< current solution */);
+
+	/** write the checkpoint of the master to DD/CHECKPOINT/FILE every DD/CHECKPOINT/FREQ iterations */
+	DSP_RTN_CODE writeCheckpoint();
+
+	/**
+	 * restore the iteration count and the master from the checkpoint in DD/RESTART/FILE,
+	 * if given. This is called at the master after the master is initialized. The
+	 * checkpoint does not depend on the assignment of the subproblems, so that the run
+	 * can be resumed with a different number of processes.
+	 */
+	DSP_RTN_CODE readCheckpoint();
+
+	/** is the run resumed from a checkpoint? */
+	bool isRestart() {return par_->getStrParam("DD/RESTART/FILE").size() > 0;}
+
+	/** does the run start from the initial multipliers in DD/INIT_MULTIPLIERS? */
+	bool isWarmStart() {return !isRestart() && par_->getDblPtrParamSize("DD/INIT_MULTIPLIERS") > 0;}
+
+	/**
+	 * set the master solution to the initial multipliers in DD/INIT_MULTIPLIERS, if the run
+	 * is warm-started. This is called at the master after the master is initialized.
+	 */
+	DSP_RTN_CODE setInitialMultipliers();
+
+	/**
+	 * pack the master solution to evaluate for all the subproblems in the form of
+	 * [theta_s, lambda_s, P_s], where P_s is given for stochastic models only
+	 */
+	void packTrialPoint(
+			std::vector<double> & buf,   /**< [out] packed trial point */
+			std::vector<int> &    displs /**< [out] position of each subproblem in buf (size: number of subproblems + 1) */);
+
+	/** update the subproblems of the LB worker by a packed trial point */
+	DSP_RTN_CODE applyTrialPoint(
+			DdWorkerLB *                workerlb,   /**< LB worker */
+			const std::vector<double> & buf,        /**< packed trial point */
+			const std::vector<int> &    displs,     /**< position of each subproblem in buf */
+			double                      bestprimobj /**< best primal objective */);
 
 	/** print header info */
 	virtual void printHeaderInfo();
@@ -81,6 +122,15 @@ protected:
 	/** print iteration info */
 	virtual void printIterInfo();
 
+	/** print the descriptions of additional columns in the header */
+	virtual void printExtraHeaderLegend() {}
+
+	/** print additional columns in the header */
+	virtual void printExtraHeaderInfo() {}
+
+	/** print additional columns in the iteration information */
+	virtual void printExtraIterInfo() {}
+
 	/** write output */
 	virtual void writeIterInfo(const char * filename);
 
@@ -95,7 +145,7 @@ protected:
 	DspParams * par_;      /**< parameters */
 	DspMessage * message_; /**< message */
 
-	Solutions ubSolutions_; /**< saved solutions that were evaluated for upper bounds */
+	DspSolutionPool ubSolutions_; /**< saved solutions that were evaluated for upper bounds */
 
 	OsiCuts * cutsToAdd_; /**< cuts to add */
 
@@ -104,6 +154,9 @@ protected:
 	int parOptCuts_;      /**< Benders optimality cuts */
 	int parEvalUb_;       /**< upper bounds */
 	double parTimeLimit_; /**< time limit */
+	int parCheckpointFreq_; /**< number of iterations between checkpoints (0 to disable) */
+
+	bool initIncumbentStored_; /**< whether the initial incumbent has been stored to evaluate */
 
 	/** iteration info */
 	char   itercode_;
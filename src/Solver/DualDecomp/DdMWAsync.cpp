@@ -21,14 +21,18 @@ DdMWAsync::DdMWAsync(
 		DspMessage * message /**< message pointer */):
 DdMWPara(comm,model,par,message),
 qid_counter_(0),
-max_queue_size_(5) {}
+max_queue_size_(5),
+q_nevicted_(0) {}
 
 DdMWAsync::DdMWAsync(const DdMWAsync& rhs) :
 DdMWPara(rhs),
 qid_counter_(rhs.qid_counter_),
 max_queue_size_(rhs.max_queue_size_),
+q_nevicted_(rhs.q_nevicted_),
 q_id_(rhs.q_id_),
-q_objval_(rhs.q_objval_) {
+q_objval_(rhs.q_objval_),
+q_masterobj_(rhs.q_masterobj_),
+q_iter_(rhs.q_iter_) {
 	double * sol;
 	int * ind;
 	for (int i = 0; i < rhs.q_solution_.size(); ++i) {
@@ -69,6 +73,13 @@ DSP_RTN_CODE DdMWAsync::init()
 		master_ = new DdMasterAtr(model_, par_, message_, lb_comm_size_);
 		/** initialize master */
 		master_->init();
+		/**
+		 * resume from the checkpoint or set the initial multipliers; the workers still
+		 * start from their default multipliers, and their solutions only add cuts to the
+		 * restored or warm-started master.
+		 */
+		DSP_RTN_CHECK_THROW(readCheckpoint());
+		DSP_RTN_CHECK_THROW(setInitialMultipliers());
 	}
 	else
 	{
@@ -494,6 +505,7 @@ DSP_RTN_CODE DdMWAsync::runMasterInit()
 		DSPdebugMessage("Rank %d sent %lu solutions to rank %d.\n", comm_rank_, solutions.size(), cgub_comm_root_);
 		/** clear solutions */
 		solutions.clear();
+		ubSolutions_.release();
 	}
 
 	/** update problem */
@@ -551,13 +563,7 @@ DSP_RTN_CODE DdMWAsync::runMasterCore()
 	FREE_2D_ARRAY_PTR(subcomm_size_-1,subindex)   \
 	FREE_2D_ARRAY_PTR(subcomm_size_-1,subprimobj) \
 	FREE_2D_ARRAY_PTR(subcomm_size_-1,subdualobj) \
-	if (subsolution) {                                                     \
-		for (int i = 0; i < subcomm_size_ - 1; ++i) {                      \
-			FREE_2D_ARRAY_PTR(model_->getNumSubproblems(), subsolution[i]) \
-		}                                                               \
-		delete [] subsolution;                                          \
-		subsolution = NULL;                                             \
-	}                                                                   \
+	FREE_2D_ARRAY_PTR(subcomm_size_-1,subsolution) \
 	FREE_ARRAY_PTR(numCutsAdded)
 
 	/** MPI_Recv message:
@@ -576,6 +582,14 @@ DSP_RTN_CODE DdMWAsync::runMasterCore()
 	int ** subindex = NULL;
 	double ** subprimobj = NULL;
 	double ** subdualobj = NULL;
+
+	/**
+	 * Subproblem solutions received from each LB worker. These only point to the
+	 * per-subproblem solution buffer of the master, which is recycled at every
+	 * iteration, since each subproblem is evaluated by a single worker and each
+	 * worker sends at most one message per iteration. The storage is hence not
+	 * scaled by the number of ranks or by the number of iterations.
+	 */
 	double *** subsolution = NULL;
 
 	/** MPI_Iprobe */
@@ -618,8 +632,7 @@ DSP_RTN_CODE DdMWAsync::runMasterCore()
 		subprimobj[i]  = new double [model_->getNumSubproblems()];
 		subdualobj[i]  = new double [model_->getNumSubproblems()];
 		subsolution[i] = new double * [model_->getNumSubproblems()];
-		for (int s = 0; s < model_->getNumSubproblems(); ++s)
-			subsolution[i][s] = new double [master_->getModelPtr()->getNumSubproblemCouplingCols(s)];
+		CoinFillN(subsolution[i], model_->getNumSubproblems(), (double*)NULL);
 	}
 	if (parFeasCuts_ >= 0 || parOptCuts_ >= 0)
 	{
@@ -709,6 +722,7 @@ DSP_RTN_CODE DdMWAsync::runMasterCore()
 				subindex[msg_source-1][s] = static_cast<int>(recvbuf[pos++]);
 				subprimobj[msg_source-1][s] = recvbuf[pos++];
 				subdualobj[msg_source-1][s] = recvbuf[pos++];
+				subsolution[msg_source-1][s] = master_->subsolution_[subindex[msg_source-1][s]];
 				CoinCopyN(recvbuf + pos,
 						model_->getNumSubproblemCouplingCols(subindex[msg_source-1][s]),
 						subsolution[msg_source-1][s]);
@@ -777,6 +791,7 @@ DSP_RTN_CODE DdMWAsync::runMasterCore()
 				MPIsendCoinPackedVectors(comm_, cgub_comm_root_, solutions, DSP_MPI_TAG_SOLS);
 				/** clear solutions */
 				solutions.clear();
+				ubSolutions_.release();
 			}
 
 			/** receive Benders cuts */
@@ -801,10 +816,12 @@ DSP_RTN_CODE DdMWAsync::runMasterCore()
 		bool hasEvaluatedQueue = false;
 		double * primsol_from_Q = NULL;
 		double dualobj = -COIN_DBL_MAX;
-		while (q_indicator_.size() > 0)
+		/** With the priority queue, the elements are not necessarily evaluated in order. */
+		bool scanQueue = par_->getBoolParam("DD/ASYNC/PRIORITY");
+		for (unsigned q = 0; q < q_indicator_.size();)
 		{
-			int * indicator = q_indicator_.front();
-			double queue_objval = q_objval_.front();
+			int * indicator = q_indicator_[q];
+			double queue_objval = q_objval_[q];
 			bool removeQueue = true;
 			for (int k = 0; k < model_->getNumSubproblems(); ++k) {
 				if (indicator[k] < Q_EVALUATED) {
@@ -812,17 +829,22 @@ DSP_RTN_CODE DdMWAsync::runMasterCore()
 					break;
 				}
 			}
-			if (removeQueue == false) break;
-			message_->print(5, "The trial point (ID %d) is evaluated and removed from the queue.\n", q_id_.front());
+			if (removeQueue == false)
+			{
+				if (scanQueue == false) break;
+				q++;
+				continue;
+			}
+			message_->print(5, "The trial point (ID %d) is evaluated and removed from the queue.\n", q_id_[q]);
 			hasEvaluatedQueue = true;
 			if (queue_objval > dualobj)
 			{
 				dualobj = queue_objval;
 				FREE_ARRAY_PTR(primsol_from_Q);
-				primsol_from_Q = q_solution_.front();
-				q_solution_.front() = NULL;
+				primsol_from_Q = q_solution_[q];
+				q_solution_[q] = NULL;
 			}
-			DSP_RTN_CHECK_RTN_CODE(popSolutionFromQueue());
+			DSP_RTN_CHECK_RTN_CODE(eraseSolutionFromQueue(q));
 		}
 
 		if (hasEvaluatedQueue)
@@ -873,6 +895,9 @@ DSP_RTN_CODE DdMWAsync::runMasterCore()
 		/** solve problem */
 		DSP_RTN_CHECK_RTN_CODE(master->solve());
 
+		/** drop the trial points dominated by the new one */
+		DSP_RTN_CHECK_RTN_CODE(evictQueueElements(master_->getPrimalObjective()));
+
 		/** put solution to Q */
 		if (q_solution_.size() < max_queue_size_)
 		{
@@ -890,6 +915,9 @@ DSP_RTN_CODE DdMWAsync::runMasterCore()
 		/** increment iteration count */
 		itercnt_++;
 
+		/** write checkpoint */
+		DSP_RTN_CHECK_RTN_CODE(writeCheckpoint());
+
 		/** returns continue or stop signal */
 		if (remainingTime() < 1.0)
 		{
@@ -1036,24 +1064,100 @@ bool DdMWAsync::chooseQueueElement(int& qid, double*& qsol, int& nsubprobs, int*
 	/** initialize queue ID */
 	qid = -1;
 
-	/** FIFO vs LIFO */
-	for (unsigned k = 0; k < q_indicator_.size(); ++k) {
-		int kk = k;
-		if (par_->getBoolParam("DD/ASYNC/FIFO") == false)
-			kk = q_indicator_.size() - 1 - k;
-		if (q_indicator_[k][subindex[0]] == Q_NOT_ASSIGNED) {
-			qid = q_id_[k];
-			qsol = q_solution_[k];
-			for (int s = 0; s < nsubprobs; ++s)
-				q_indicator_[k][subindex[s]] = Q_ASSIGNED;
+	int chosen = -1;
+	if (par_->getBoolParam("DD/ASYNC/PRIORITY"))
+	{
+		/** the highest priority among the elements not assigned to the worker */
+		double best = -COIN_DBL_MAX;
+		for (unsigned k = 0; k < q_indicator_.size(); ++k) {
+			if (q_indicator_[k][subindex[0]] != Q_NOT_ASSIGNED) continue;
+			double priority = getQueuePriority(k);
+			if (priority > best) {
+				best = priority;
+				chosen = k;
+			}
+		}
+	}
+	else
+	{
+		/** FIFO vs LIFO */
+		for (unsigned k = 0; k < q_indicator_.size(); ++k) {
+			int kk = k;
+			if (par_->getBoolParam("DD/ASYNC/FIFO") == false)
+				kk = q_indicator_.size() - 1 - k;
+			if (q_indicator_[kk][subindex[0]] == Q_NOT_ASSIGNED) {
+				chosen = kk;
+				break;
+			}
 		}
-		if (qid > -1) break;
+	}
+
+	if (chosen > -1) {
+		qid = q_id_[chosen];
+		qsol = q_solution_[chosen];
+		for (int s = 0; s < nsubprobs; ++s)
+			q_indicator_[chosen][subindex[s]] = Q_ASSIGNED;
 	}
 	DSPdebugMessage("qid %d qsol %p\n", qid, qsol);
 
 	return (qid > -1);
 }
 
+double DdMWAsync::getQueuePriority(unsigned k) {
+	/** predicted improvement of the dual objective */
+	double improvement = q_masterobj_[k] - master_->getBestDualObjective();
+	if (improvement < 0.0) improvement = 0.0;
+	/** discount by the number of master iterations since the element was queued */
+	return improvement * pow(par_->getDblParam("DD/ASYNC/STALENESS_DECAY"), itercnt_ - q_iter_[k]);
+}
+
+DSP_RTN_CODE DdMWAsync::evictQueueElements(double masterobj) {
+	BGN_TRY_CATCH
+
+	int policy = par_->getIntParam("DD/ASYNC/EVICT");
+	if (policy <= 0) return DSP_RTN_OK;
+
+	for (unsigned k = 0; k < q_indicator_.size();)
+	{
+		/** keep the element assigned to any worker */
+		bool assigned = false;
+		for (int s = 0; s < model_->getNumSubproblems(); ++s)
+		{
+			if (q_indicator_[k][s] != Q_NOT_ASSIGNED)
+			{
+				assigned = true;
+				break;
+			}
+		}
+
+		/**
+		 * The new trial point dominates the element if it predicts at least the same improvement,
+		 * since it is obtained from more cuts.
+		 */
+		bool evict = false;
+		if (assigned == false)
+		{
+			if (q_masterobj_[k] <= masterobj)
+				evict = true;
+			else if (policy >= 2 && q_masterobj_[k] <= master_->getBestDualObjective())
+				evict = true;
+		}
+
+		if (evict)
+		{
+			message_->print(5, "The trial point (ID %d) is evicted from the queue.\n", q_id_[k]);
+			DSP_RTN_CHECK_THROW(eraseSolutionFromQueue(k));
+			q_nevicted_++;
+		}
+		else
+			k++;
+	}
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
 DSP_RTN_CODE DdMWAsync::runWorkerInit()
 {
 #define FREE_MEMORY         \
@@ -1375,6 +1479,9 @@ DSP_RTN_CODE DdMWAsync::storeCouplingSolutions(Solutions& solutions) {
 
 	DdMasterAtr * master  = dynamic_cast<DdMasterAtr*>(master_);
 
+	/** evaluate the initial incumbent first */
+	DSP_RTN_CHECK_THROW(storeInitialIncumbent(solutions));
+
 	/** store solutions to distribute */
 	for (unsigned i = 0; i < master->nsubprobs_.size(); ++i)
 		for (int s = 0; s < master->nsubprobs_[i]; ++s)
@@ -1385,15 +1492,14 @@ DSP_RTN_CODE DdMWAsync::storeCouplingSolutions(Solutions& solutions) {
 				DSPdebugMessage("solution[%d] nx %d:\n", s, nx);
 				message_->printArray(nx, master->subsolution_[i][s]);});
 
-			CoinPackedVector * x = duplicateSolution(
-					nx, master->subsolution_[i][s], ubSolutions_);
+			CoinPackedVector * x = duplicateSolution(nx, master->subsolution_[i][s]);
 			if (x != NULL)
 			{
 				DSPdebug2({
 					DSPdebugMessage2("Coupling solution:\n");
 					DspMessage::printArray(nx, master->subsolution_[i][s]);});
 				/** store solution */
-				ubSolutions_.push_back(x);
+				ubSolutions_.insert(x);
 				solutions.push_back(x);
 			}
 		}
@@ -1808,6 +1914,8 @@ DSP_RTN_CODE DdMWAsync::pushSolutionToQueue(double* solution)
 	q_solution_.push_back(l);
 	q_indicator_.push_back(indicator);
 	q_objval_.push_back(0.0);
+	q_masterobj_.push_back(master_->getPrimalObjective());
+	q_iter_.push_back(itercnt_);
 	l = NULL;
 	indicator = NULL;
 
@@ -1837,6 +1945,8 @@ DSP_RTN_CODE DdMWAsync::pushFrontSolutionToQueue(double* solution)
 	q_solution_.push_front(l);
 	q_indicator_.push_front(indicator);
 	q_objval_.push_front(0.0);
+	q_masterobj_.push_front(master_->getPrimalObjective());
+	q_iter_.push_front(itercnt_);
 	l = NULL;
 	indicator = NULL;
 
@@ -1868,6 +1978,8 @@ DSP_RTN_CODE DdMWAsync::popSolutionFromQueue()
 	q_solution_.pop_front();
 	q_indicator_.pop_front();
 	q_objval_.pop_front();
+	q_masterobj_.pop_front();
+	q_iter_.pop_front();
 
 	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
 
@@ -1891,8 +2003,51 @@ DSP_RTN_CODE DdMWAsync::popBackSolutionFromQueue()
 	q_solution_.pop_back();
 	q_indicator_.pop_back();
 	q_objval_.pop_back();
+	q_masterobj_.pop_back();
+	q_iter_.pop_back();
 
 	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
 
 	return DSP_RTN_OK;
 }
+
+DSP_RTN_CODE DdMWAsync::eraseSolutionFromQueue(unsigned k)
+{
+	BGN_TRY_CATCH
+
+	if (k >= q_id_.size()) throw "Queue position is out of range.";
+
+	/** free memeory */
+	FREE_ARRAY_PTR(q_solution_[k]);
+	FREE_ARRAY_PTR(q_indicator_[k]);
+
+	q_id_.erase(q_id_.begin() + k);
+	q_solution_.erase(q_solution_.begin() + k);
+	q_indicator_.erase(q_indicator_.begin() + k);
+	q_objval_.erase(q_objval_.begin() + k);
+	q_masterobj_.erase(q_masterobj_.begin() + k);
+	q_iter_.erase(q_iter_.begin() + k);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+void DdMWAsync::printExtraHeaderLegend() {
+	message_->print(1, "* qsize    = number of trial points in the queue.\n");
+	message_->print(1, "* q.age    = average age of the queued trial points in iterations.\n");
+	message_->print(1, "* evicted  = number of trial points evicted from the queue.\n");
+}
+
+void DdMWAsync::printExtraHeaderInfo() {
+	message_->print(1, "  %5s  %6s  %7s", "qsize", "q.age", "evicted");
+}
+
+void DdMWAsync::printExtraIterInfo() {
+	double age = 0.0;
+	for (unsigned k = 0; k < q_iter_.size(); ++k)
+		age += itercnt_ - q_iter_[k];
+	if (q_iter_.size() > 0)
+		age /= q_iter_.size();
+	message_->print(1, "  %5lu  %6.1f  %7d", q_id_.size(), age, q_nevicted_);
+}
@@ -57,6 +57,13 @@ protected:
 	/** choose queue element for evaluating dual variables */
 	virtual bool chooseQueueElement(int& qid, double*& qsol, int& nsubprobs, int*& subindex);
 
+	/** priority of queue element: predicted improvement discounted by its age */
+	virtual double getQueuePriority(unsigned k);
+
+	/** evict the queue elements that are not assigned and dominated by the new trial point */
+	virtual DSP_RTN_CODE evictQueueElements(
+			double masterobj /**< master objective value of the new trial point */);
+
 	/** store coupling solution */
 	virtual DSP_RTN_CODE storeCouplingSolutions(Solutions & stored);
 
@@ -112,6 +119,19 @@ protected:
 	/** pop back queue */
 	virtual DSP_RTN_CODE popBackSolutionFromQueue();
 
+	/** erase queue element */
+	virtual DSP_RTN_CODE eraseSolutionFromQueue(
+			unsigned k /**< queue position */);
+
+	/** print the descriptions of queue columns in the header */
+	virtual void printExtraHeaderLegend();
+
+	/** print queue columns in the header */
+	virtual void printExtraHeaderInfo();
+
+	/** print queue columns in the iteration information */
+	virtual void printExtraIterInfo();
+
 protected:
 
 	enum {
@@ -122,11 +142,14 @@ protected:
 
 	int qid_counter_;    /**< unique queue identification number */
 	int max_queue_size_; /**< maximum queue size */
+	int q_nevicted_;     /**< number of evicted queue elements */
 
 	std::deque<int>     q_id_;        /**< queue ID */
 	std::deque<double*> q_solution_;  /**< lambdas in queue */
 	std::deque<int*>    q_indicator_; /**< indicate if lambda is evaluated for each subproblem */
 	std::deque<double>  q_objval_;    /**< objective value */
+	std::deque<double>  q_masterobj_; /**< master objective value at which lambda was obtained */
+	std::deque<int>     q_iter_;      /**< iteration at which lambda was obtained */
 
 };
 
@@ -10,6 +10,7 @@
 #include "Model/TssModel.h"
 #include "Solver/DualDecomp/DdMWSerial.h"
 #include "Solver/DualDecomp/DdMasterTr.h"
+#include "Utility/DspProfiler.h"
 // #ifdef DSP_HAS_OOQP
 // #include "Solver/DualDecomp/DdMasterDsb.h"
 // #endif
@@ -212,6 +213,25 @@ DSP_RTN_CODE DdMWSerial::run()
 	itercnt_   = 0;
 	iterstime_ = CoinGetTimeOfDay();
 
+	/** resume from the checkpoint with the restored master solution as the first trial point */
+	if (isRestart())
+	{
+		vector<double> trialpoint;
+		vector<int> displs;
+		DSP_RTN_CHECK_THROW(readCheckpoint());
+		packTrialPoint(trialpoint, displs);
+		DSP_RTN_CHECK_THROW(applyTrialPoint(workerlb, trialpoint, displs, master_->bestprimobj_));
+	}
+	else if (isWarmStart())
+	{
+		/** the subproblems start from the initial multipliers */
+		vector<double> trialpoint;
+		vector<int> displs;
+		DSP_RTN_CHECK_THROW(setInitialMultipliers());
+		packTrialPoint(trialpoint, displs);
+		DSP_RTN_CHECK_THROW(applyTrialPoint(workerlb, trialpoint, displs, master_->bestprimobj_));
+	}
+
 	/**
 	 * This is the main loop to iteratively solve master problem.
 	 */
@@ -313,6 +333,7 @@ DSP_RTN_CODE DdMWSerial::run()
 			}
 			/** clear stored solutions */
 			coupling_solutions.clear();
+			ubSolutions_.release();
 		}
 
 		/** update problem */
@@ -347,6 +368,7 @@ DSP_RTN_CODE DdMWSerial::run()
 		/** solve problem */
 		double tic = CoinGetTimeOfDay();
 		DSP_RTN_CHECK_THROW(master_->solve());
+		DSP_PROFILE_TIME("dd/master_solve", CoinGetTimeOfDay() - tic);
 		DSPdebugMessage("Solved the master (%.2f sec).\n", CoinGetTimeOfDay() - tic);
 
 		printIterInfo();
@@ -368,6 +390,9 @@ DSP_RTN_CODE DdMWSerial::run()
 		/** increment iteration count */
 		itercnt_++;
 
+		/** write checkpoint */
+		DSP_RTN_CHECK_THROW(writeCheckpoint());
+
 		/** retrieve master solution by part */
 		const double *master_primsol = master_->getPrimalSolution();
 		thetas = master_primsol;
@@ -13,16 +13,24 @@
 // #include "Solver/DualDecomp/DdMasterDsb.h"
 // #endif
 #include "Solver/DualDecomp/DdMasterSubgrad.h"
+#include "Utility/DspProfiler.h"
+#include "Utility/DspLoadBalance.h"
 
 DdMWSync::DdMWSync(
 		MPI_Comm     comm,   /**< MPI communicator */
 		DecModel *   model,  /**< model pointer */
 		DspParams *  par,    /**< parameters */
 		DspMessage * message /**< message pointer */):
-DdMWPara(comm,model,par,message) {}
+DdMWPara(comm,model,par,message),
+parOverlap_(false),
+parRebalanceFreq_(0),
+parRebalanceTol_(0.1) {}
 
 DdMWSync::DdMWSync(const DdMWSync& rhs) :
-DdMWPara(rhs) {}
+DdMWPara(rhs),
+parOverlap_(rhs.parOverlap_),
+parRebalanceFreq_(rhs.parRebalanceFreq_),
+parRebalanceTol_(rhs.parRebalanceTol_) {}
 
 DdMWSync::~DdMWSync() {}
 
@@ -36,6 +44,19 @@ DSP_RTN_CODE DdMWSync::init()
 	/** initialize MPI communication settings */
 	DdMWPara::init();
 
+	/** overlap the master solve with upper bounding */
+	parOverlap_ = par_->getBoolParam("DD/SYNC/OVERLAP");
+
+	/** rebalancing the subproblems */
+	parRebalanceFreq_ = par_->getIntParam("DD/REBALANCE/FREQ");
+	parRebalanceTol_ = par_->getDblParam("DD/REBALANCE/TOL");
+	if (parRebalanceFreq_ > 0 && !model_->isStochastic())
+	{
+		if (comm_rank_ == 0)
+			message_->print(0, "Warning: Rebalancing subproblems is disabled. It requires a stochastic model.\n");
+		parRebalanceFreq_ = 0;
+	}
+
 	if (comm_rank_ == 0)
 	{
 		/** create master */
@@ -70,33 +91,20 @@ DSP_RTN_CODE DdMWSync::init()
 			/** create LB worker */
 			DSPdebugMessage("Rank %d creates a worker for lower bounds.\n", comm_rank_);
 			worker_.push_back(new DdWorkerLB(model_, par_, message_));
-			/** create CG worker */
-			if (parFeasCuts_ >= 0 || parOptCuts_ >= 0)
-			{
-#ifdef DSP_HAS_SCIP
-				DSPdebugMessage("Rank %d creates a worker for Benders cut generation.\n", comm_rank_);
-				worker_.push_back(new DdWorkerCGBd(model_, par_, message_));
-#endif
-			}
-			/** create UB worker */
-			if (parEvalUb_ >= 0)
-			{
-				DSPdebugMessage("Rank %d creates a worker for upper bounds.\n", comm_rank_);
-				if (model_->isDro())
-					worker_.push_back(new DdDroWorkerUBMpi(lb_comm_, model_, par_, message_));
-				else
-					worker_.push_back(new DdWorkerUB(model_, par_, message_));
-			}
+			DSP_RTN_CHECK_THROW(worker_[0]->init());
+			/** create CG and UB workers */
+			DSP_RTN_CHECK_THROW(createBoundingWorkers());
 		}
-		/** initialize workers */
-		for (unsigned i = 0; i < worker_.size(); ++i)
-			DSP_RTN_CHECK_THROW(worker_[i]->init());
 	}
 
         /** reset iteration info */
         itercnt_   = 0;
         iterstime_ = CoinGetTimeOfDay();
 
+	/** resume from the checkpoint or start from the initial multipliers */
+	if (isRestart() || isWarmStart())
+		DSP_RTN_CHECK_THROW(restart());
+
 	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
 
 	return DSP_RTN_OK;
@@ -243,6 +251,11 @@ DSP_RTN_CODE DdMWSync::runMaster()
 
 	int * nsubsolution = NULL; /**< size of subproblem solution for each scenario */
 
+	/** nonblocking requests used for overlapping */
+	MPI_Request gather_req = MPI_REQUEST_NULL;  /**< MPI_Igatherv request */
+	MPI_Request scatter_req = MPI_REQUEST_NULL; /**< MPI_Iscatterv request */
+	char pending_itercode = ' '; /**< iteration code from the overlapped upper bounding */
+
 	Solutions stored; /**< coupling solutions */
 	Solutions dummy_solutions;
 	std::vector<double> dummy_double_array;
@@ -299,40 +312,46 @@ DSP_RTN_CODE DdMWSync::runMaster()
 	rcounts = new int [subcomm_size_];
 	rdispls = new int [subcomm_size_];
 
-	/** initialize send buffer size and displacement,
-	 * and calculate size of send buffer pointer */
-	size_of_sendbuf = 0;
-	for (int i = 0; i < subcomm_size_; ++i)
-	{
-		scounts[i] = 0;
-		for (int j = 0; j < nsubprobs_[i]; ++j)
+	/** set the message buffers for the subproblem indices (called again after rebalancing) */
+	auto setBuffers = [&]() {
+		/** initialize send buffer size and displacement,
+		 * and calculate size of send buffer pointer */
+		size_of_sendbuf = 0;
+		for (int i = 0; i < subcomm_size_; ++i)
 		{
-			scounts[i] += 1																					// theta
-						  + model_->getNumSubproblemCouplingRows(subprob_indices_[subprob_displs_[i] + j]); // lambda
-			if (model_->isStochastic())
-				scounts[i] += 1; // P
+			scounts[i] = 0;
+			for (int j = 0; j < nsubprobs_[i]; ++j)
+			{
+				scounts[i] += 1																					// theta
+							  + model_->getNumSubproblemCouplingRows(subprob_indices_[subprob_displs_[i] + j]); // lambda
+				if (model_->isStochastic())
+					scounts[i] += 1; // P
+			}
+			sdispls[i] = i == 0 ? 0 : sdispls[i-1] + scounts[i-1];
+			size_of_sendbuf += scounts[i];
 		}
-		sdispls[i] = i == 0 ? 0 : sdispls[i-1] + scounts[i-1];
-		size_of_sendbuf += scounts[i];
-	}
 
-	/** initialize receive buffer size and displacement,
-	 * and calculate size of receive buffer pointer */
-	size_of_recvbuf = 0;
-	rcounts[0] = 0;
-	rdispls[0] = 0;
-	for (int i = 1; i < subcomm_size_; ++i)
-	{
-		rcounts[i] = 0;
-		for (int j = 0; j < nsubprobs_[i]; ++j)
-			rcounts[i] += 3 + nsubsolution[j];
-		rdispls[i] = rdispls[i-1] + rcounts[i-1];
-		size_of_recvbuf += rcounts[i];
-	}
+		/** initialize receive buffer size and displacement,
+		 * and calculate size of receive buffer pointer */
+		size_of_recvbuf = 0;
+		rcounts[0] = 0;
+		rdispls[0] = 0;
+		for (int i = 1; i < subcomm_size_; ++i)
+		{
+			rcounts[i] = 0;
+			for (int j = 0; j < nsubprobs_[i]; ++j)
+				rcounts[i] += 3 + nsubsolution[subprob_indices_[subprob_displs_[i] + j]];
+			rdispls[i] = rdispls[i-1] + rcounts[i-1];
+			size_of_recvbuf += rcounts[i];
+		}
 
-	/** allocate memory for message buffers */
-	sendbuf = new double [size_of_sendbuf];
-	recvbuf = new double [size_of_recvbuf];
+		/** allocate memory for message buffers */
+		FREE_ARRAY_PTR(sendbuf)
+		FREE_ARRAY_PTR(recvbuf)
+		sendbuf = new double [size_of_sendbuf];
+		recvbuf = new double [size_of_recvbuf];
+	};
+	setBuffers();
 
 	printHeaderInfo();
 
@@ -345,13 +364,24 @@ DSP_RTN_CODE DdMWSync::runMaster()
 		cg_status = DSP_STAT_MW_CONTINUE;
 
 		/** reset iteration code */
-		itercode_ = ' ';
+		itercode_ = pending_itercode;
+		pending_itercode = ' ';
 
 		/** receive message */
 		mts_idle = CoinGetTimeOfDay();
 		DSPdebugMessage("Rank %d calls MPI_Gatherv.\n", comm_rank_);
-		MPI_Gatherv(NULL, 0, MPI_DOUBLE, recvbuf, rcounts, rdispls, MPI_DOUBLE, 0, subcomm_);
+		if (parOverlap_)
+		{
+			/** The gather is usually posted right after the scatter of the previous iteration. */
+			if (gather_req == MPI_REQUEST_NULL)
+				MPI_Igatherv(NULL, 0, MPI_DOUBLE, recvbuf, rcounts, rdispls, MPI_DOUBLE, 0, subcomm_, &gather_req);
+			MPI_Wait(&scatter_req, MPI_STATUS_IGNORE);
+			MPI_Wait(&gather_req, MPI_STATUS_IGNORE);
+		}
+		else
+			MPI_Gatherv(NULL, 0, MPI_DOUBLE, recvbuf, rcounts, rdispls, MPI_DOUBLE, 0, subcomm_);
 		mt_idle += CoinGetTimeOfDay() - mts_idle;
+		DSP_PROFILE_TIME("dd/master_wait", CoinGetTimeOfDay() - mts_idle);
 
 		DSPdebugMessage2("master receive buffer:\n");
 		DSPdebug2(for (int i = 0; i < subcomm_size_; ++i) {
@@ -369,7 +399,7 @@ DSP_RTN_CODE DdMWSync::runMaster()
 				master->subprimobj_[sindex] = recvbuf[pos++];
 				master->subdualobj_[sindex] = recvbuf[pos++];
 				CoinCopyN(recvbuf + pos,
-						nsubsolution[s], master->subsolution_[sindex]);
+						nsubsolution[sindex], master->subsolution_[sindex]);
 				pos += nsubsolution[sindex];
 				DSPdebugMessage("-> master, subprob %d primobj %+e\n", sindex, master->subprimobj_[sindex]);
 			}
@@ -382,6 +412,7 @@ DSP_RTN_CODE DdMWSync::runMaster()
 			DSP_RTN_CHECK_THROW(setCouplingSolutions(stored));
 			/** clear stored solutions */
 			stored.clear();
+			ubSolutions_.release();
 			/** sync Benders cut information */
 			cg_status = syncBendersInfo(stored, cuts);
 			/** resolve subproblems? */
@@ -391,8 +422,8 @@ DSP_RTN_CODE DdMWSync::runMaster()
 				DSPdebugMessage("Rank %d: resolve subproblems.\n", comm_rank_);
 				continue;
 			}
-			/** collect upper bounds */
-			if (cg_status == DSP_STAT_MW_CONTINUE)
+			/** collect upper bounds; deferred until after the master solve when overlapping */
+			if (cg_status == DSP_STAT_MW_CONTINUE && !parOverlap_)
 			  syncUpperbound(dummy_solutions, dummy_double_array);
 		}
 
@@ -430,12 +461,26 @@ DSP_RTN_CODE DdMWSync::runMaster()
 			double tic = CoinGetTimeOfDay();
 			master_->solve();
 			mt_solve += CoinGetTimeOfDay() - tic;
+			DSP_PROFILE_TIME("dd/master_solve", CoinGetTimeOfDay() - tic);
 			DSPdebugMessage("Rank %d solved the master (%.2f sec).\n", comm_rank_, CoinGetTimeOfDay() - tic);
+		}
 
-			/** termination test */
-			signal = master_->terminationTest();
+		/** collect upper bounds that the workers evaluated while the master was solving */
+		if (parOverlap_ && parEvalUb_ >= 0 && cg_status == DSP_STAT_MW_CONTINUE)
+		{
+			/** the iteration info is already printed; report improvement in the next one */
+			itercode_ = ' ';
+			mts_idle = CoinGetTimeOfDay();
+			syncUpperbound(dummy_solutions, dummy_double_array);
+			mt_idle += CoinGetTimeOfDay() - mts_idle;
+			DSP_PROFILE_TIME("dd/master_wait", CoinGetTimeOfDay() - mts_idle);
+			pending_itercode = itercode_;
 		}
 
+		/** termination test */
+		if (signal != DSP_STAT_MW_STOP)
+			signal = master_->terminationTest();
+
 		/** broadcast signal */
 		MPI_Bcast(&signal, 1, MPI_INT, 0, comm_);
 		if (signal == DSP_STAT_MW_STOP) break;
@@ -443,6 +488,18 @@ DSP_RTN_CODE DdMWSync::runMaster()
 		/** increment iteration count */
 		itercnt_++;
 
+		/** rebalance the subproblems at the iteration boundary */
+		if (parRebalanceFreq_ > 0 && cg_status == DSP_STAT_MW_CONTINUE && itercnt_ % parRebalanceFreq_ == 0)
+		{
+			bool rebalanced = false;
+			DSP_RTN_CHECK_THROW(rebalance(rebalanced));
+			if (rebalanced)
+				setBuffers();
+		}
+
+		/** write checkpoint */
+		DSP_RTN_CHECK_THROW(writeCheckpoint());
+
 		/** retrieve master solution by part */
 		double * master_primsol = const_cast<double*>(master_->getPrimalSolution());
 		thetas = master_primsol;
@@ -483,9 +540,20 @@ DSP_RTN_CODE DdMWSync::runMaster()
 		/** scatter message */
 		if (parEvalUb_ >= 0)
 			MPI_Bcast(&(master_->bestprimobj_), 1, MPI_DOUBLE, 0, subcomm_);
-		MPI_Scatterv(sendbuf, scounts, sdispls, MPI_DOUBLE, NULL, 0, MPI_DOUBLE, 0, subcomm_);
+		if (parOverlap_)
+		{
+			MPI_Iscatterv(sendbuf, scounts, sdispls, MPI_DOUBLE, NULL, 0, MPI_DOUBLE, 0, subcomm_, &scatter_req);
+			/** post the gather for the next iteration right away */
+			MPI_Igatherv(NULL, 0, MPI_DOUBLE, recvbuf, rcounts, rdispls, MPI_DOUBLE, 0, subcomm_, &gather_req);
+		}
+		else
+			MPI_Scatterv(sendbuf, scounts, sdispls, MPI_DOUBLE, NULL, 0, MPI_DOUBLE, 0, subcomm_);
 	}
 
+	/** complete any outstanding communication before reusing the buffers */
+	MPI_Wait(&scatter_req, MPI_STATUS_IGNORE);
+	MPI_Wait(&gather_req, MPI_STATUS_IGNORE);
+
 	if (parEvalUb_ >= 0 && model_->isStochastic()) {
 		TssModel* tss = dynamic_cast<TssModel*>(model_);
 		double *bestcouplingsol = NULL;
@@ -518,9 +586,15 @@ DSP_RTN_CODE DdMWSync::runMaster()
 		DSPdebug2(DspMessage::printArray(model_->getFullModelNumCols(), &master_->bestprimsol_[0]));
 	}
 
+	/** collect worker idle times */
+	double wt_idle_max = 0.0;
+	double wt_idle_avg = 0.0;
+	reduceIdleTimes(0.0, wt_idle_max, wt_idle_avg);
+
 	/** get total time spend in the master */
 	mt_total += CoinGetTimeOfDay() - mts_total;
 	message_->print(0, "Master timing results: total %.2f, solve %.2f, idle %.2f\n", mt_total, mt_solve, mt_idle);
+	message_->print(0, "Worker idle time: max %.2f, avg %.2f\n", wt_idle_max, wt_idle_avg);
 
 	END_TRY_CATCH_RTN(FREE_MEMORY,DSP_RTN_ERR)
 
@@ -563,6 +637,10 @@ DSP_RTN_CODE DdMWSync::runWorker()
 
 	int * nsubsolution = NULL; /**< size of solution to send */
 
+	/** nonblocking requests used for overlapping */
+	MPI_Request gather_req = MPI_REQUEST_NULL;  /**< MPI_Igatherv request */
+	MPI_Request scatter_req = MPI_REQUEST_NULL; /**< MPI_Iscatterv request */
+
 	OsiCuts cuts, emptycuts;
 	DSP_RTN_CODE cg_status = DSP_STAT_MW_CONTINUE;
 
@@ -600,30 +678,45 @@ DSP_RTN_CODE DdMWSync::runWorker()
 		DSPdebugMessage("Rank %d runs DdWorkerLB.\n", comm_rank_);
 	}
 
-	nsubsolution = new int [narrprocidx];
-	if (model_->isDro()) {
-		for (int s = 0; s < narrprocidx; ++s)
-			nsubsolution[s] = workerlb->subprobs_[s]->getNumCols();
-	} else {
-		for (int s = 0; s < narrprocidx; ++s)
-			nsubsolution[s] = workerlb->subprobs_[s]->ncols_coupling_;
-	}
-	// DSPdebugMessage("Worker %d:\n", comm_rank_);
-	// DSPdebug(message_->printArray(narrprocidx, nsubsolution));
-
-	/** calculate size of send buffer */
-	for (int i = 0; i < narrprocidx; ++i)
-		scount += 3 + nsubsolution[i];
+	/** set the message buffers for the subproblems of this rank (called again after rebalancing) */
+	auto setBuffers = [&]() {
+		narrprocidx = par_->getIntPtrParamSize("ARR_PROC_IDX");
+		arrprocidx = par_->getIntPtrParam("ARR_PROC_IDX");
+
+		FREE_ARRAY_PTR(nsubsolution)
+		nsubsolution = new int [narrprocidx];
+		if (model_->isDro()) {
+			for (int s = 0; s < narrprocidx; ++s)
+				nsubsolution[s] = workerlb->subprobs_[s]->getNumCols();
+		} else {
+			for (int s = 0; s < narrprocidx; ++s)
+				nsubsolution[s] = workerlb->subprobs_[s]->ncols_coupling_;
+		}
+		// DSPdebugMessage("Worker %d:\n", comm_rank_);
+		// DSPdebug(message_->printArray(narrprocidx, nsubsolution));
+
+		/** calculate size of send buffer */
+		scount = 0;
+		for (int i = 0; i < narrprocidx; ++i)
+			scount += 3 + nsubsolution[i];
+
+		/** calculate size of receive buffer */
+		rcount = 0;
+		for (int i = 0; i < narrprocidx; ++i)
+			rcount += 1 + model_->getNumSubproblemCouplingRows(arrprocidx[i]);
+		if (model_->isStochastic())
+			rcount += narrprocidx;
 
-	/** calculate size of receive buffer */
-	for (int i = 0; i < narrprocidx; ++i)
-		rcount += 1 + model_->getNumSubproblemCouplingRows(arrprocidx[i]);
-	if (model_->isStochastic())
-		rcount += narrprocidx;
+		/** allocate memory for message buffers */
+		FREE_ARRAY_PTR(sendbuf)
+		FREE_ARRAY_PTR(recvbuf)
+		sendbuf = new double [scount];
+		recvbuf = new double [rcount];
+	};
+	if (workerlb)
+		setBuffers();
 
-	/** allocate memory for message buffers */
-	sendbuf = new double [scount];
-	recvbuf = new double [rcount];
+	int itercnt = itercnt_; /**< iteration count to match the master */
 
 	/** solutions to derive Benders cuts and evaluate upper bounds */
 	Solutions solutions;
@@ -640,6 +733,13 @@ DSP_RTN_CODE DdMWSync::runWorker()
 			sts_lb = CoinGetTimeOfDay();
 			workerlb->solve();
 			time_lb_.push_back(CoinGetTimeOfDay() - sts_lb);
+			DSP_PROFILE_TIME("dd/worker_lb", CoinGetTimeOfDay() - sts_lb);
+
+			/** the send buffer of the previous gather should be free by now */
+			sts_idle = CoinGetTimeOfDay();
+			MPI_Wait(&gather_req, MPI_STATUS_IGNORE);
+			st_idle += CoinGetTimeOfDay() - sts_idle;
+			DSP_PROFILE_TIME("dd/worker_wait", CoinGetTimeOfDay() - sts_idle);
 
 			/** create send buffer */
 			for (int s = 0, pos = 0; s < narrprocidx; ++s)
@@ -666,7 +766,10 @@ DSP_RTN_CODE DdMWSync::runWorker()
 			}
 #endif
 			/** send message to the master */
-			MPI_Gatherv(sendbuf, scount, MPI_DOUBLE, NULL, NULL, NULL, MPI_DOUBLE, 0, subcomm_);
+			if (parOverlap_)
+				MPI_Igatherv(sendbuf, scount, MPI_DOUBLE, NULL, NULL, NULL, MPI_DOUBLE, 0, subcomm_, &gather_req);
+			else
+				MPI_Gatherv(sendbuf, scount, MPI_DOUBLE, NULL, NULL, NULL, MPI_DOUBLE, 0, subcomm_);
 		}
 
 		/** We may generate Benders-type cuts and find upper bounds */
@@ -679,15 +782,20 @@ DSP_RTN_CODE DdMWSync::runWorker()
 			sts_cg = CoinGetTimeOfDay();
 			cg_status = syncBendersInfo(solutions, cuts);
 			st_cg += CoinGetTimeOfDay() - sts_cg;
+			DSP_PROFILE_TIME("dd/worker_cg", CoinGetTimeOfDay() - sts_cg);
 
-			/** calculate and sync upper bounds */
+			/** calculate and sync upper bounds; this overlaps the master solve if enabled */
 			if (cg_status == DSP_STAT_MW_CONTINUE)
 			{
 				sts_ub = CoinGetTimeOfDay();
 				vector<double> upperbounds;
 				DSP_RTN_CHECK_THROW(calculateUpperbound(solutions, upperbounds));
-				DSP_RTN_CHECK_THROW(syncUpperbound(solutions, upperbounds));
 				st_ub += CoinGetTimeOfDay() - sts_ub;
+				DSP_PROFILE_TIME("dd/worker_ub", CoinGetTimeOfDay() - sts_ub);
+				sts_idle = CoinGetTimeOfDay();
+				DSP_RTN_CHECK_THROW(syncUpperbound(solutions, upperbounds));
+				st_idle += CoinGetTimeOfDay() - sts_idle;
+				DSP_PROFILE_TIME("dd/worker_wait", CoinGetTimeOfDay() - sts_idle);
 			}
 
 			/** free solutions */
@@ -697,10 +805,25 @@ DSP_RTN_CODE DdMWSync::runWorker()
 		}
 
 		/** receive signal from the master */
+		sts_idle = CoinGetTimeOfDay();
 		MPI_Bcast(&signal, 1, MPI_INT, 0, comm_);
+		st_idle += CoinGetTimeOfDay() - sts_idle;
+		DSP_PROFILE_TIME("dd/worker_wait", CoinGetTimeOfDay() - sts_idle);
 		DSPdebugMessage2("Rank %d received signal %d.\n", comm_rank_, signal);
 		SIG_BREAK;
 
+		/** rebalance the subproblems at the iteration boundary */
+		itercnt++;
+		if (parRebalanceFreq_ > 0 && cg_status == DSP_STAT_MW_CONTINUE && itercnt % parRebalanceFreq_ == 0)
+		{
+			/** the send buffer of the last gather is released */
+			MPI_Wait(&gather_req, MPI_STATUS_IGNORE);
+			bool rebalanced = false;
+			DSP_RTN_CHECK_THROW(rebalance(rebalanced));
+			if (rebalanced && workerlb)
+				setBuffers();
+		}
+
 		if (lb_comm_ != MPI_COMM_NULL)
 		{
 			/** move cuts to a global pool */
@@ -722,8 +845,15 @@ DSP_RTN_CODE DdMWSync::runWorker()
 
 				/** receive message from the master */
 				sts_idle = CoinGetTimeOfDay();
-				MPI_Scatterv(NULL, NULL, NULL, MPI_DOUBLE, recvbuf, rcount, MPI_DOUBLE, 0, subcomm_);
+				if (parOverlap_)
+				{
+					MPI_Iscatterv(NULL, NULL, NULL, MPI_DOUBLE, recvbuf, rcount, MPI_DOUBLE, 0, subcomm_, &scatter_req);
+					MPI_Wait(&scatter_req, MPI_STATUS_IGNORE);
+				}
+				else
+					MPI_Scatterv(NULL, NULL, NULL, MPI_DOUBLE, recvbuf, rcount, MPI_DOUBLE, 0, subcomm_);
 				st_idle += CoinGetTimeOfDay() - sts_idle;
+				DSP_PROFILE_TIME("dd/worker_wait", CoinGetTimeOfDay() - sts_idle);
 				DSPdebugMessage("Worker received message (%d):\n", rcount);
 				DSPdebug(message_->printArray(rcount, recvbuf));
 
@@ -762,6 +892,9 @@ DSP_RTN_CODE DdMWSync::runWorker()
 		}
 	}
 
+	/** the last gather was completed by the master before the stop signal */
+	MPI_Wait(&gather_req, MPI_STATUS_IGNORE);
+
 	/** This does the post-solve processing
 	 * in order to return the best feasible solution.
 	 */
@@ -804,6 +937,10 @@ DSP_RTN_CODE DdMWSync::runWorker()
 	/** release pointers */
 	arrprocidx = NULL;
 
+	/** report idle time to the master */
+	double dummy_max, dummy_avg;
+	reduceIdleTimes(lb_comm_ != MPI_COMM_NULL ? st_idle : 0.0, dummy_max, dummy_avg);
+
 	st_total += CoinGetTimeOfDay() - sts_total;
 
 	END_TRY_CATCH_RTN(FREE_MEMORY,DSP_RTN_ERR)
@@ -815,6 +952,165 @@ DSP_RTN_CODE DdMWSync::runWorker()
 #undef FREE_MEMORY
 }
 
+DSP_RTN_CODE DdMWSync::restart()
+{
+	int rtn = DSP_RTN_OK;
+	int size = 0;
+	double bestprimobj = COIN_DBL_MAX;
+	vector<double> trialpoint;
+	vector<int> displs(model_->getNumSubproblems() + 1, 0);
+
+	BGN_TRY_CATCH
+
+	if (comm_rank_ == 0)
+	{
+		rtn = isRestart() ? readCheckpoint() : setInitialMultipliers();
+		if (rtn == DSP_RTN_OK)
+		{
+			packTrialPoint(trialpoint, displs);
+			size = trialpoint.size();
+			bestprimobj = master_->bestprimobj_;
+		}
+	}
+	MPI_Bcast(&rtn, 1, MPI_INT, 0, comm_);
+	DSP_RTN_CHECK_THROW(rtn);
+
+	/** The subproblems start from the restored master solution. */
+	MPI_Bcast(&itercnt_, 1, MPI_INT, 0, comm_);
+	MPI_Bcast(&size, 1, MPI_INT, 0, comm_);
+	trialpoint.resize(size);
+	MPI_Bcast(trialpoint.data(), size, MPI_DOUBLE, 0, comm_);
+	MPI_Bcast(displs.data(), displs.size(), MPI_INT, 0, comm_);
+	MPI_Bcast(&bestprimobj, 1, MPI_DOUBLE, 0, comm_);
+	if (lb_comm_ != MPI_COMM_NULL)
+		DSP_RTN_CHECK_THROW(applyTrialPoint(dynamic_cast<DdWorkerLB*>(worker_[0]), trialpoint, displs, bestprimobj));
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DdMWSync::createBoundingWorkers()
+{
+	BGN_TRY_CATCH
+
+	/** create CG worker */
+	if (parFeasCuts_ >= 0 || parOptCuts_ >= 0)
+	{
+#ifdef DSP_HAS_SCIP
+		DSPdebugMessage("Rank %d creates a worker for Benders cut generation.\n", comm_rank_);
+		worker_.push_back(new DdWorkerCGBd(model_, par_, message_));
+		DSP_RTN_CHECK_THROW(worker_.back()->init());
+#endif
+	}
+	/** create UB worker */
+	if (parEvalUb_ >= 0)
+	{
+		DSPdebugMessage("Rank %d creates a worker for upper bounds.\n", comm_rank_);
+		if (model_->isDro())
+			worker_.push_back(new DdDroWorkerUBMpi(lb_comm_, model_, par_, message_));
+		else
+			worker_.push_back(new DdWorkerUB(model_, par_, message_));
+		DSP_RTN_CHECK_THROW(worker_.back()->init());
+	}
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DdMWSync::rebalance(bool & rebalanced)
+{
+	rebalanced = false;
+
+	BGN_TRY_CATCH
+
+	int nsubprobs = model_->getNumSubproblems();
+	int nassigned = 0;
+	for (int i = 0; i < comm_size_; ++i)
+		nassigned += nsubprobs_[i];
+
+	/** retrieve DdWorkerLB */
+	DdWorkerLB * workerlb = NULL;
+	if (lb_comm_ != MPI_COMM_NULL)
+		workerlb = dynamic_cast<DdWorkerLB*>(worker_[0]);
+
+	/** gather the solution times accumulated since the last rebalancing */
+	vector<double> times(nsubprobs_[comm_rank_], 0.0);
+	if (workerlb)
+	{
+		for (int s = 0; s < nsubprobs_[comm_rank_]; ++s)
+			times[s] = workerlb->subtimes_[s];
+		workerlb->subtimes_.assign(workerlb->subtimes_.size(), 0.0);
+	}
+	vector<double> alltimes(nassigned, 0.0);
+	MPI_Allgatherv(times.data(), nsubprobs_[comm_rank_], MPI_DOUBLE,
+			alltimes.data(), nsubprobs_, subprob_displs_, MPI_DOUBLE, comm_);
+
+	/** The LB workers are ranks 1 to lb_comm_size_. */
+	vector<double> subtimes(nsubprobs, 0.0);
+	vector<int> owners(nsubprobs, -1);
+	vector<int> newowners;
+	for (int i = 1; i <= lb_comm_size_; ++i)
+		for (int j = 0; j < nsubprobs_[i]; ++j)
+		{
+			int sind = subprob_indices_[subprob_displs_[i] + j];
+			subtimes[sind] = alltimes[subprob_displs_[i] + j];
+			owners[sind] = i - 1;
+		}
+
+	/** Every rank computes the same assignment from the same times. */
+	double imbalance = DspLoadImbalance(lb_comm_size_, subtimes, owners);
+	int nmoves = 0;
+	if (imbalance > 1.0 + parRebalanceTol_)
+		nmoves = DspLoadAssign(lb_comm_size_, subtimes, owners, parRebalanceTol_, newowners);
+	if (nmoves == 0)
+		return DSP_RTN_OK;
+
+	/** The CG and UB workers depend on the subproblem indices and are recreated. */
+	for (unsigned i = 1; i < worker_.size(); ++i)
+	{
+		worker_[i]->finalize();
+		FREE_PTR(worker_[i]);
+	}
+	if (worker_.size() > 1)
+		worker_.resize(1);
+
+	/** update the subproblem indices of all the ranks */
+	for (int i = 0; i < comm_size_; ++i)
+		nsubprobs_[i] = 0;
+	for (int s = 0; s < nsubprobs; ++s)
+		nsubprobs_[newowners[s] + 1]++;
+	for (int i = 0; i < comm_size_; ++i)
+		subprob_displs_[i] = i == 0 ? 0 : subprob_displs_[i-1] + nsubprobs_[i-1];
+	vector<int> pos(subprob_displs_, subprob_displs_ + comm_size_);
+	for (int s = 0; s < nsubprobs; ++s)
+		subprob_indices_[pos[newowners[s] + 1]++] = s;
+
+	/** set parameters */
+	par_->setIntPtrParamSize("ARR_PROC_IDX", nsubprobs_[comm_rank_]);
+	for (int s = 0; s < nsubprobs_[comm_rank_]; ++s)
+		par_->setIntPtrParam("ARR_PROC_IDX", s, subprob_indices_[subprob_displs_[comm_rank_] + s]);
+
+	if (workerlb)
+	{
+		/** move the subproblems */
+		DSP_RTN_CHECK_THROW(workerlb->migrateProblem(
+			par_->getIntPtrParamSize("ARR_PROC_IDX"), par_->getIntPtrParam("ARR_PROC_IDX")));
+		DSP_RTN_CHECK_THROW(createBoundingWorkers());
+	}
+
+	rebalanced = true;
+	DSP_PROFILE_COUNT("dd/rebalance_moves", nmoves);
+	if (comm_rank_ == 0)
+		message_->print(1, "Rebalanced subproblems: %d moved, load imbalance %.2f -> %.2f\n",
+				nmoves, imbalance, DspLoadImbalance(lb_comm_size_, subtimes, newowners));
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
 /** broadcast coupling solutions */
 DSP_RTN_CODE DdMWSync::bcastCouplingSolutions(
 		Solutions & solutions /**< solutions to broadcast */)
@@ -1144,3 +1440,19 @@ DSP_RTN_CODE DdMWSync::scatterCouplingSolutions(Solutions & solutions) {
 
 	return signal;
 }
+
+void DdMWSync::reduceIdleTimes(
+		double   idle,    /**< idle time of this process */
+		double & maxidle, /**< maximum idle time over workers (master only) */
+		double & avgidle  /**< average idle time over workers (master only) */) {
+
+	/** idle time and the number of workers contributing */
+	double sendbuf[2] = {idle, lb_comm_ != MPI_COMM_NULL ? 1.0 : 0.0};
+	double recvbuf[2] = {0.0, 0.0};
+
+	MPI_Reduce(&idle, &maxidle, 1, MPI_DOUBLE, MPI_MAX, 0, comm_);
+	MPI_Reduce(sendbuf, recvbuf, 2, MPI_DOUBLE, MPI_SUM, 0, comm_);
+
+	if (comm_rank_ == 0)
+		avgidle = recvbuf[1] > 0 ? recvbuf[0] / recvbuf[1] : 0.0;
+}
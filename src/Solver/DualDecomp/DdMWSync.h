@@ -76,6 +76,36 @@ private:
 	DSP_RTN_CODE scatterCouplingSolutions(
 			Solutions & solutions /**< received solution placeholder */);
 
+	/**
+	 * This restores the master from the checkpoint (or sets the initial multipliers)
+	 * and sends the master solution to the LB workers as the first trial point. This
+	 * should be called by all the ranks.
+	 */
+	DSP_RTN_CODE restart();
+
+	/** create the CG and UB workers for the subproblems of this rank */
+	DSP_RTN_CODE createBoundingWorkers();
+
+	/**
+	 * This reassigns the subproblems to the LB workers by the solution times measured
+	 * since the last call, if the load imbalance exceeds DD/REBALANCE/TOL. A subproblem
+	 * moved to another rank is recreated from the model there, and the CG and UB workers
+	 * are recreated for the new subproblem indices. This should be called by all the
+	 * ranks at the same iteration.
+	 */
+	DSP_RTN_CODE rebalance(
+			bool & rebalanced /**< [out] whether any subproblem has moved */);
+
+	/** reduce worker idle times to the master */
+	void reduceIdleTimes(
+			double   idle,    /**< idle time of this process */
+			double & maxidle, /**< maximum idle time over workers (master only) */
+			double & avgidle  /**< average idle time over workers (master only) */);
+
+	bool parOverlap_; /**< overlap the master solve with upper bounding */
+	int parRebalanceFreq_;    /**< number of iterations between rebalancing (0 to disable) */
+	double parRebalanceTol_;  /**< load imbalance tolerance for rebalancing */
+
 	std::vector<double> time_lb_;
 };
 
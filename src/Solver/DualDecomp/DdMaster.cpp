@@ -13,6 +13,7 @@
 #include "SolverInterface/DspOsiGrb.h"
 #include "SolverInterface/DspOsiScip.h"
 #include "SolverInterface/DspOsiOoqp.h"
+#include "Utility/DspCheckpoint.h"
 
 DdMaster::DdMaster(DecModel *model, DspParams *par, DspMessage *message)
 	: DecSolver(model, par, message),
@@ -144,3 +145,52 @@ const double *DdMaster::getLambda(int s)
 		j += model_->getNumSubproblemCouplingRows(i);
 	return lambda_.data() + j;
 }
+
+DSP_RTN_CODE DdMaster::writeCheckpoint(std::ostream & os) {
+	BGN_TRY_CATCH
+
+	DspCheckpointWrite(os, "primobj", primobj_);
+	DspCheckpointWrite(os, "bestprimobj", bestprimobj_);
+	DspCheckpointWrite(os, "bestdualobj", bestdualobj_);
+	DspCheckpointWrite(os, "primsol", primsol_);
+	DspCheckpointWrite(os, "lambda", lambda_);
+	DspCheckpointWrite(os, "bestprimsol", bestprimsol_);
+	DspCheckpointWrite(os, "bestdualsol", bestdualsol_);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DdMaster::setInitialMultipliers(const double * lambda) {
+	message_->print(0, "Warning: The master does not support initial multipliers, which are ignored.\n");
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DdMaster::readCheckpoint(std::istream & is) {
+	std::vector<double> primsol, lambda, bestprimsol, bestdualsol;
+
+	BGN_TRY_CATCH
+
+	DspCheckpointRead(is, "primobj", primobj_);
+	DspCheckpointRead(is, "bestprimobj", bestprimobj_);
+	DspCheckpointRead(is, "bestdualobj", bestdualobj_);
+	DspCheckpointRead(is, "primsol", primsol);
+	DspCheckpointRead(is, "lambda", lambda);
+	DspCheckpointRead(is, "bestprimsol", bestprimsol);
+	DspCheckpointRead(is, "bestdualsol", bestdualsol);
+
+	/** The checkpoint should be written for the same model. */
+	if (primsol.size() != primsol_.size() || lambda.size() != (unsigned) model_->getNumCouplingRows() ||
+			bestprimsol.size() != bestprimsol_.size() || bestdualsol.size() != bestdualsol_.size())
+		throw CoinError("The checkpoint does not match the model", "readCheckpoint", "DdMaster");
+
+	primsol_.swap(primsol);
+	lambda_.swap(lambda);
+	bestprimsol_.swap(bestprimsol);
+	bestdualsol_.swap(bestdualsol);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
@@ -61,6 +61,21 @@ public:
 	/** Return lambda for subproblem index s */
 	virtual const double *getLambda(int s);
 
+	/** write the master state to a checkpoint */
+	virtual DSP_RTN_CODE writeCheckpoint(std::ostream & os);
+
+	/**
+	 * restore the master state from a checkpoint; this should be called after init().
+	 * The master solution is restored as the next trial point to evaluate.
+	 */
+	virtual DSP_RTN_CODE readCheckpoint(std::istream & is);
+
+	/**
+	 * set the Lagrangian multipliers of the coupling rows (size: number of coupling rows)
+	 * as the next trial point; this should be called after init().
+	 */
+	virtual DSP_RTN_CODE setInitialMultipliers(const double * lambda);
+
 protected:
 
 	/** create DspOsi for master */
@@ -7,6 +7,7 @@
 
 #include "Model/DecTssModel.h"
 #include "Solver/DualDecomp/DdMasterSubgrad.h"
+#include "Utility/DspCheckpoint.h"
 
 DdMasterSubgrad::DdMasterSubgrad(
 		DecModel *   model,  /**< model pointer */
@@ -174,3 +175,44 @@ DSP_RTN_CODE DdMasterSubgrad::updateProblem()
 
 	return DSP_RTN_OK;
 }
+
+DSP_RTN_CODE DdMasterSubgrad::writeCheckpoint(std::ostream & os)
+{
+	BGN_TRY_CATCH
+
+	DSP_RTN_CHECK_THROW(DdMaster::writeCheckpoint(os));
+	DspCheckpointWrite(os, "multipliers",
+			std::vector<double>(multipliers_, multipliers_ + model_->getNumCouplingRows()));
+	DspCheckpointWrite(os, "gradient",
+			std::vector<double>(gradient_, gradient_ + model_->getNumCouplingRows()));
+	DspCheckpointWrite(os, "nstalls", nstalls_);
+	DspCheckpointWrite(os, "stepscal", stepscal_);
+	DspCheckpointWrite(os, "stepsize", stepsize_);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DdMasterSubgrad::readCheckpoint(std::istream & is)
+{
+	std::vector<double> multipliers, gradient;
+
+	BGN_TRY_CATCH
+
+	DSP_RTN_CHECK_THROW(DdMaster::readCheckpoint(is));
+	DspCheckpointRead(is, "multipliers", multipliers);
+	DspCheckpointRead(is, "gradient", gradient);
+	DspCheckpointRead(is, "nstalls", nstalls_);
+	DspCheckpointRead(is, "stepscal", stepscal_);
+	DspCheckpointRead(is, "stepsize", stepsize_);
+	if (multipliers.size() != (unsigned) model_->getNumCouplingRows() ||
+			gradient.size() != (unsigned) model_->getNumCouplingRows())
+		throw CoinError("The checkpoint does not match the model", "readCheckpoint", "DdMasterSubgrad");
+	CoinCopyN(&multipliers[0], multipliers.size(), multipliers_);
+	CoinCopyN(&gradient[0], gradient.size(), gradient_);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
@@ -43,6 +43,12 @@ public:
 	/** get number of lambdas */
 	virtual int getNumLambdas() {return model_->getNumCouplingRows();}
 
+	/** write the master state with the multipliers and the step size rule to a checkpoint */
+	virtual DSP_RTN_CODE writeCheckpoint(std::ostream & os);
+
+	/** restore the master state */
+	virtual DSP_RTN_CODE readCheckpoint(std::istream & is);
+
 protected:
 
 	/** create problem */
@@ -15,6 +15,7 @@
 #include "SolverInterface/DspOsiOoqpEps.h"
 #include "Solver/DualDecomp/DdMasterTr.h"
 #include "Model/TssModel.h"
+#include "Utility/DspCheckpoint.h"
 
 DdMasterTr::DdMasterTr(
 		DecModel *   model,   /**< model pointer */
@@ -52,6 +53,7 @@ DdMaster(rhs),
 nthetas_(rhs.nthetas_),
 nlambdas_(rhs.nlambdas_),
 nus_(rhs.nus_),
+u_start_(rhs.u_start_),
 nPs_(rhs.nPs_),
 obj_reco_(rhs.obj_reco_),
 stability_param_(rhs.stability_param_),
@@ -256,7 +258,12 @@ DSP_RTN_CODE DdMasterTr::createProblem()
 
 	/** Additional dual variables for DRO */
 	if (model_->isDro()) {
-		nus_ = model_->getNumSubproblems() * model_->getNumReferences();
+		/** one u for each transport pair kept in the (sparsified) ambiguity set */
+		u_start_.resize(model_->getNumSubproblems() + 1);
+		u_start_[0] = 0;
+		for (j = 0; j < model_->getNumSubproblems(); ++j)
+			u_start_[j+1] = u_start_[j] + model_->getWassersteinPairs(j)->getNumElements();
+		nus_ = u_start_.back();
 		nPs_ = model_->getNumSubproblems();
 	}
 
@@ -271,8 +278,9 @@ DSP_RTN_CODE DdMasterTr::createProblem()
 		if (model_->isDro()) {
 			nrows += 1 + model_->getNumReferences() + model_->getNumSubproblems();
 			for (i = 0; i < model_->getNumSubproblems(); ++i) {
-				for (j = 0; j < model_->getNumReferences(); ++j) {
-					if (fabs(model_->getWassersteinDist(j,i)) < 1e-10) continue;
+				const CoinPackedVector * pairs = model_->getWassersteinPairs(i);
+				for (j = 0; j < pairs->getNumElements(); ++j) {
+					if (fabs(pairs->getElements()[j]) < 1e-10) continue;
 					nzcnt++;
 				}
 			}
@@ -339,12 +347,14 @@ DSP_RTN_CODE DdMasterTr::createProblem()
 			/** stability center for DRO model */
 			if (model_->isDro())
 			{
-				for (i = 0; i < model_->getNumReferences(); ++i) {
-					for (j = 0; j < model_->getNumSubproblems(); ++j) {
+				for (j = 0; j < model_->getNumSubproblems(); ++j) {
+					const CoinPackedVector * pairs = model_->getWassersteinPairs(j);
+					for (k = 0; k < pairs->getNumElements(); ++k) {
+						i = pairs->getIndices()[k];
 						if (i == j)
-							stability_center_[nlambdas_+model_->getNumReferences()*j+i] = model_->getReferenceProbability(i);
+							stability_center_[nlambdas_+u_start_[j]+k] = model_->getReferenceProbability(i);
 						else
-							stability_center_[nlambdas_+model_->getNumReferences()*j+i] = 0.0;
+							stability_center_[nlambdas_+u_start_[j]+k] = 0.0;
 					}
 				}
 				for (i = 0; i < nPs_; ++i) {
@@ -401,11 +411,9 @@ DSP_RTN_CODE DdMasterTr::createProblem()
 		if (model_->isDro()) {
 
 			/** additional column bounds for DRO */
-			for (i = 0; i < model_->getNumReferences(); ++i) {
-				for (j = 0; j < model_->getNumSubproblems(); ++j) {
-					clbd[nthetas_+nlambdas_+model_->getNumReferences()*j+i] = CoinMax(0.0, stability_center_[nlambdas_+model_->getNumReferences()*j+i] - stability_param_);
-					cubd[nthetas_+nlambdas_+model_->getNumReferences()*j+i] = CoinMin(1.0, stability_center_[nlambdas_+model_->getNumReferences()*j+i] + stability_param_);
-				}
+			for (i = 0; i < nus_; ++i) {
+				clbd[nthetas_+nlambdas_+i] = CoinMax(0.0, stability_center_[nlambdas_+i] - stability_param_);
+				cubd[nthetas_+nlambdas_+i] = CoinMin(1.0, stability_center_[nlambdas_+i] + stability_param_);
 			}
 			for (i = 0; i < nPs_; ++i) {
 				clbd[nthetas_+nlambdas_+nus_+i] = CoinMax(0.0, stability_center_[nlambdas_+nus_+i] - stability_param_);
@@ -420,10 +428,11 @@ DSP_RTN_CODE DdMasterTr::createProblem()
 
 			bgn[rpos] = pos;
 			for (i = 0; i < model_->getNumSubproblems(); ++i) {
-				for (j = 0; j < model_->getNumReferences(); ++j) {
-					if (fabs(model_->getWassersteinDist(j,i)) < 1e-10) continue;
-					ind[pos] = nthetas_ + nlambdas_ + i * model_->getNumReferences() + j;
-					elem[pos] = model_->getWassersteinDist(j,i);
+				const CoinPackedVector * pairs = model_->getWassersteinPairs(i);
+				for (j = 0; j < pairs->getNumElements(); ++j) {
+					if (fabs(pairs->getElements()[j]) < 1e-10) continue;
+					ind[pos] = nthetas_ + nlambdas_ + u_start_[i] + j;
+					elem[pos] = pairs->getElements()[j];
 					pos++;
 				}
 			}
@@ -431,13 +440,19 @@ DSP_RTN_CODE DdMasterTr::createProblem()
 			rpos++;
 
 			// u's
+			std::vector<std::vector<int> > refpairs(model_->getNumReferences());
+			for (j = 0; j < model_->getNumSubproblems(); ++j) {
+				const CoinPackedVector * pairs = model_->getWassersteinPairs(j);
+				for (k = 0; k < pairs->getNumElements(); ++k)
+					refpairs[pairs->getIndices()[k]].push_back(u_start_[j] + k);
+			}
 			for (i = 0; i < model_->getNumReferences(); ++i) {
 				rlbd[rpos] = model_->getReferenceProbability(i);
 				rubd[rpos] = model_->getReferenceProbability(i);
 
 				bgn[rpos] = pos;
-				for (j = 0; j < model_->getNumSubproblems(); ++j) {
-					ind[pos] = nthetas_ + nlambdas_ + j * model_->getNumReferences() + i;
+				for (j = 0; j < (int) refpairs[i].size(); ++j) {
+					ind[pos] = nthetas_ + nlambdas_ + refpairs[i][j];
 					elem[pos] = 1.0;
 					pos++;
 				}
@@ -451,8 +466,8 @@ DSP_RTN_CODE DdMasterTr::createProblem()
 				rubd[rpos] = 0;
 
 				bgn[rpos] = pos;
-				for (i = 0; i < model_->getNumReferences(); ++i) {
-					ind[pos] = nthetas_ + nlambdas_ + j * model_->getNumReferences() + i;
+				for (i = u_start_[j]; i < u_start_[j+1]; ++i) {
+					ind[pos] = nthetas_ + nlambdas_ + i;
 					elem[pos] = 1.0;
 					pos++;
 				}
@@ -572,7 +587,7 @@ DSP_RTN_CODE DdMasterTr::updateProblem()
 	/** current primal objective value */
 	double curprimobj = 0.0;
 	if (isSolved_)
-		curprimobj = osi_->getPrimObjValue();
+		curprimobj = primobj_;
 
 	/** calculate primal/dual objectives */
 	double newprimal = 0.0;
@@ -884,7 +899,7 @@ int DdMasterTr::addCuts(
 				/** insertIfNotDuplicate does not set effectiveness */
 				cuts_age_.push_back(0);
 				possiblyDelete_.push_back(possiblyDel);
-				masterobjsAtCutAdd_.push_back(osi_->getPrimObjValue());
+				masterobjsAtCutAdd_.push_back(primobj_);
 				cuts.insert(rc);
 			}
 		}
@@ -1173,3 +1188,135 @@ DSP_RTN_CODE DdMasterTr::terminationTest()
 
 	return signal;
 }
+
+DSP_RTN_CODE DdMasterTr::writeCheckpoint(std::ostream & os)
+{
+	BGN_TRY_CATCH
+
+	DSP_RTN_CHECK_THROW(DdMaster::writeCheckpoint(os));
+
+	/** trust region */
+	std::vector<double> center;
+	if (stability_center_)
+		center.assign(stability_center_, stability_center_ + nlambdas_ + nus_ + nPs_);
+	DspCheckpointWrite(os, "solved", isSolved_ ? 1 : 0);
+	DspCheckpointWrite(os, "trsize", stability_param_);
+	DspCheckpointWrite(os, "trcenter", center);
+	DspCheckpointWrite(os, "trcnt", trcnt_);
+	DspCheckpointWrite(os, "nstalls", nstalls_);
+	DspCheckpointWrite(os, "linerr", linerr_);
+
+	/** cut pool */
+	std::vector<int> possiblyDelete(possiblyDelete_.begin(), possiblyDelete_.end());
+	DspCheckpointWrite(os, "ncuts", cuts_->sizeRowCuts());
+	for (int i = 0; i < cuts_->sizeRowCuts(); ++i)
+	{
+		const OsiRowCut * rc = cuts_->rowCutPtr(i);
+		const CoinPackedVector & row = rc->row();
+		DspCheckpointWrite(os, "cutind", std::vector<int>(row.getIndices(), row.getIndices() + row.getNumElements()));
+		DspCheckpointWrite(os, "cutval", std::vector<double>(row.getElements(), row.getElements() + row.getNumElements()));
+		DspCheckpointWrite(os, "cutlb", rc->lb());
+		DspCheckpointWrite(os, "cutub", rc->ub());
+	}
+	DspCheckpointWrite(os, "cutage", cuts_age_);
+	DspCheckpointWrite(os, "cutdel", possiblyDelete);
+	DspCheckpointWrite(os, "cutobj", masterobjsAtCutAdd_);
+	DspCheckpointWrite(os, "ncuts_minor", ncuts_minor_);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DdMasterTr::readCheckpoint(std::istream & is)
+{
+	int solved, ncuts;
+	std::vector<double> center;
+	std::vector<int> possiblyDelete;
+	std::vector<int> ind;
+	std::vector<double> val;
+	double lb, ub;
+	OsiCuts activecuts;
+
+	BGN_TRY_CATCH
+
+	DSP_RTN_CHECK_THROW(DdMaster::readCheckpoint(is));
+
+	/** trust region */
+	DspCheckpointRead(is, "solved", solved);
+	DspCheckpointRead(is, "trsize", stability_param_);
+	DspCheckpointRead(is, "trcenter", center);
+	DspCheckpointRead(is, "trcnt", trcnt_);
+	DspCheckpointRead(is, "nstalls", nstalls_);
+	DspCheckpointRead(is, "linerr", linerr_);
+	if (center.size() != (stability_center_ ? (unsigned) (nlambdas_ + nus_ + nPs_) : 0))
+		throw CoinError("The checkpoint does not match the trust region", "readCheckpoint", "DdMasterTr");
+	if (stability_center_)
+		CoinCopyN(&center[0], center.size(), stability_center_);
+	isSolved_ = solved != 0;
+
+	/** cut pool */
+	cuts_->dumpCuts();
+	DspCheckpointRead(is, "ncuts", ncuts);
+	for (int i = 0; i < ncuts; ++i)
+	{
+		DspCheckpointRead(is, "cutind", ind);
+		DspCheckpointRead(is, "cutval", val);
+		DspCheckpointRead(is, "cutlb", lb);
+		DspCheckpointRead(is, "cutub", ub);
+		if (ind.size() != val.size())
+			throw CoinError("Invalid cut in the checkpoint", "readCheckpoint", "DdMasterTr");
+		OsiRowCut rc;
+		rc.setRow(ind.size(), ind.data(), val.data());
+		rc.setLb(lb);
+		rc.setUb(ub);
+		rc.setEffectiveness(1.0);
+		cuts_->insert(rc);
+	}
+	DspCheckpointRead(is, "cutage", cuts_age_);
+	DspCheckpointRead(is, "cutdel", possiblyDelete);
+	DspCheckpointRead(is, "cutobj", masterobjsAtCutAdd_);
+	DspCheckpointRead(is, "ncuts_minor", ncuts_minor_);
+	if (cuts_age_.size() != (unsigned) ncuts || possiblyDelete.size() != (unsigned) ncuts || masterobjsAtCutAdd_.size() != (unsigned) ncuts)
+		throw CoinError("Invalid cut pool in the checkpoint", "readCheckpoint", "DdMasterTr");
+	possiblyDelete_.assign(possiblyDelete.begin(), possiblyDelete.end());
+
+	/** load the active cuts in the order of the pool */
+	for (int i = 0; i < ncuts; ++i)
+		if (cuts_age_[i] >= 0)
+			activecuts.insert(*(cuts_->rowCutPtr(i)));
+	if (activecuts.sizeCuts() > 0)
+		getSiPtr()->applyCuts(activecuts);
+
+	/** set trust region */
+	if (parTr_)
+		DSP_RTN_CHECK_THROW(setTrustRegion(stability_param_, stability_center_));
+
+	message_->print(1, "Restored the master with %d cuts (%d active) and trust region size %e.\n",
+			ncuts, activecuts.sizeCuts(), stability_param_);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DdMasterTr::setInitialMultipliers(const double * lambda)
+{
+	BGN_TRY_CATCH
+
+	CoinCopyN(lambda, nlambdas_, &primsol_[nthetas_]);
+	CoinCopyN(lambda, nlambdas_, &lambda_[0]);
+
+	/** The trust region is centered at the initial multipliers. */
+	if (parTr_ && stability_center_)
+	{
+		CoinCopyN(lambda, nlambdas_, stability_center_);
+		DSP_RTN_CHECK_THROW(setTrustRegion(stability_param_, stability_center_));
+	}
+
+	message_->print(1, "Set %d initial multipliers.\n", nlambdas_);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
@@ -43,6 +43,15 @@ public:
 	/** termination test */
 	virtual DSP_RTN_CODE terminationTest();
 
+	/** write the master state with the trust region and the cut pool to a checkpoint */
+	virtual DSP_RTN_CODE writeCheckpoint(std::ostream & os);
+
+	/** restore the master state, and load the active cuts and the trust region to the master problem */
+	virtual DSP_RTN_CODE readCheckpoint(std::istream & is);
+
+	/** set the initial multipliers, which also become the trust-region center */
+	virtual DSP_RTN_CODE setInitialMultipliers(const double * lambda);
+
 protected:
 
 	/** create problem */
@@ -76,7 +85,8 @@ protected:
 
 	int nthetas_;  /**< number of thetas */
 	int nlambdas_; /**< number of lambdas */
-	int nus_;      /**< DRO: number of u's */
+	int nus_;      /**< DRO: number of u's (i.e., transport pairs) */
+	std::vector<int> u_start_; /**< DRO: index of the first u of each scenario */
 	int nPs_;      /**< DRO: number of Ps */
 
 	double ** obj_reco_; /**< DRO: recourse objective coefficient for each scenario */
@@ -7,7 +7,9 @@
 
 //#define DSP_DEBUG
 
+#include <map>
 #include "Solver/DualDecomp/DdWorkerLB.h"
+#include "Utility/DspProfiler.h"
 
 DdWorkerLB::DdWorkerLB(
 		DecModel *   model,  /**< model pointer */
@@ -20,6 +22,7 @@ isInit_(true) {}
 DdWorkerLB::DdWorkerLB(const DdWorkerLB& rhs) :
 DdWorker(rhs), 
 solution_key_(rhs.solution_key_), 
+subtimes_(rhs.subtimes_),
 isInit_(rhs.isInit_) {
 	for (unsigned s = 0; s < rhs.subprobs_.size(); ++s)
 		subprobs_[s] = rhs.subprobs_[s]->clone();
@@ -123,6 +126,9 @@ DSP_RTN_CODE DdWorkerLB::solve() {
 		total_cputime += CoinCpuTime() - cputime;
 		total_walltime += CoinGetTimeOfDay() - walltime;
 
+		DSP_PROFILE_TIME("dd/subproblem", CoinGetTimeOfDay() - walltime);
+		subtimes_[s] += CoinGetTimeOfDay() - walltime;
+
 		/** consume time */
 		time_remains_ -= CoinGetTimeOfDay() - walltime;
 	}
@@ -158,6 +164,40 @@ DSP_RTN_CODE DdWorkerLB::createProblem(int nsubprobs, int* subindex) {
         /** store */
         subprobs_.push_back(subprob);
     }
+	subtimes_.assign(subprobs_.size(), 0.0);
+	END_TRY_CATCH_RTN(;, DSP_RTN_ERR)
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DdWorkerLB::migrateProblem(int nsubprobs, int* subindex) {
+	BGN_TRY_CATCH
+
+	/** subproblems by index */
+	std::map<int,DdSub*> current;
+	for (unsigned s = 0; s < subprobs_.size(); ++s)
+		current[subprobs_[s]->sind_] = subprobs_[s];
+	subprobs_.clear();
+
+	for (int s = 0; s < nsubprobs; ++s) {
+		std::map<int,DdSub*>::iterator it = current.find(subindex[s]);
+		if (it != current.end()) {
+			subprobs_.push_back(it->second);
+			current.erase(it);
+		} else {
+			/** create subproblem instance */
+			DdSub *subprob = new DdSub(subindex[s], par_, model_, message_);
+			DSP_RTN_CHECK_THROW(subprob->init());
+			assert(subprob->getSiPtr());
+			subprobs_.push_back(subprob);
+		}
+	}
+
+	/** release the subproblems moved out */
+	for (std::map<int,DdSub*>::iterator it = current.begin(); it != current.end(); ++it)
+		FREE_PTR(it->second);
+
+	subtimes_.assign(subprobs_.size(), 0.0);
+
 	END_TRY_CATCH_RTN(;, DSP_RTN_ERR)
 	return DSP_RTN_OK;
 }
@@ -60,10 +60,17 @@ private:
 	/** A virtual member for creating LB problem */
 	virtual DSP_RTN_CODE createProblem(int nsubprobs, int* subindex);
 
+	/**
+	 * This changes the subproblems to the given indices. The subproblems kept are not
+	 * recreated, and the others are created from the model.
+	 */
+	virtual DSP_RTN_CODE migrateProblem(int nsubprobs, int* subindex);
+
 protected:
 
 	int solution_key_; /**< solution ID to be evaluated */
 	vector<DdSub*> subprobs_; /**< set of subproblems */
+	vector<double> subtimes_; /**< wall clock time spent on each subproblem */
 	bool isInit_; /**< indicate if this is the initial iteration */
 };
 
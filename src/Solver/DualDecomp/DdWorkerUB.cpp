@@ -8,9 +8,7 @@
 // #define DSP_DEBUG
 #include "Model/TssModel.h"
 #include "Solver/DualDecomp/DdWorkerUB.h"
-#include "SolverInterface/DspOsiCpx.h"
-#include "SolverInterface/DspOsiGrb.h"
-#include "SolverInterface/DspOsiScip.h"
+#include "SolverInterface/DspOsiFactory.h"
 
 #ifdef DSP_HAS_SCIP
 #include "Solver/DualDecomp/SCIPconshdlrBendersDd.h"
@@ -344,33 +342,12 @@ DspOsi * DdWorkerUB::createDspOsi() {
 	DspOsi * osi = NULL;
 	BGN_TRY_CATCH
 
-	switch (par_->getIntParam("DW/SUB/SOLVER")) {
-	case OsiCpx:
+	/** The subproblems solved by the threads need their own solver environments. */
+	osi = DspOsiFactory::create(par_->getIntParam("DW/SUB/SOLVER"), par_->getIntParam("DD/UB/THREADS") > 1);
 #ifdef DSP_HAS_CPX
-		osi = new DspOsiCpx();
+	if (par_->getIntParam("DW/SUB/SOLVER") == OsiCpx)
 		CPXsetintparam(dynamic_cast<DspOsiCpx*>(osi)->cpx_->getEnvironmentPtr(), CPX_PARAM_SCRIND, CPX_OFF);
-#else
-		throw CoinError("Cplex is not available.", "createDspOsi", "DdWorkerUB");
 #endif
-		break;
-	case OsiGrb:
-#ifdef DSP_HAS_GRB
-		osi = new DspOsiGrb();
-#else
-		throw CoinError("Gurobi is not available.", "createDspOsi", "DdWorkerUB");
-#endif
-		break;
-	case OsiScip:
-#ifdef DSP_HAS_SCIP
-		osi = new DspOsiScip();
-#else
-		throw CoinError("Scip is not available.", "createDspOsi", "DdWorkerUB");
-#endif
-		break;
-	default:
-		throw CoinError("Invalid parameter value", "createDspOsi", "DdWorkerUB");
-		break;
-	}
 
 	END_TRY_CATCH(;)
 	return osi;
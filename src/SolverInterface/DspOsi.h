@@ -20,7 +20,11 @@ public:
 	/** copy constructor */
 	DspOsi(const DspOsi& rhs) {}
 
-	/** clone constructor */
+	/**
+	 * clone constructor; the caller owns the clone, which deep-copies the problem into
+	 * a new solver instance. The clone shares the solver environment of this instance
+	 * unless this instance has its own environment (see hasLocalEnv()).
+	 */
 	virtual DspOsi* clone() const = 0;
 
 	/** destructor */
@@ -37,6 +41,16 @@ public:
 	/** solve problem */
 	virtual void solve() = 0;
 
+	/** resolve problem from the current basis (e.g., after changing objective coefficients) */
+	virtual void resolve() {
+		si_->resolve();
+	}
+
+	/** set a set of objective coefficients at once */
+	virtual void setObjCoeffSet(const int *indexFirst, const int *indexLast, const double *coeffList) {
+		si_->setObjCoeffSet(indexFirst, indexLast, coeffList);
+	}
+
 	virtual void use_simplex() {
 		throw CoinError("Simplex is not supported.", "use_simplex", "DspOsi");
 	}
@@ -88,6 +102,9 @@ public:
 	/** set number of cores */
 	virtual void setNumCores(int num) {}
 
+	/** whether the solver environment is not shared with the other instances */
+	virtual bool hasLocalEnv() const {return true;}
+
 	/** set time limit */
 	virtual void setTimeLimit(double time) {}
 
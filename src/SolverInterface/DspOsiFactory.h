@@ -0,0 +1,77 @@
+/**
+ * DspOsiFactory.h
+ *
+ * 10/19/2026
+ * Kibaek Kim
+ */
+
+#ifndef SRC_SOLVERINTERFACE_DSPOSIFACTORY_H_
+#define SRC_SOLVERINTERFACE_DSPOSIFACTORY_H_
+
+#include <cstdio>
+#include "Utility/DspParams.h"
+#include "SolverInterface/DspOsiClp.h"
+#include "SolverInterface/DspOsiCpx.h"
+#include "SolverInterface/DspOsiGrb.h"
+#include "SolverInterface/DspOsiScip.h"
+
+/**
+ * Factory of the solver interfaces.
+ *
+ * The instances of Cplex, Scip and Clp do not share any solver state, so they can be
+ * solved from different threads as long as each instance is used by one thread at a time.
+ * The instances of Gurobi share the global environment unless they are created with a
+ * local environment, in which case the solver parameters (e.g., the number of cores)
+ * are also set per instance. The decomposition layers solving subproblems from more
+ * than one thread should therefore request the local environments.
+ */
+class DspOsiFactory {
+public:
+
+	/**
+	 * create a solver interface; the caller owns the returned instance.
+	 * This throws CoinError if the solver is not available.
+	 */
+	static DspOsi* create(
+			int solver,             /**< [in] solver (DSP_EXTERNAL_SOLVER) */
+			bool local_env = false, /**< [in] whether to create a solver environment for the instance */
+			int nthreads = 0        /**< [in] number of cores used by the instance (0 to keep the solver default) */) {
+		DspOsi* osi = NULL;
+		switch (solver) {
+		case OsiCpx:
+#ifdef DSP_HAS_CPX
+			osi = new DspOsiCpx();
+#else
+			throw CoinError("Cplex is not available.", "create", "DspOsiFactory");
+#endif
+			break;
+		case OsiGrb:
+#ifdef DSP_HAS_GRB
+			osi = new DspOsiGrb(local_env);
+#else
+			throw CoinError("Gurobi is not available.", "create", "DspOsiFactory");
+#endif
+			break;
+		case OsiScip:
+#ifdef DSP_HAS_SCIP
+			osi = new DspOsiScip();
+#else
+			throw CoinError("Scip is not available.", "create", "DspOsiFactory");
+#endif
+			break;
+		case OsiClp:
+			osi = new DspOsiClp();
+			break;
+		default:
+			char coinmsg[128];
+			sprintf(coinmsg, "Invalid parameter value (solver = %d)", solver);
+			throw CoinError(coinmsg, "create", "DspOsiFactory");
+			break;
+		}
+		if (nthreads > 0)
+			osi->setNumCores(nthreads);
+		return osi;
+	}
+};
+
+#endif /* SRC_SOLVERINTERFACE_DSPOSIFACTORY_H_ */
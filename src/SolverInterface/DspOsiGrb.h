@@ -35,13 +35,23 @@ class DspOsiGrb : public DspOsi {
 public:
 
 	/** default constructor */
-	DspOsiGrb() {
+	DspOsiGrb() : local_env_(false) {
 		si_ = new OsiGrbSolverInterface();
 		grb_ = dynamic_cast<OsiGrbSolverInterface*>(si_);
 	}
 
-	/** copy constructor */
-	DspOsiGrb(const DspOsiGrb& rhs) {
+	/**
+	 * constructor with the choice of the environment; with a local environment, the
+	 * instance can be solved concurrently with the others and its parameters are not
+	 * shared through the global environment.
+	 */
+	DspOsiGrb(bool local_env) : local_env_(local_env) {
+		si_ = new OsiGrbSolverInterface(local_env);
+		grb_ = dynamic_cast<OsiGrbSolverInterface*>(si_);
+	}
+
+	/** copy constructor; the copy has its own environment if the original does */
+	DspOsiGrb(const DspOsiGrb& rhs) : local_env_(rhs.local_env_) {
         si_ = new OsiGrbSolverInterface(*(rhs.grb_));
 		grb_ = dynamic_cast<OsiGrbSolverInterface*>(si_);
 	}
@@ -225,6 +235,9 @@ public:
     	}
 	}
 
+	/** whether the solver environment is not shared with the other instances */
+	virtual bool hasLocalEnv() const {return local_env_;}
+
 	/** set time limit */
 	virtual void setTimeLimit(double time) {
 		try{
@@ -259,6 +272,10 @@ public:
 	}
 
     OsiGrbSolverInterface* grb_;   
+
+private:
+
+	bool local_env_; /**< whether the instance has its own environment */
 };
 
 #endif
@@ -9,7 +9,9 @@
 #define SRC_TREESEARCH_DSPBRANCHOBJ_H_
 
 #include <vector>
+#include <CoinError.hpp>
 #include <CoinPackedVector.hpp>
+#include "Utility/DspCheckpoint.h"
 
 class DspBranchObj {
 private:
@@ -25,8 +27,15 @@ public:
 	/** The solution estimate. The smaller the better. */
 	double solEstimate_;
 
+	/**@name pseudocost information */
+	int pcIndex_;             /**< branching variable index (-1 if not tracked) */
+	double pcFrac_;           /**< distance from the branching value to the new bound */
+	double parentObj_;        /**< objective value of the parent node */
+	mutable bool pcRecorded_; /**< whether the objective change has been recorded */
+
 public:
-	DspBranchObj(): bestBound_(-COIN_DBL_MAX), direction_(1), solEstimate_(0.0) {}
+	DspBranchObj(): bestBound_(-COIN_DBL_MAX), direction_(1), solEstimate_(0.0),
+		pcIndex_(-1), pcFrac_(0.0), parentObj_(-COIN_DBL_MAX), pcRecorded_(false) {}
 	virtual ~DspBranchObj() {
 		for (auto it = vecs_.begin(); it != vecs_.end(); it++)
 			delete *it;
@@ -55,6 +64,49 @@ public:
 
 	double getLb(int j) const {return lb_[j];}
 	double getUb(int j) const {return ub_[j];}
+
+	/** write the branching object to a checkpoint */
+	void writeCheckpoint(std::ostream& os) const {
+		DspCheckpointWrite(os, "nobjs", getNumObjs());
+		for (int j = 0; j < getNumObjs(); ++j) {
+			DspCheckpointWrite(os, "objind", std::vector<int>(vecs_[j]->getIndices(), vecs_[j]->getIndices() + vecs_[j]->getNumElements()));
+			DspCheckpointWrite(os, "objval", std::vector<double>(vecs_[j]->getElements(), vecs_[j]->getElements() + vecs_[j]->getNumElements()));
+			DspCheckpointWrite(os, "objlb", lb_[j]);
+			DspCheckpointWrite(os, "objub", ub_[j]);
+		}
+		DspCheckpointWrite(os, "bestbound", bestBound_);
+		DspCheckpointWrite(os, "dualsol", dualsol_);
+		DspCheckpointWrite(os, "direction", direction_);
+		DspCheckpointWrite(os, "solestimate", solEstimate_);
+		DspCheckpointWrite(os, "pcindex", pcIndex_);
+		DspCheckpointWrite(os, "pcfrac", pcFrac_);
+		DspCheckpointWrite(os, "parentobj", parentObj_);
+	}
+
+	/** read the branching object from a checkpoint; this throws CoinError for invalid entries. */
+	void readCheckpoint(std::istream& is) {
+		int nobjs;
+		std::vector<int> ind;
+		std::vector<double> val;
+		double lb, ub;
+		DspCheckpointRead(is, "nobjs", nobjs);
+		for (int j = 0; j < nobjs; ++j) {
+			DspCheckpointRead(is, "objind", ind);
+			DspCheckpointRead(is, "objval", val);
+			DspCheckpointRead(is, "objlb", lb);
+			DspCheckpointRead(is, "objub", ub);
+			if (ind.size() == 0 || ind.size() != val.size())
+				throw CoinError("Invalid branching vector", "readCheckpoint", "DspBranchObj");
+			push_back(new CoinPackedVector(ind.size(), &ind[0], &val[0]), lb, ub);
+		}
+		DspCheckpointRead(is, "bestbound", bestBound_);
+		DspCheckpointRead(is, "dualsol", dualsol_);
+		DspCheckpointRead(is, "direction", direction_);
+		DspCheckpointRead(is, "solestimate", solEstimate_);
+		DspCheckpointRead(is, "pcindex", pcIndex_);
+		DspCheckpointRead(is, "pcfrac", pcFrac_);
+		DspCheckpointRead(is, "parentobj", parentObj_);
+	}
 };
 
 #endif /* SRC_TREESEARCH_DSPBRANCHOBJ_H_ */
@@ -5,8 +5,10 @@
  *      Author: kibaekkim
  */
 
+#include <fstream>
 #include "AlpsEncoded.h"
 #include "AlpsNodeDesc.h"
+#include "Utility/DspCheckpoint.h"
 #include "Utility/DspMessage.h"
 #include "TreeSearch/DspModel.h"
 #include "TreeSearch/DspNodeDesc.h"
@@ -20,7 +22,9 @@ DspModel::DspModel() :
 		bestdualobj_(-COIN_DBL_MAX),
 		primobj_(COIN_DBL_MAX),
 		dualobj_(-COIN_DBL_MAX),
-		infeasibility_(0.0) {
+		infeasibility_(0.0),
+		nprocessed_(0),
+		restartobj_(COIN_DBL_MAX) {
 	/** nothing to do */
 }
 
@@ -32,12 +36,15 @@ DspModel::DspModel(DecSolver* solver) :
 		bestdualobj_(-COIN_DBL_MAX),
 		primobj_(COIN_DBL_MAX),
 		dualobj_(-COIN_DBL_MAX),
-		infeasibility_(0.0) {
+		infeasibility_(0.0),
+		nprocessed_(0),
+		restartobj_(COIN_DBL_MAX) {
 	/** nothing to do */
 }
 
 DspModel::~DspModel() {
-	/** nothing to do */
+	for (unsigned i = 0; i < restartnodes_.size(); ++i)
+		FREE_PTR(restartnodes_[i]);
 }
 
 AlpsTreeNode* DspModel::createRoot() {
@@ -65,3 +72,91 @@ DSP_RTN_CODE DspModel::solve() {
 
 	return DSP_RTN_OK;
 }
+
+bool DspModel::nodeProcessed() {
+	nprocessed_++;
+	int freq = par_->getIntParam("DW/CHECKPOINT/FREQ");
+	return freq > 0 && nprocessed_ % freq == 0;
+}
+
+DSP_RTN_CODE DspModel::checkpoint(double incumbentobj, const std::vector<double>& incumbent) {
+	std::string filename = par_->getStrParam("DW/CHECKPOINT/FILE");
+	if (filename.size() == 0)
+		return DSP_RTN_OK;
+
+	BGN_TRY_CATCH
+
+	std::ofstream ofs((filename + ".tmp").c_str());
+	DspCheckpointWrite(ofs, "DSP_DW_CHECKPOINT", 1);
+	DspCheckpointWrite(ofs, "incumbentobj", incumbentobj);
+	DspCheckpointWrite(ofs, "incumbent", incumbent);
+	DSP_RTN_CHECK_THROW(writeCheckpoint(ofs));
+	ofs.close();
+
+	if (ofs.fail() || !DspCheckpointCommit(filename))
+		solver_->getMessagePtr()->print(0, "Warning: failed to write the checkpoint %s.\n", filename.c_str());
+	else
+		solver_->getMessagePtr()->print(2, "Wrote the checkpoint %s with %lu open nodes.\n", filename.c_str(), opennodes_.size());
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DspModel::restart() {
+	std::string filename = par_->getStrParam("DW/RESTART/FILE");
+	if (filename.size() == 0)
+		return DSP_RTN_OK;
+
+	BGN_TRY_CATCH
+
+	std::ifstream ifs(filename.c_str());
+	if (!ifs.is_open())
+		throw CoinError("Failed to open the checkpoint " + filename, "restart", "DspModel");
+
+	int version;
+	DspCheckpointRead(ifs, "DSP_DW_CHECKPOINT", version);
+	DspCheckpointRead(ifs, "incumbentobj", restartobj_);
+	DspCheckpointRead(ifs, "incumbent", restartsol_);
+	DSP_RTN_CHECK_THROW(readCheckpoint(ifs));
+
+	solver_->getMessagePtr()->print(1, "Resumed from the checkpoint %s with %lu open nodes.\n", filename.c_str(), restartnodes_.size());
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DspModel::writeCheckpoint(std::ostream& os) {
+	/** The root node has no branching object and is written as no open node. */
+	std::vector<const DspBranchObj*> objs;
+	for (auto it = opennodes_.begin(); it != opennodes_.end(); it++)
+		if ((*it)->getBranchingObject() != NULL)
+			objs.push_back((*it)->getBranchingObject());
+
+	BGN_TRY_CATCH
+
+	DspCheckpointWrite(os, "nnodes", static_cast<int>(objs.size()));
+	for (unsigned i = 0; i < objs.size(); ++i)
+		objs[i]->writeCheckpoint(os);
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
+
+DSP_RTN_CODE DspModel::readCheckpoint(std::istream& is) {
+	int nnodes;
+
+	BGN_TRY_CATCH
+
+	DspCheckpointRead(is, "nnodes", nnodes);
+	for (int i = 0; i < nnodes; ++i) {
+		restartnodes_.push_back(new DspBranchObj());
+		restartnodes_.back()->readCheckpoint(is);
+	}
+
+	END_TRY_CATCH_RTN(;,DSP_RTN_ERR)
+
+	return DSP_RTN_OK;
+}
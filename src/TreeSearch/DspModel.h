@@ -8,12 +8,15 @@
 #ifndef SRC_TREESEARCH_DSPMODEL_H_
 #define SRC_TREESEARCH_DSPMODEL_H_
 
+#include <set>
 /** Coin */
 #include "AlpsModel.h"
 /** Dsp */
 #include "Solver/DecSolver.h"
 #include "TreeSearch/DspHeuristic.h"
 
+class DspNodeDesc;
+
 /**
  * This implements a model class for Coin-Alps library. This class provides a wrapper
  * for model class and data specific to a decomposition method.
@@ -63,6 +66,11 @@ public:
     	return false;
     }
 
+    /** record the objective value of a child node for the pseudocost */
+    virtual void updatePseudocost(
+    		const DspBranchObj* obj, /**< [in] branching object of the child node */
+			double childobj          /**< [in] objective value of the child node */) {}
+
     void setIterLimit(int n) {solver_->setIterLimit(n);}
     void setTimeLimit(double t) {solver_->setTimeLimit(t);}
     void setBestPrimalObjective(double val) {bestprimobj_=val;}
@@ -71,6 +79,51 @@ public:
     	solver_->setBranchingObjects(branchobj);
     }
 
+public:
+
+    /**@name checkpoint and restart */
+
+    /** register a node that has been created but not processed yet */
+    void addOpenNode(DspNodeDesc* desc) {opennodes_.insert(desc);}
+
+    /** unregister a node that has been processed or deleted */
+    void removeOpenNode(DspNodeDesc* desc) {opennodes_.erase(desc);}
+
+    /** count a processed node; this returns true if a checkpoint is due (every DW/CHECKPOINT/FREQ nodes). */
+    bool nodeProcessed();
+
+    /**
+     * Write the incumbent and the open nodes to DW/CHECKPOINT/FILE. The file is
+     * replaced only after the checkpoint has been completely written.
+     */
+    DSP_RTN_CODE checkpoint(
+    		double incumbentobj,                 /**< [in] incumbent objective value */
+			const std::vector<double>& incumbent /**< [in] incumbent solution (may be empty) */);
+
+    /** restore the state from DW/RESTART/FILE; this does nothing if the parameter is empty. */
+    DSP_RTN_CODE restart();
+
+    /** number of open nodes restored from a checkpoint */
+    int getNumRestartNodes() {return restartnodes_.size();}
+
+    /** hand the branching objects of the restored open nodes over to the caller */
+    void takeRestartNodes(std::vector<DspBranchObj*>& objs) {
+    	objs.insert(objs.end(), restartnodes_.begin(), restartnodes_.end());
+    	restartnodes_.clear();
+    }
+
+    /** incumbent restored from a checkpoint */
+    double getRestartObjective() {return restartobj_;}
+    std::vector<double>& getRestartSolution() {return restartsol_;}
+
+protected:
+
+    /** write the checkpoint entries; derived classes append the state of their solver. */
+    virtual DSP_RTN_CODE writeCheckpoint(std::ostream& os);
+
+    /** read the checkpoint entries in the order written by writeCheckpoint */
+    virtual DSP_RTN_CODE readCheckpoint(std::istream& is);
+
 protected:
 
     DecSolver* solver_; /**< decomposition solver */
@@ -97,6 +150,12 @@ protected:
     std::vector<double> primsol_; /**< primal solution (may not be integer feasible) */
     double infeasibility_;
     double feastol_ = 1.e-6; /**< feasibility tolerance */
+
+    std::set<DspNodeDesc*> opennodes_;        /**< nodes created but not processed yet */
+    int nprocessed_;                          /**< number of nodes processed */
+    std::vector<DspBranchObj*> restartnodes_; /**< open nodes restored from a checkpoint */
+    double restartobj_;                       /**< incumbent objective restored from a checkpoint */
+    std::vector<double> restartsol_;          /**< incumbent solution restored from a checkpoint */
 };
 
 #endif /* SRC_TREESEARCH_DSPMODEL_H_ */
@@ -48,6 +48,9 @@ public:
 
 	/** default destructor */
 	virtual ~DspNodeDesc() {
+		/** a node may be deleted without being processed */
+		DspModel* model = dynamic_cast<DspModel*>(getModel());
+		if (model) model->removeOpenNode(this);
 		FREE_PTR(branchobj_);
 	}
 
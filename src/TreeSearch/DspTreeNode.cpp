@@ -19,7 +19,7 @@
 #include "TreeSearch/DspNodeSolution.h"
 #include "Solver/DantzigWolfe/DwMaster.h"
 
-DspTreeNode::DspTreeNode() : AlpsTreeNode() {}
+DspTreeNode::DspTreeNode() : AlpsTreeNode(), restarted_(false) {}
 
 DspTreeNode::~DspTreeNode() {
 	for (auto obj = branchingObjs_.begin(); obj != branchingObjs_.end(); obj++) {
@@ -39,6 +39,15 @@ int DspTreeNode::process(bool isRoot, bool rampUp) {
 	DspParams* par = model->getParPtr();
 	DspMessage* message = solver->getMessagePtr();
 
+	/** the node is open again only if it becomes pregnant */
+	model->removeOpenNode(desc);
+
+	/** resume from a checkpoint */
+	if (isRoot) {
+		restart(model);
+		if (restarted_) return status;
+	}
+
 	/** bounds */
 	double gUb = getKnowledgeBroker()->getIncumbentValue();
 	double gLb = getKnowledgeBroker()->getBestNode()->getQuality();
@@ -103,6 +112,10 @@ int DspTreeNode::process(bool isRoot, bool rampUp) {
 		// The current LB is obtained by the Dantzig-Wolfe problem (i.e., primal form).
 		quality_ = model->getPrimalObjective();
 
+		/** objective change from the parent node */
+		if (!isRoot)
+			model->updatePseudocost(desc->getBranchingObject(), quality_);
+
 		if (isRoot) {
 			gLb = quality_;
 			model->setBestDualObjective(gLb);
@@ -130,7 +143,18 @@ int DspTreeNode::process(bool isRoot, bool rampUp) {
 		// write objective values to log file
 		if (par->getStrParam("DW/LOGFILE/OBJS").length() > 0) {
 			log_dualobjs_.open(par->getStrParam("DW/LOGFILE/OBJS").c_str(), ios::app);
-			if (isRoot) {
+			if (par->getStrParam("OUTPUT/FORMAT") == "json") {
+				const char * names[] = {"node", "time", "dualbound", "primalbound"};
+				if (isRoot) {
+					for (unsigned i = 0; i < solver->log_time_.size(); ++i) {
+						double values[] = {static_cast<double>(index_), solver->log_time_[i], solver->log_bestdual_bounds_[i], solver->log_bestprim_bounds_[i]};
+						DspMessage::writeJsonRecord(log_dualobjs_, 4, names, values);
+					}
+				} else {
+					double values[] = {static_cast<double>(index_), CoinWallclockTime(), gLb, gUb};
+					DspMessage::writeJsonRecord(log_dualobjs_, 4, names, values);
+				}
+			} else if (isRoot) {
 				for (unsigned i = 0; i < solver->log_time_.size(); ++i)
 					log_dualobjs_ << solver->log_time_[i] << "," << solver->log_bestdual_bounds_[i] << "," << solver->log_bestprim_bounds_[i] << std::endl;
 			} else {
@@ -161,6 +185,7 @@ int DspTreeNode::process(bool isRoot, bool rampUp) {
 
 				DSPdebugMessage("Branching on the current node.\n");
 				setStatus(AlpsNodeStatusPregnant);
+				model->addOpenNode(desc);
 			} else {
 				DSPdebugMessage("The current node has feasible solution.\n");
 				if (quality_ < gUb) {
@@ -187,6 +212,9 @@ int DspTreeNode::process(bool isRoot, bool rampUp) {
 		break;
 	}
 
+	if (model->nodeProcessed())
+		writeCheckpoint(model);
+
 	return status;
 }
 
@@ -206,6 +234,9 @@ std::vector<CoinTriple<AlpsNodeDesc*, AlpsNodeStatus, double> > DspTreeNode::bra
 	std::vector<CoinTriple<AlpsNodeDesc*, AlpsNodeStatus, double> > newNodes;
 	DspNodeDesc* node = NULL;
 
+	/** the children are open instead */
+	model->removeOpenNode(desc);
+
 	/** bounds */
 	double gUb = getKnowledgeBroker()->getIncumbentValue();
 	double gap = (gUb - getQuality()) / (fabs(gUb) + 1e-10);
@@ -224,6 +255,18 @@ std::vector<CoinTriple<AlpsNodeDesc*, AlpsNodeStatus, double> > DspTreeNode::bra
 	wirteLog("branched", desc, getQuality(), 1.0, 1);
 
 	for (auto obj = branchingObjs_.begin(); obj != branchingObjs_.end(); obj++) {
+		/** the restored nodes keep the bounds of their parents */
+		if (restarted_) {
+			node = new DspNodeDesc(model, (*obj)->direction_, *obj);
+			newNodes.push_back(CoinMakeTriple(
+					static_cast<AlpsNodeDesc*>(node),
+					AlpsNodeStatusCandidate,
+					CoinMax(node->getBranchingObject()->parentObj_, getQuality())));
+			model->addOpenNode(node);
+			node = NULL;
+			continue;
+		}
+
 		/** set branching object */
 		model->setBranchingObjects(*obj);
 
@@ -264,10 +307,13 @@ std::vector<CoinTriple<AlpsNodeDesc*, AlpsNodeStatus, double> > DspTreeNode::bra
 					gap < relTol) {
 					continue;
 				} else {
+					/** keep the objective change for the pseudocost */
+					model->updatePseudocost(node->getBranchingObject(), model->getPrimalObjective());
 					newNodes.push_back(CoinMakeTriple(
 							static_cast<AlpsNodeDesc*>(node),
 							AlpsNodeStatusCandidate,
 							model->getDualObjective()));
+					model->addOpenNode(node);
 					wirteLog("candidate", node, model->getDualObjective());
 					//printf("Branching estimates objective value %e.\n", model->getDualObjective());
 				}
@@ -277,6 +323,7 @@ std::vector<CoinTriple<AlpsNodeDesc*, AlpsNodeStatus, double> > DspTreeNode::bra
 					static_cast<AlpsNodeDesc*>(node),
 					AlpsNodeStatusCandidate,
 					getQuality()));
+			model->addOpenNode(node);
 			wirteLog("candidate", node, getQuality());
 		}
 		node = NULL;
@@ -294,6 +341,37 @@ DspTreeNode* DspTreeNode::createNewTreeNode(AlpsNodeDesc*& desc) const {
 	return node;
 }
 
+void DspTreeNode::restart(DspModel* model) {
+	/** restored incumbent */
+	if (model->getRestartObjective() < ALPS_OBJ_MAX && model->getRestartSolution().size() > 0) {
+		DspNodeSolution* nodesol = new DspNodeSolution(model->getRestartSolution(), model->getRestartObjective());
+		getKnowledgeBroker()->addKnowledge(AlpsKnowledgeTypeSolution, nodesol, model->getRestartObjective());
+		model->getRestartSolution().clear();
+	}
+
+	/** Without open nodes, the root node is processed from scratch. */
+	if (model->getNumRestartNodes() == 0)
+		return;
+
+	model->takeRestartNodes(branchingObjs_);
+	quality_ = ALPS_OBJ_MAX;
+	for (auto obj = branchingObjs_.begin(); obj != branchingObjs_.end(); obj++)
+		quality_ = CoinMin(quality_, (*obj)->parentObj_);
+	model->setBestDualObjective(quality_);
+	restarted_ = true;
+	setStatus(AlpsNodeStatusPregnant);
+	model->getSolver()->getMessagePtr()->print(1, "Restarted with %lu open nodes (bound %e).\n", branchingObjs_.size(), quality_);
+}
+
+void DspTreeNode::writeCheckpoint(DspModel* model) {
+	std::vector<double> incumbent;
+	if (getKnowledgeBroker()->hasKnowledge(AlpsKnowledgeTypeSolution)) {
+		DspNodeSolution* solution = dynamic_cast<DspNodeSolution*>(getKnowledgeBroker()->getBestKnowledge(AlpsKnowledgeTypeSolution).first);
+		if (solution) incumbent = solution->solution_;
+	}
+	model->checkpoint(getKnowledgeBroker()->getIncumbentValue(), incumbent);
+}
+
 void DspTreeNode::wirteLog(const char* status, DspNodeDesc* desc, double lpbound, double infeas, int suminfeas) {
 
 	DspModel* model = dynamic_cast<DspModel*>(desc->getModel());
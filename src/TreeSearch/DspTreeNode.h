@@ -75,14 +75,22 @@ public:
 
     void wirteLog(const char* status, DspNodeDesc* desc, double lpbound = 0.0, double infeas = 0.0, int suminfeas = 0);
 
+    /** write a checkpoint with the incumbent of the knowledge broker */
+    void writeCheckpoint(DspModel* model);
+
 private:
 
+    /** make the root node a parent of the open nodes restored from a checkpoint */
+    void restart(DspModel* model);
+
     std::fstream log_dualobjs_;
     std::fstream logstream_;
 
 	/** branching object */
     std::vector<DspBranchObj*> branchingObjs_;
 
+    bool restarted_; /**< whether the children are the open nodes restored from a checkpoint */
+
 };
 
 #endif /* SRC_MODEL_DSPTREENODE_H_ */
@@ -0,0 +1,97 @@
+/*
+ * DspCheckpoint.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#include <cstdio>
+#include <limits>
+#include "CoinError.hpp"
+#include "Utility/DspCheckpoint.h"
+
+/** read and check the key of an entry */
+static void readKey(std::istream & is, const char * key)
+{
+	std::string name;
+	if (!(is >> name))
+		throw CoinError("Unexpected end of the checkpoint at " + std::string(key), "DspCheckpointRead", "");
+	if (name != key)
+		throw CoinError("Invalid checkpoint entry " + name + " (expected " + std::string(key) + ")", "DspCheckpointRead", "");
+}
+
+/** read a value of an entry */
+template <class T>
+static void readValue(std::istream & is, const char * key, T & val)
+{
+	if (!(is >> val))
+		throw CoinError("Invalid value of the checkpoint entry " + std::string(key), "DspCheckpointRead", "");
+}
+
+void DspCheckpointWrite(std::ostream & os, const char * key, int val)
+{
+	os << key << " " << val << "\n";
+}
+
+void DspCheckpointWrite(std::ostream & os, const char * key, double val)
+{
+	std::streamsize prec = os.precision(std::numeric_limits<double>::max_digits10);
+	os << key << " " << val << "\n";
+	os.precision(prec);
+}
+
+void DspCheckpointWrite(std::ostream & os, const char * key, const std::vector<int> & vals)
+{
+	os << key << " " << vals.size();
+	for (unsigned i = 0; i < vals.size(); ++i)
+		os << " " << vals[i];
+	os << "\n";
+}
+
+void DspCheckpointWrite(std::ostream & os, const char * key, const std::vector<double> & vals)
+{
+	std::streamsize prec = os.precision(std::numeric_limits<double>::max_digits10);
+	os << key << " " << vals.size();
+	for (unsigned i = 0; i < vals.size(); ++i)
+		os << " " << vals[i];
+	os << "\n";
+	os.precision(prec);
+}
+
+void DspCheckpointRead(std::istream & is, const char * key, int & val)
+{
+	readKey(is, key);
+	readValue(is, key, val);
+}
+
+void DspCheckpointRead(std::istream & is, const char * key, double & val)
+{
+	readKey(is, key);
+	readValue(is, key, val);
+}
+
+void DspCheckpointRead(std::istream & is, const char * key, std::vector<int> & vals)
+{
+	int size;
+	readKey(is, key);
+	readValue(is, key, size);
+	vals.resize(size);
+	for (int i = 0; i < size; ++i)
+		readValue(is, key, vals[i]);
+}
+
+void DspCheckpointRead(std::istream & is, const char * key, std::vector<double> & vals)
+{
+	int size;
+	readKey(is, key);
+	readValue(is, key, size);
+	vals.resize(size);
+	for (int i = 0; i < size; ++i)
+		readValue(is, key, vals[i]);
+}
+
+bool DspCheckpointCommit(const std::string & filename)
+{
+	std::string tmpname = filename + ".tmp";
+	return std::rename(tmpname.c_str(), filename.c_str()) == 0;
+}
@@ -0,0 +1,48 @@
+/*
+ * DspCheckpoint.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#ifndef SRC_UTILITY_DSPCHECKPOINT_H_
+#define SRC_UTILITY_DSPCHECKPOINT_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Reading and writing the entries of a checkpoint file.
+ *
+ * A checkpoint is a plain text file of entries, one per line. Each entry starts
+ * with its key, followed by the value or the size and the elements of an array.
+ * Doubles are written with enough digits to be read back exactly. The entries
+ * must be read in the order they were written; a CoinError is thrown if the key
+ * does not match or the value cannot be read.
+ */
+
+/** write a scalar entry */
+void DspCheckpointWrite(std::ostream & os, const char * key, int val);
+void DspCheckpointWrite(std::ostream & os, const char * key, double val);
+
+/** write an array entry */
+void DspCheckpointWrite(std::ostream & os, const char * key, const std::vector<int> & vals);
+void DspCheckpointWrite(std::ostream & os, const char * key, const std::vector<double> & vals);
+
+/** read a scalar entry */
+void DspCheckpointRead(std::istream & is, const char * key, int & val);
+void DspCheckpointRead(std::istream & is, const char * key, double & val);
+
+/** read an array entry */
+void DspCheckpointRead(std::istream & is, const char * key, std::vector<int> & vals);
+void DspCheckpointRead(std::istream & is, const char * key, std::vector<double> & vals);
+
+/**
+ * Replace a file by the temporary file to which a checkpoint has been written
+ * (filename followed by .tmp), so that an interrupted write does not destroy the
+ * previous checkpoint. Return false if the replacement fails.
+ */
+bool DspCheckpointCommit(const std::string & filename);
+
+#endif /* SRC_UTILITY_DSPCHECKPOINT_H_ */
@@ -0,0 +1,170 @@
+/*
+ * DspCutPool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "Utility/DspCutPool.h"
+
+DspCutPool::DspCutPool(double parallelism, int max_age, double tolerance) :
+parallelism_(parallelism),
+max_age_(max_age),
+tolerance_(tolerance),
+next_id_(0),
+npurged_(0) {}
+
+DspCutPool::DspCutPool(const DspCutPool & rhs) :
+parallelism_(rhs.parallelism_),
+max_age_(rhs.max_age_),
+tolerance_(rhs.tolerance_),
+next_id_(rhs.next_id_),
+npurged_(rhs.npurged_) {
+	for (EntryMap::const_iterator it = rhs.cuts_.begin(); it != rhs.cuts_.end(); ++it)
+	{
+		Entry e = it->second;
+		e.row = new CoinPackedVector(*(it->second.row));
+		cuts_[it->first] = e;
+	}
+}
+
+DspCutPool::~DspCutPool()
+{
+	clear();
+}
+
+double DspCutPool::twoNorm(const CoinPackedVector & row)
+{
+	double norm = 0.0;
+	for (int i = 0; i < row.getNumElements(); ++i)
+		norm += row.getElements()[i] * row.getElements()[i];
+	return sqrt(norm);
+}
+
+double DspCutPool::dotProduct(const CoinPackedVector & row, const std::vector<double> & x)
+{
+	double val = 0.0;
+	for (int i = 0; i < row.getNumElements(); ++i)
+		if (row.getIndices()[i] < (int) x.size())
+			val += row.getElements()[i] * x[row.getIndices()[i]];
+	return val;
+}
+
+int DspCutPool::compare(const CoinPackedVector & row, double lb, std::vector<int> * weaker) const
+{
+	double norm = twoNorm(row);
+	if (norm == 0.0) return -1;
+
+	/** scatter the row */
+	int maxind = -1;
+	for (int i = 0; i < row.getNumElements(); ++i)
+		maxind = std::max(maxind, row.getIndices()[i]);
+	std::vector<double> dense(maxind + 1, 0.0);
+	for (int i = 0; i < row.getNumElements(); ++i)
+		dense[row.getIndices()[i]] += row.getElements()[i];
+
+	/** right-hand side of the normalized row */
+	double rhs = lb / norm;
+	double tol = tolerance_ * std::max(1.0, fabs(rhs));
+
+	int strongest = -1;
+	double strongest_rhs = rhs - tol;
+	for (EntryMap::const_iterator it = cuts_.begin(); it != cuts_.end(); ++it)
+	{
+		const Entry & e = it->second;
+		if (e.age >= max_age_ || e.norm == 0.0) continue;
+		if (dotProduct(*e.row, dense) < parallelism_ * norm * e.norm) continue;
+		double e_rhs = e.lb / e.norm;
+		if (e_rhs >= strongest_rhs)
+		{
+			strongest = it->first;
+			strongest_rhs = e_rhs;
+		}
+		else if (weaker && e_rhs < rhs - tol)
+			weaker->push_back(it->first);
+	}
+
+	return strongest;
+}
+
+int DspCutPool::find(const CoinPackedVector & row, double lb) const
+{
+	return compare(row, lb, NULL);
+}
+
+int DspCutPool::insert(const CoinPackedVector & row, double lb)
+{
+	/** retire the parallel cuts weaker than the new cut */
+	std::vector<int> weaker;
+	compare(row, lb, &weaker);
+	for (unsigned i = 0; i < weaker.size(); ++i)
+		cuts_[weaker[i]].age = max_age_;
+
+	Entry e;
+	e.row = new CoinPackedVector(row);
+	e.lb = lb;
+	e.norm = twoNorm(row);
+	e.age = 0;
+	e.nactive = 0;
+	cuts_[next_id_] = e;
+
+	return next_id_++;
+}
+
+void DspCutPool::age(const double * x)
+{
+	for (EntryMap::iterator it = cuts_.begin(); it != cuts_.end(); ++it)
+	{
+		Entry & e = it->second;
+		if (e.age >= max_age_) continue;
+		double act = 0.0;
+		for (int i = 0; i < e.row->getNumElements(); ++i)
+			act += e.row->getElements()[i] * x[e.row->getIndices()[i]];
+		if (act - e.lb <= tolerance_ * std::max(1.0, fabs(e.lb)))
+		{
+			e.age = 0;
+			e.nactive++;
+		}
+		else
+			e.age++;
+	}
+}
+
+int DspCutPool::purge(std::vector<int> & removed)
+{
+	removed.clear();
+	for (EntryMap::iterator it = cuts_.begin(); it != cuts_.end();)
+	{
+		if (it->second.age >= max_age_)
+		{
+			removed.push_back(it->first);
+			delete it->second.row;
+			cuts_.erase(it++);
+		}
+		else
+			++it;
+	}
+	npurged_ += removed.size();
+	return removed.size();
+}
+
+void DspCutPool::clear()
+{
+	for (EntryMap::iterator it = cuts_.begin(); it != cuts_.end(); ++it)
+		delete it->second.row;
+	cuts_.clear();
+}
+
+int DspCutPool::getAge(int id) const
+{
+	EntryMap::const_iterator it = cuts_.find(id);
+	return it == cuts_.end() ? -1 : it->second.age;
+}
+
+int DspCutPool::getNumActive(int id) const
+{
+	EntryMap::const_iterator it = cuts_.find(id);
+	return it == cuts_.end() ? -1 : it->second.nactive;
+}
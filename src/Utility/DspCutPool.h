@@ -0,0 +1,103 @@
+/*
+ * DspCutPool.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#ifndef SRC_UTILITY_DSPCUTPOOL_H_
+#define SRC_UTILITY_DSPCUTPOOL_H_
+
+#include <map>
+#include "Utility/DspTypes.h"
+
+/**
+ * Pool of cuts of the form row * x >= lb with the activity and age tracking.
+ *
+ * Each cut is identified by the integer returned from insert(). A new cut is
+ * filtered if a cut in the pool is parallel to it (i.e., the cosine of the two
+ * rows is at least the parallelism) and at least as strong after normalizing
+ * the rows. The parallel cuts weaker than a newly inserted cut are retired.
+ *
+ * The age of a cut is the number of consecutive solutions at which the cut has
+ * not been tight. The cuts of which age reaches the maximum age, and the retired
+ * cuts, are removed by purge().
+ */
+class DspCutPool
+{
+public:
+
+	/** A default constructor. */
+	DspCutPool(
+			double parallelism = 0.999, /**< minimum cosine of the parallel cuts */
+			int    max_age = 100,       /**< number of solutions at which a cut is not tight before purging */
+			double tolerance = 1.0e-6   /**< relative tolerance of tightness and strength */);
+
+	/** A copy constructor. */
+	DspCutPool(const DspCutPool & rhs);
+
+	/** A default destructor. */
+	virtual ~DspCutPool();
+
+	/** find a cut parallel to and at least as strong as the given cut; return -1 if there is none */
+	int find(const CoinPackedVector & row, double lb) const;
+
+	/** insert a cut and retire the parallel cuts weaker than it; return the cut index */
+	int insert(const CoinPackedVector & row, double lb);
+
+	/** update the activities and the ages of the cuts at a dense solution */
+	void age(const double * x);
+
+	/** remove the old and retired cuts; return the number of removed cuts */
+	int purge(std::vector<int> & removed /**< [out] indices of the removed cuts */);
+
+	/** free all the cuts */
+	void clear();
+
+	/** number of cuts */
+	size_t size() const {return cuts_.size();}
+
+	/** age of a cut */
+	int getAge(int id) const;
+
+	/** number of solutions at which a cut has been tight */
+	int getNumActive(int id) const;
+
+	/** number of purged cuts */
+	int getNumPurged() const {return npurged_;}
+
+private:
+
+	struct Entry
+	{
+		CoinPackedVector * row; /**< cut row */
+		double lb;              /**< cut lower bound */
+		double norm;            /**< two-norm of the row */
+		int age;                /**< number of consecutive solutions at which the cut is not tight */
+		int nactive;            /**< number of solutions at which the cut is tight */
+	};
+
+	typedef std::map<int, Entry> EntryMap;
+
+	/** two-norm of a row */
+	static double twoNorm(const CoinPackedVector & row);
+
+	/** dot product of a row and a dense vector */
+	static double dotProduct(const CoinPackedVector & row, const std::vector<double> & x);
+
+	/** compare a cut with the cuts in the pool; return the index of the strongest parallel cut, or -1 */
+	int compare(
+			const CoinPackedVector & row, /**< [in] cut row */
+			double lb,                    /**< [in] cut lower bound */
+			std::vector<int> * weaker     /**< [out] parallel cuts weaker than the cut (can be NULL) */) const;
+
+	double parallelism_; /**< minimum cosine of the parallel cuts */
+	int max_age_;        /**< maximum age */
+	double tolerance_;   /**< relative tolerance */
+	int next_id_;        /**< index of the next cut */
+	int npurged_;        /**< number of purged cuts */
+
+	EntryMap cuts_; /**< cuts by index */
+};
+
+#endif /* SRC_UTILITY_DSPCUTPOOL_H_ */
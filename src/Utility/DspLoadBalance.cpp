@@ -0,0 +1,92 @@
+/*
+ * DspLoadBalance.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#include <algorithm>
+#include "Utility/DspLoadBalance.h"
+
+/** loads of the processes for an assignment */
+static void computeLoads(
+		int nprocs,
+		const std::vector<double> & times,
+		const std::vector<int> & owners,
+		std::vector<double> & loads)
+{
+	loads.assign(nprocs, 0.0);
+	for (unsigned k = 0; k < times.size(); ++k)
+		if (owners[k] >= 0 && owners[k] < nprocs)
+			loads[owners[k]] += times[k];
+}
+
+double DspLoadImbalance(
+		int nprocs,
+		const std::vector<double> & times,
+		const std::vector<int> & owners)
+{
+	if (nprocs <= 0) return 1.0;
+
+	std::vector<double> loads;
+	computeLoads(nprocs, times, owners, loads);
+
+	double total = 0.0;
+	for (int i = 0; i < nprocs; ++i)
+		total += loads[i];
+	if (total <= 0.0) return 1.0;
+
+	return *std::max_element(loads.begin(), loads.end()) * nprocs / total;
+}
+
+int DspLoadAssign(
+		int nprocs,
+		const std::vector<double> & times,
+		const std::vector<int> & owners,
+		double tolerance,
+		std::vector<int> & newowners)
+{
+	int nsubprobs = times.size();
+	newowners = owners;
+	if (nprocs <= 1 || nsubprobs == 0) return 0;
+
+	double total = 0.0;
+	for (int k = 0; k < nsubprobs; ++k)
+		total += times[k];
+	if (total <= 0.0) return 0;
+	double slack = tolerance * total / nprocs;
+
+	/** longest processing time first; ties are broken by index for every process to agree */
+	std::vector<int> order(nsubprobs);
+	for (int k = 0; k < nsubprobs; ++k)
+		order[k] = k;
+	std::stable_sort(order.begin(), order.end(),
+			[&times](int a, int b) {return times[a] > times[b];});
+
+	std::vector<int> candidate(nsubprobs, -1);
+	std::vector<double> loads(nprocs, 0.0);
+	for (int i = 0; i < nsubprobs; ++i)
+	{
+		int k = order[i];
+		int best = std::min_element(loads.begin(), loads.end()) - loads.begin();
+		if (owners[k] >= 0 && owners[k] < nprocs && loads[owners[k]] <= loads[best] + slack)
+			best = owners[k];
+		candidate[k] = best;
+		loads[best] += times[k];
+	}
+
+	/** keep the current assignment unless the maximum load decreases */
+	std::vector<double> oldloads;
+	computeLoads(nprocs, times, owners, oldloads);
+	double oldmax = *std::max_element(oldloads.begin(), oldloads.end());
+	double newmax = *std::max_element(loads.begin(), loads.end());
+	if (newmax >= oldmax - slack) return 0;
+
+	int nmoves = 0;
+	for (int k = 0; k < nsubprobs; ++k)
+		if (candidate[k] != owners[k])
+			nmoves++;
+	newowners = candidate;
+
+	return nmoves;
+}
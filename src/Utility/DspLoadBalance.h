@@ -0,0 +1,42 @@
+/*
+ * DspLoadBalance.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#ifndef SRC_UTILITY_DSPLOADBALANCE_H_
+#define SRC_UTILITY_DSPLOADBALANCE_H_
+
+#include <vector>
+
+/**
+ * ratio of the maximum load to the average load over the processes, where the load
+ * of a process is the sum of the solution times of its subproblems
+ * (1 if there is no load)
+ */
+double DspLoadImbalance(
+		int nprocs,                        /**< [in] number of processes */
+		const std::vector<double> & times, /**< [in] solution time of each subproblem */
+		const std::vector<int> & owners    /**< [in] process of each subproblem */);
+
+/**
+ * Assign the subproblems to the processes by their solution times.
+ *
+ * The subproblems are assigned in the decreasing order of their times, each to the
+ * process with the least load so far (longest processing time first). A subproblem
+ * stays with its current process if the load of the process is within the tolerance
+ * (relative to the average load) of the least load. The new assignment is returned
+ * only if it reduces the maximum load by more than the tolerance; otherwise, the
+ * current assignment is kept.
+ *
+ * @return number of subproblems moving to another process
+ */
+int DspLoadAssign(
+		int nprocs,                        /**< [in] number of processes */
+		const std::vector<double> & times, /**< [in] solution time of each subproblem */
+		const std::vector<int> & owners,   /**< [in] current process of each subproblem */
+		double tolerance,                  /**< [in] relative tolerance */
+		std::vector<int> & newowners       /**< [out] new process of each subproblem */);
+
+#endif /* SRC_UTILITY_DSPLOADBALANCE_H_ */
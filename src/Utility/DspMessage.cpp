@@ -0,0 +1,298 @@
+/*
+ * DspMessage.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Utility/DspMessage.h"
+#ifdef DSP_HAS_MPI
+#include <mpi.h>
+#endif
+
+namespace {
+
+/** size of ring buffer per thread */
+const size_t DSP_LOG_RING_SIZE = 1 << 16;
+
+/** flush interval of the background thread in milliseconds */
+const int DSP_LOG_FLUSH_INTERVAL = 100;
+
+/** single-producer single-consumer ring buffer of characters */
+class DspLogRing {
+public:
+	DspLogRing(): buf_(DSP_LOG_RING_SIZE), head_(0), tail_(0) {}
+
+	/** append characters; return false if there is no room */
+	bool push(const char * s, size_t n) {
+		size_t head = head_.load(std::memory_order_relaxed);
+		size_t tail = tail_.load(std::memory_order_acquire);
+		if (buf_.size() - (head - tail) < n)
+			return false;
+		for (size_t i = 0; i < n; ++i)
+			buf_[(head + i) % buf_.size()] = s[i];
+		head_.store(head + n, std::memory_order_release);
+		return true;
+	}
+
+	/** write out all the characters; called by one consumer at a time */
+	void drain(FILE * fp) {
+		size_t tail = tail_.load(std::memory_order_relaxed);
+		size_t head = head_.load(std::memory_order_acquire);
+		while (tail < head) {
+			size_t pos = tail % buf_.size();
+			size_t len = std::min(head - tail, buf_.size() - pos);
+			fwrite(&buf_[pos], 1, len, fp);
+			tail += len;
+		}
+		tail_.store(tail, std::memory_order_release);
+	}
+
+private:
+	std::vector<char> buf_;
+	std::atomic<size_t> head_; /**< total number of characters pushed */
+	std::atomic<size_t> tail_; /**< total number of characters written */
+};
+
+/** process-wide backend shared by all the asynchronous message handlers */
+class DspLogger {
+public:
+
+	static DspLogger & instance() {
+		static DspLogger logger;
+		return logger;
+	}
+
+	~DspLogger() {
+		stopThread();
+		for (unsigned i = 0; i < rings_.size(); ++i)
+			delete rings_[i];
+	}
+
+	/** start the flusher thread for the first user */
+	void attach() {
+		std::lock_guard<std::mutex> lock(cv_mutex_);
+		if (nusers_++ == 0) {
+			stop_ = false;
+			flusher_ = std::thread(&DspLogger::run, this);
+		}
+	}
+
+	/** stop the flusher thread after the last user */
+	void detach() {
+		bool last = false;
+		{
+			std::lock_guard<std::mutex> lock(cv_mutex_);
+			last = nusers_ > 0 && --nusers_ == 0;
+		}
+		if (last)
+			stopThread();
+	}
+
+	/** write complete lines */
+	void write(const char * s, size_t n) {
+		DspLogRing * ring = threadRing();
+		if (!ring->push(s, n)) {
+			/** The ring is full; write it out in order with the new lines. */
+			std::lock_guard<std::mutex> lock(out_mutex_);
+			ring->drain(stdout);
+			fwrite(s, 1, n, stdout);
+		}
+	}
+
+	/** write out all the rings */
+	void flush() {
+		std::lock_guard<std::mutex> lock(out_mutex_);
+		std::lock_guard<std::mutex> reglock(reg_mutex_);
+		for (unsigned i = 0; i < rings_.size(); ++i)
+			rings_[i]->drain(stdout);
+		fflush(stdout);
+	}
+
+private:
+
+	DspLogger(): nusers_(0), stop_(true) {}
+
+	/** ring buffer of the calling thread */
+	DspLogRing * threadRing() {
+		static thread_local DspLogRing * ring = NULL;
+		if (ring == NULL) {
+			ring = new DspLogRing;
+			std::lock_guard<std::mutex> lock(reg_mutex_);
+			rings_.push_back(ring);
+		}
+		return ring;
+	}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(cv_mutex_);
+		while (!stop_) {
+			cv_.wait_for(lock, std::chrono::milliseconds(DSP_LOG_FLUSH_INTERVAL));
+			lock.unlock();
+			flush();
+			lock.lock();
+		}
+	}
+
+	void stopThread() {
+		{
+			std::lock_guard<std::mutex> lock(cv_mutex_);
+			stop_ = true;
+		}
+		cv_.notify_all();
+		if (flusher_.joinable())
+			flusher_.join();
+		flush();
+	}
+
+	std::vector<DspLogRing*> rings_; /**< rings of all the threads */
+	std::mutex reg_mutex_;           /**< protects rings_ */
+	std::mutex out_mutex_;           /**< serializes writing to stdout */
+	std::mutex cv_mutex_;
+	std::condition_variable cv_;
+	std::thread flusher_;
+	int nusers_;
+	bool stop_;
+};
+
+/** partial line of the calling thread, which is written when it is completed or flushed */
+std::string & pendingLine() {
+	static thread_local std::string line;
+	return line;
+}
+
+/** [rank:thread] prefix of the calling thread */
+const std::string & threadPrefix() {
+	static std::atomic<int> nthreads(0);
+	static thread_local std::string prefix;
+	if (prefix.empty()) {
+		int rank = 0;
+#ifdef DSP_HAS_MPI
+		int initialized = 0;
+		MPI_Initialized(&initialized);
+		if (initialized)
+			MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+		char buf[64];
+		snprintf(buf, sizeof(buf), "[%d:%d] ", rank, nthreads++);
+		prefix = buf;
+	}
+	return prefix;
+}
+
+}
+
+DspMessage::~DspMessage()
+{
+	flush();
+	setAsync(false);
+}
+
+void DspMessage::setAsync(bool async)
+{
+	if (async == async_)
+		return;
+	/** the partial line goes out in the current mode */
+	writePendingLine();
+	async_ = async;
+	if (async_)
+		DspLogger::instance().attach();
+	else
+		DspLogger::instance().detach();
+}
+
+void DspMessage::flush()
+{
+	writePendingLine();
+	if (async_)
+		DspLogger::instance().flush();
+	else
+		fflush(stdout);
+}
+
+void DspMessage::writePendingLine()
+{
+	std::string & line = pendingLine();
+	if (line.empty())
+		return;
+	if (async_)
+		DspLogger::instance().write(line.data(), line.size());
+	else
+		fwrite(line.data(), 1, line.size(), stdout);
+	line.clear();
+}
+
+void DspMessage::vprint(const char *fmt, va_list args)
+{
+	std::string & line = pendingLine();
+
+	char buf[1024];
+	va_list args2;
+	va_copy(args2, args);
+	int len = vsnprintf(buf, sizeof(buf), fmt, args);
+	if (len < 0) {
+		va_end(args2);
+		return;
+	}
+	std::string msg;
+	if (static_cast<size_t>(len) < sizeof(buf))
+		msg.assign(buf, len);
+	else {
+		msg.resize(len + 1);
+		vsnprintf(&msg[0], len + 1, fmt, args2);
+		msg.resize(len);
+	}
+	va_end(args2);
+
+	/** move complete lines out of the partial line */
+	std::string lines;
+	for (size_t pos = 0; pos < msg.size();) {
+		size_t eol = msg.find('\n', pos);
+		if (line.empty() && prefix_)
+			line = threadPrefix();
+		if (eol == std::string::npos) {
+			line.append(msg, pos, std::string::npos);
+			break;
+		}
+		line.append(msg, pos, eol - pos + 1);
+		lines += line;
+		line.clear();
+		pos = eol + 1;
+	}
+	if (lines.empty())
+		return;
+
+	if (async_)
+		DspLogger::instance().write(lines.data(), lines.size());
+	else
+		fwrite(lines.data(), 1, lines.size(), stdout);
+}
+
+void DspMessage::writeJsonRecord(
+		std::ostream & os,     /**< output stream */
+		int            n,      /**< number of values */
+		const char **  names,  /**< value names */
+		const double * values  /**< values */)
+{
+	char buf[64];
+	os << "{";
+	for (int i = 0; i < n; ++i) {
+		if (i > 0) os << ",";
+		if (std::isfinite(values[i]) == false)
+			snprintf(buf, sizeof(buf), "null");
+		else if (values[i] == floor(values[i]) && fabs(values[i]) < 1.0e+15)
+			snprintf(buf, sizeof(buf), "%.0f", values[i]);
+		else
+			snprintf(buf, sizeof(buf), "%.10e", values[i]);
+		os << "\"" << names[i] << "\":" << buf;
+	}
+	os << "}\n";
+}
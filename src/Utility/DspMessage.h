@@ -12,29 +12,58 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <cmath>
+#include <ostream>
 #include "CoinPackedVector.hpp"
 
+/**
+ * Message handler. In the asynchronous mode, each thread pushes complete lines
+ * to its own ring buffer, and a background thread flushes them to stdout.
+ */
 class DspMessage
 {
 public:
-	DspMessage(int logLevel): logLevel_(logLevel)
+	DspMessage(int logLevel): logLevel_(logLevel), async_(false), prefix_(false)
 	{
 		setbuf(stdout, NULL);
 	}
 
+	~DspMessage();
+
+	/** whether a message at the level will be printed */
+	bool isPrintable(int level) const {return level <= logLevel_;}
+
 	void print(int level, const char *fmt, ...)
 	{
 		if (level <= logLevel_)
 		{
 			va_list args;
 			va_start(args, fmt);
-			vfprintf(stdout, fmt, args);
+			if (async_ || prefix_)
+				vprint(fmt, args);
+			else
+				vfprintf(stdout, fmt, args);
 			va_end(args);
 		}
 	}
 
+	/** enable or disable the asynchronous buffered output */
+	void setAsync(bool async);
+
+	/** enable or disable the [rank:thread] prefix of each line */
+	void setPrefix(bool prefix) {prefix_ = prefix;}
+
+	/** write out all the buffered messages, including the partial line of the calling thread */
+	void flush();
+
 	int logLevel_;
 
+	/** write a record of named values as a JSON object in a single line */
+	static void writeJsonRecord(
+			std::ostream & os,     /**< output stream */
+			int            n,      /**< number of values */
+			const char **  names,  /**< value names */
+			const double * values  /**< values */);
+
 	static void printArray(const CoinPackedVector * values)
 	{
 		for (int i = 0, j = 0; i < values->getNumElements(); ++i)
@@ -81,6 +110,17 @@ public:
 		}
 		printf("\n");
 	}
+
+protected:
+
+	/** format a message into complete lines */
+	void vprint(const char *fmt, va_list args);
+
+	/** write out the partial line of the calling thread */
+	void writePendingLine();
+
+	bool async_;  /**< asynchronous buffered output */
+	bool prefix_; /**< prefix each line with rank and thread */
 };
 
 #ifdef DSP_DEBUG
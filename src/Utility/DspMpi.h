@@ -26,6 +26,7 @@ using namespace std;
 #define DSP_MPI_TAG_ASK_SOLS    33
 #define DSP_MPI_TAG_SIG         4
 #define DSP_MPI_TAG_CGUB        5
+#define DSP_MPI_TAG_MIGRATE     6
 #define DSP_MPI_TAG_GROUP_SUB   90
 #define DSP_MPI_TAG_GROUP_LB    91
 #define DSP_MPI_TAG_GROUP_CGUB  92
@@ -20,6 +20,7 @@ DspParams::DspParams()
 	initStrParams();
 	initBoolPtrParams();
 	initIntPtrParams();
+	initDblPtrParams();
 }
 
 DspParams::~DspParams()
@@ -27,6 +28,10 @@ DspParams::~DspParams()
 	BoolPtrParams_.deleteParam("RELAX_INTEGRALITY");
 	IntPtrParams_.deleteParam("BD/ARR_AUG_SCENS");
 	IntPtrParams_.deleteParam("ARR_PROC_IDX");
+	IntPtrParams_.deleteParam("ARR_BUNDLE_IDX");
+	DblPtrParams_.deleteParam("DD/INIT_MULTIPLIERS");
+	DblPtrParams_.deleteParam("DW/INIT_COLS");
+	DblPtrParams_.deleteParam("INIT_INCUMBENT");
 }
 
 /** read parameter file */
@@ -137,6 +142,18 @@ void DspParams::initBoolParams()
 	/** static FIFO scheduling in the asynchronous DD; otherwise LIFO */
 	BoolParams_.createParam("DD/ASYNC/FIFO", true);
 
+	/** choose trial points by predicted improvement and staleness in the asynchronous DD; otherwise DD/ASYNC/FIFO */
+	BoolParams_.createParam("DD/ASYNC/PRIORITY", false);
+
+	/** asynchronous buffered logging */
+	BoolParams_.createParam("LOG_ASYNC", false);
+
+	/** prefix each log line with [rank:thread] */
+	BoolParams_.createParam("LOG_PREFIX", false);
+
+	/** overlap the master solve with upper bounding in the synchronous DD */
+	BoolParams_.createParam("DD/SYNC/OVERLAP", false);
+
 	/** options for Dantzig-Wolfe decomposition */
 	BoolParams_.createParam("DW/MASTER/PIPS", false);
 	BoolParams_.createParam("DW/MASTER/IPM", false);
@@ -148,6 +165,30 @@ void DspParams::initBoolParams()
 	BoolParams_.createParam("DW/HEURISTICS/SMIP", true);
 	BoolParams_.createParam("DW/STRONG_BRANCH", false);
 	BoolParams_.createParam("DW/BRANCH/INTEGER_FIRST", false);
+
+	/** choose the branching variable by reliability branching with pseudocosts */
+	BoolParams_.createParam("DW/BRANCH/PSEUDOCOST", false);
+
+	/** assign the scenarios to the Benders auxiliary variables by clustering similar scenarios */
+	BoolParams_.createParam("BD/AGGR/CLUSTER", false);
+
+	/** adaptively refine or coarsen the aggregation of the Benders optimality cuts */
+	BoolParams_.createParam("BD/AGGR/DYNAMIC", false);
+
+	/** filter and purge the Benders cuts in a cut pool */
+	BoolParams_.createParam("BD/CUT_POOL", false);
+
+	/** separate the Benders cuts at the in-out stabilized point at the root node */
+	BoolParams_.createParam("BD/IN_OUT", false);
+
+	/** generate the Pareto-optimal (Magnanti-Wong) Benders optimality cuts at a core point */
+	BoolParams_.createParam("BD/SUB/MAGNANTI_WONG", false);
+
+	/** merge the identical scenarios and remove the fixed columns and redundant rows of the extensive form */
+	BoolParams_.createParam("DE/PRESOLVE", false);
+
+	/** solve the distribution separation problem in closed form if the Wasserstein ball has a single reference */
+	BoolParams_.createParam("DRO/CLOSED_FORM", false);
 }
 
 void DspParams::initIntParams()
@@ -164,6 +205,10 @@ void DspParams::initIntParams()
 	/** number of cores used in OpenMP library (Benders only) */
 	IntParams_.createParam("NUM_CORES", 1);
 
+	/** number of scenario bundles formed by the similarity of scenarios for DD, DW and BD;
+	 * no bundling if zero. This is ignored if ARR_BUNDLE_IDX is given. */
+	IntParams_.createParam("NUM_BUNDLES", 0);
+
 	/** Benders cut priority (refer CONSHDLR_SEPAPRIORITY of SCIP constraint handler */
 	IntParams_.createParam("BD/CUT_PRIORITY", -200000);
 
@@ -175,6 +220,15 @@ void DspParams::initIntParams()
     /** iteration limit of the dual decomposition used in Benders for initial lower bounding */
 	IntParams_.createParam("BD/DD/ITER_LIM", 1);
 
+	/** number of separation rounds without violated cut to coarsen the aggregation of Benders cuts */
+	IntParams_.createParam("BD/AGGR/COARSEN_AGE", 20);
+
+	/** number of separation rounds at which a Benders cut is not tight before purging */
+	IntParams_.createParam("BD/CUT_POOL/MAX_AGE", 100);
+
+	/** number of separation rounds between purging the Benders cut pool */
+	IntParams_.createParam("BD/CUT_POOL/PURGE_FREQ", 10);
+
 	/** iteration limit */
     IntParams_.createParam("DD/ITER_LIM", MAX_INT_NUM);
 
@@ -200,14 +254,36 @@ void DspParams::initIntParams()
 
 	/** maximum number of solutions to evaluate */
 	IntParams_.createParam("DD/MAX_EVAL_UB", 1);
+
+	/** maximum number of solutions kept for detecting duplicate upper-bound evaluations (0 for no limit) */
+	IntParams_.createParam("DD/UB_POOL_SIZE", 0);
 	IntParams_.createParam("DW/MAX_EVAL_UB", 1);
 
+	/** number of stored first-stage solutions evaluated together by fixing in DW */
+	IntParams_.createParam("DW/EVAL_UB/BATCH", 1);
+
+	/** maximum number of stored first-stage solutions evaluated by fixing at each DW node (negative for no limit) */
+	IntParams_.createParam("DW/EVAL_UB/BUDGET", -1);
+
 	/** maximum queue size for asynchronous one */
 	IntParams_.createParam("DD/MAX_QSIZE", 5);
 
+	/**
+	 * eviction of queued trial points not assigned to any worker in the asynchronous DD:
+	 * 0 = none; 1 = drop the points dominated by a newer point; 2 = also drop the points
+	 * predicting no improvement over the best dual objective
+	 */
+	IntParams_.createParam("DD/ASYNC/EVICT", 0);
+
 	/** minimum number of processes to wait at the master */
 	IntParams_.createParam("DD/MIN_PROCS", 1);
 
+	/** number of iterations between rebalancing the subproblems over the processes in the synchronous DD (0 to disable) */
+	IntParams_.createParam("DD/REBALANCE/FREQ", 0);
+
+	/** number of iterations between writing the checkpoints of the DD master to DD/CHECKPOINT/FILE (0 to disable) */
+	IntParams_.createParam("DD/CHECKPOINT/FREQ", 0);
+
 //#ifdef DSP_HAS_GRB
 //	IntParams_.createParam("DE/SOLVER", OsiGrb);
 	
@@ -253,6 +329,12 @@ void DspParams::initIntParams()
 	IntParams_.createParam("DD/SUB/THREADS", 1);
 	IntParams_.createParam("DW/SUB/THREADS", 1);
 
+	/** number of threads evaluating the stored first-stage solutions in DW */
+	IntParams_.createParam("DW/EVAL_UB/THREADS", 1);
+
+	/** number of threads solving the scenario subproblems of the DRO upper bound in DD */
+	IntParams_.createParam("DD/UB/THREADS", 1);
+
 	/** display frequency */
 	IntParams_.createParam("SCIP/DISPLAY_FREQ", 100);
 
@@ -267,6 +349,27 @@ void DspParams::initIntParams()
 	IntParams_.createParam("DW/SUB/ADVIND", 1);
 	IntParams_.createParam("DW/BRANCH", 2);
 	IntParams_.createParam("DW/STRONG_BRANCH/ITER_LIM", 10);
+
+	/** number of pseudocost observations in each direction until the pseudocost is trusted */
+	IntParams_.createParam("DW/BRANCH/RELIABILITY", 4);
+
+	/** maximum number of unreliable candidates evaluated by strong branching at a node */
+	IntParams_.createParam("DW/BRANCH/MAX_STRONG", 8);
+
+	/** number of threads evaluating the child nodes in strong branching */
+	IntParams_.createParam("DW/BRANCH/THREADS", 1);
+
+	/** number of column generation iterations between rebalancing the subproblems over the processes in DW (0 to disable) */
+	IntParams_.createParam("DW/REBALANCE/FREQ", 0);
+
+	/** number of processed nodes between DW checkpoints (0 to write at the time or node limit only) */
+	IntParams_.createParam("DW/CHECKPOINT/FREQ", 0);
+
+	/** number of scenarios selected by forward selection for the extensive form (0 to keep all) */
+	IntParams_.createParam("DE/REDUCE/NSCEN", 0);
+
+	/** number of the nearest references kept in the transport pairs of each scenario (0 to keep all) */
+	IntParams_.createParam("DRO/KNEAREST", 0);
 }
 
 void DspParams::initDblParams()
@@ -277,6 +380,18 @@ void DspParams::initDblParams()
 	/** wall clock limit */
 	DblParams_.createParam("BD/WALL_LIM", MAX_DBL_NUM);
 
+	/** relative violation of Benders cuts lost by aggregation to refine the aggregation */
+	DblParams_.createParam("BD/AGGR/REFINE_TOL", 0.1);
+
+	/** minimum cosine of the Benders cuts regarded as parallel in the cut pool */
+	DblParams_.createParam("BD/CUT_POOL/PARALLELISM", 0.999);
+
+	/** initial weight of the stability center in the in-out separation point */
+	DblParams_.createParam("BD/IN_OUT/ALPHA", 0.8);
+
+	/** weight of the core point in the perturbed subproblem of the Magnanti-Wong cuts */
+	DblParams_.createParam("BD/SUB/MAGNANTI_WONG/PERTURB", 1.0e-4);
+
 	/** wall clock limit */
 	DblParams_.createParam("DD/WALL_LIM", MAX_DBL_NUM);
 
@@ -308,6 +423,16 @@ void DspParams::initDblParams()
 	/** minimum wait time for the master to receive worker processes */
 	DblParams_.createParam("DD/ASYNC/MIN_WAIT_TIME", 5.0);
 
+	/** per-iteration decay of the priority of queued trial points in the asynchronous DD */
+	DblParams_.createParam("DD/ASYNC/STALENESS_DECAY", 0.9);
+
+	/** relative load imbalance tolerated before rebalancing the subproblems */
+	DblParams_.createParam("DD/REBALANCE/TOL", 0.1);
+	DblParams_.createParam("DW/REBALANCE/TOL", 0.1);
+
+	/** maximum distance of the kept transport pairs relative to the Wasserstein ball size (0 to keep all) */
+	DblParams_.createParam("DRO/CUTOFF", 0.0);
+
 	/** options for branch-and-bound search */
 	DblParams_.createParam("ALPS/TIME_LIM", MAX_DBL_NUM);
 	DblParams_.createParam("DW/HEURISTICS/TRIVIAL/TIME_LIM", MAX_DBL_NUM);
@@ -318,6 +443,18 @@ void DspParams::initStrParams()
 {
 	/** prefix for output files */
 	StrParams_.createParam("OUTPUT/PREFIX", "dsp");
+	/** format of iteration log files: csv or json (one record per line) */
+	StrParams_.createParam("OUTPUT/FORMAT", "csv");
+	/** profile report file (.json or .csv); profiling is disabled if empty */
+	StrParams_.createParam("PROFILE/FILE", "");
+	/** checkpoint file written by the DD master */
+	StrParams_.createParam("DD/CHECKPOINT/FILE", "dsp-dd.ckpt");
+	/** checkpoint file from which DD resumes; DD starts from scratch if empty */
+	StrParams_.createParam("DD/RESTART/FILE", "");
+	/** checkpoint file of the DW branch-and-price (open nodes, incumbent and column pool); disabled if empty */
+	StrParams_.createParam("DW/CHECKPOINT/FILE", "");
+	/** checkpoint file from which the DW branch-and-price resumes; the search starts from the root if empty */
+	StrParams_.createParam("DW/RESTART/FILE", "");
 	StrParams_.createParam("DW/LOGFILE/OBJS", "");
 	StrParams_.createParam("VBC/FILE", "");
 }
@@ -339,4 +476,22 @@ void DspParams::initIntPtrParams()
 
 	/** array of augmented scenarios */
 	IntPtrParams_.createParam("BD/ARR_AUG_SCENS");
+
+	/** array of the bundle of each scenario; each bundle is solved as a single subproblem,
+	 * and ARR_PROC_IDX then refers to the bundles. */
+	IntPtrParams_.createParam("ARR_BUNDLE_IDX");
+}
+
+void DspParams::initDblPtrParams()
+{
+	DSPdebugMessage("creating double array parameters\n");
+	/** initial Lagrangian multipliers of the coupling rows for the dual decomposition master */
+	DblPtrParams_.createParam("DD/INIT_MULTIPLIERS");
+
+	/** initial columns for the Dantzig-Wolfe master;
+	 * each column is stored as a record [block, size, solution of the block]. */
+	DblPtrParams_.createParam("DW/INIT_COLS");
+
+	/** initial incumbent solution of the coupling (first-stage) variables */
+	DblPtrParams_.createParam("INIT_INCUMBENT");
 }
@@ -39,6 +39,11 @@ enum DSP_EXTERNAL_SOLVER {
 	OsiGrb
 };
 
+enum DSP_SCEN_REDUCTION {
+	SCEN_BACKWARD = 0, /**< fast backward reduction */
+	SCEN_KMEDOIDS      /**< k-medoids clustering */
+};
+
 enum DSP_DW_BRANCH {
 	BRANCH_INT = 0,
 	BRANCH_NONANT,
@@ -0,0 +1,243 @@
+/*
+ * DspProfiler.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "Utility/DspProfiler.h"
+#include "Utility/DspMessage.h"
+#include "Utility/DspRtnCodes.h"
+
+bool DspProfiler::enabled_ = false;
+
+DspProfiler & DspProfiler::instance()
+{
+	static DspProfiler profiler;
+	return profiler;
+}
+
+DspProfiler::Table & DspProfiler::localTable()
+{
+	/** The tables are owned by the profiler and outlive the threads. */
+	static thread_local Table * table = NULL;
+	if (table == NULL)
+	{
+		table = new Table;
+		std::lock_guard<std::mutex> lock(mutex_);
+		tables_.push_back(table);
+	}
+	return *table;
+}
+
+void DspProfiler::reset()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (unsigned i = 0; i < tables_.size(); ++i)
+		tables_[i]->clear();
+	stats_.clear();
+	rank_ = 0;
+	nranks_ = 1;
+}
+
+void DspProfiler::addTime(const char * name, double seconds)
+{
+	Entry & e = localTable()[name];
+	e.time += seconds;
+	e.calls++;
+}
+
+void DspProfiler::addCount(const char * name, long long n)
+{
+	localTable()[name].count += n;
+}
+
+void DspProfiler::merge(Table & table)
+{
+	table.clear();
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (unsigned i = 0; i < tables_.size(); ++i)
+	{
+		for (Table::const_iterator it = tables_[i]->begin(); it != tables_[i]->end(); ++it)
+		{
+			Entry & e = table[it->first];
+			e.time += it->second.time;
+			e.calls += it->second.calls;
+			e.count += it->second.count;
+		}
+	}
+}
+
+/** add an entry of a rank to the reduced entry */
+static void addStat(DspProfiler::Stat & stat, const DspProfiler::Entry & e)
+{
+	if (stat.nranks == 0)
+	{
+		stat.sum = e;
+		stat.min = e;
+		stat.max = e;
+	}
+	else
+	{
+		stat.sum.time += e.time;
+		stat.sum.calls += e.calls;
+		stat.sum.count += e.count;
+		stat.min.time = std::min(stat.min.time, e.time);
+		stat.min.calls = std::min(stat.min.calls, e.calls);
+		stat.min.count = std::min(stat.min.count, e.count);
+		stat.max.time = std::max(stat.max.time, e.time);
+		stat.max.calls = std::max(stat.max.calls, e.calls);
+		stat.max.count = std::max(stat.max.count, e.count);
+	}
+	stat.nranks++;
+}
+
+void DspProfiler::reduce(const std::vector<Table> & tables)
+{
+	stats_.clear();
+	nranks_ = tables.size();
+	for (unsigned i = 0; i < tables.size(); ++i)
+		for (Table::const_iterator it = tables[i].begin(); it != tables[i].end(); ++it)
+			addStat(stats_[it->first], it->second);
+}
+
+#ifdef DSP_HAS_MPI
+void DspProfiler::reduce(MPI_Comm comm)
+{
+	Table table;
+	merge(table);
+
+	MPI_Comm_rank(comm, &rank_);
+	MPI_Comm_size(comm, &nranks_);
+
+	/** serialize the local entries: one "name\ttime\tcalls\tcount" per line */
+	std::ostringstream oss;
+	oss.precision(17);
+	for (Table::const_iterator it = table.begin(); it != table.end(); ++it)
+		oss << it->first << '\t' << it->second.time << '\t' << it->second.calls << '\t' << it->second.count << '\n';
+	std::string buf = oss.str();
+
+	int len = buf.size();
+	std::vector<int> lens(nranks_, 0);
+	std::vector<int> displs(nranks_, 0);
+	MPI_Gather(&len, 1, MPI_INT, &lens[0], 1, MPI_INT, 0, comm);
+
+	std::vector<char> recvbuf;
+	if (rank_ == 0)
+	{
+		int total = 0;
+		for (int i = 0; i < nranks_; ++i)
+		{
+			displs[i] = total;
+			total += lens[i];
+		}
+		recvbuf.resize(total + 1, '\0');
+	}
+	MPI_Gatherv(const_cast<char*>(buf.c_str()), len, MPI_CHAR,
+			rank_ == 0 ? &recvbuf[0] : NULL, &lens[0], &displs[0], MPI_CHAR, 0, comm);
+
+	stats_.clear();
+	if (rank_ == 0)
+	{
+		std::vector<Table> tables(nranks_);
+		for (int i = 0; i < nranks_; ++i)
+		{
+			std::istringstream iss(std::string(&recvbuf[displs[i]], lens[i]));
+			std::string line;
+			while (std::getline(iss, line))
+			{
+				size_t pos = line.find('\t');
+				if (pos == std::string::npos) continue;
+				Entry & e = tables[i][line.substr(0, pos)];
+				std::istringstream vals(line.substr(pos + 1));
+				vals >> e.time >> e.calls >> e.count;
+			}
+		}
+		reduce(tables);
+	}
+}
+#endif
+
+int DspProfiler::write(const char * filename)
+{
+	if (rank_ != 0)
+		return DSP_RTN_OK;
+
+	/** profile was not reduced; report the local entries */
+	if (nranks_ == 1 && stats_.empty())
+	{
+		Table table;
+		merge(table);
+		for (Table::const_iterator it = table.begin(); it != table.end(); ++it)
+			addStat(stats_[it->first], it->second);
+	}
+
+	std::ofstream ofs(filename);
+	if (!ofs.good())
+	{
+		printf("Warning: cannot write the profile to %s\n", filename);
+		return DSP_RTN_ERR;
+	}
+
+	size_t len = strlen(filename);
+	bool json = len >= 5 && strcmp(filename + len - 5, ".json") == 0;
+
+	const char * names[] = {
+			"nranks",
+			"time_sum", "time_min", "time_max", "time_avg",
+			"calls_sum", "calls_min", "calls_max",
+			"count_sum", "count_min", "count_max"};
+	const int nvalues = sizeof(names) / sizeof(names[0]);
+
+	if (json)
+		ofs << "{\"nranks\":" << nranks_ << ",\"sections\":{\n";
+	else
+	{
+		ofs << "section";
+		for (int j = 0; j < nvalues; ++j)
+			ofs << "," << names[j];
+		ofs << "\n";
+	}
+
+	for (std::map<std::string, Stat>::const_iterator it = stats_.begin(); it != stats_.end(); ++it)
+	{
+		const Stat & s = it->second;
+		double values[] = {
+				static_cast<double>(s.nranks),
+				s.sum.time, s.min.time, s.max.time, s.sum.time / nranks_,
+				static_cast<double>(s.sum.calls), static_cast<double>(s.min.calls), static_cast<double>(s.max.calls),
+				static_cast<double>(s.sum.count), static_cast<double>(s.min.count), static_cast<double>(s.max.count)};
+		if (json)
+		{
+			if (it != stats_.begin())
+				ofs << ",\n";
+			ofs << "\"" << it->first << "\":";
+			std::ostringstream rec;
+			DspMessage::writeJsonRecord(rec, nvalues, names, values);
+			/** drop the trailing newline of the record */
+			std::string str = rec.str();
+			if (!str.empty() && str[str.size() - 1] == '\n')
+				str.erase(str.size() - 1);
+			ofs << str;
+		}
+		else
+		{
+			ofs << it->first;
+			for (int j = 0; j < nvalues; ++j)
+				ofs << "," << values[j];
+			ofs << "\n";
+		}
+	}
+
+	if (json)
+		ofs << "\n}}\n";
+	ofs.close();
+
+	return DSP_RTN_OK;
+}
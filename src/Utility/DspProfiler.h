@@ -0,0 +1,159 @@
+/*
+ * DspProfiler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#ifndef DSPPROFILER_H_
+#define DSPPROFILER_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "CoinTime.hpp"
+
+#ifdef DSP_HAS_MPI
+#include <mpi.h>
+#endif
+
+/**
+ * Profiler that accumulates the elapsed times and the counts of named
+ * sections. Each thread accumulates to its own table, so recording does not
+ * take any lock. The tables are merged at the end of solve, and the rank-wise
+ * results are reduced to rank 0 (sum, min and max over the ranks).
+ *
+ * The profiler is disabled by default, in which case the timers do not even
+ * read the clock.
+ */
+class DspProfiler
+{
+public:
+
+	/** profile entry */
+	struct Entry
+	{
+		Entry(): time(0.0), calls(0), count(0) {}
+		double    time;  /**< elapsed wall time */
+		long long calls; /**< number of timed calls */
+		long long count; /**< counter value */
+	};
+
+	typedef std::map<std::string, Entry> Table;
+
+	/** reduced profile entry */
+	struct Stat
+	{
+		Stat(): sum(), min(), max(), nranks(0) {}
+		Entry sum;  /**< sum over the ranks */
+		Entry min;  /**< minimum over the ranks */
+		Entry max;  /**< maximum over the ranks */
+		int nranks; /**< number of ranks that recorded the entry */
+	};
+
+	/** get the profiler */
+	static DspProfiler & instance();
+
+	/** whether profiling is enabled */
+	static bool isEnabled() {return enabled_;}
+
+	/** enable or disable profiling */
+	void enable(bool enable) {enabled_ = enable;}
+
+	/** clear all the recorded entries */
+	void reset();
+
+	/** add elapsed time to a section */
+	void addTime(const char * name, double seconds);
+
+	/** add to a counter */
+	void addCount(const char * name, long long n = 1);
+
+	/** merge the entries of all the threads in this process */
+	void merge(Table & table);
+
+	/** reduce the tables of the ranks, where the i-th table is of rank i */
+	void reduce(const std::vector<Table> & tables);
+
+#ifdef DSP_HAS_MPI
+	/** reduce the entries of all the ranks to rank 0 */
+	void reduce(MPI_Comm comm);
+#endif
+
+	/** get the reduced entries */
+	const std::map<std::string, Stat> & getStats() const {return stats_;}
+
+	/**
+	 * Write the report. The format is JSON if the file name ends with .json,
+	 * and CSV otherwise. Only rank 0 writes when the profile was reduced.
+	 */
+	int write(const char * filename);
+
+private:
+
+	DspProfiler(): rank_(0), nranks_(1) {}
+
+	/** get the table of the calling thread */
+	Table & localTable();
+
+	static bool enabled_;
+
+	std::mutex mutex_;             /**< guards tables_ */
+	std::vector<Table*> tables_;   /**< tables of all the threads */
+	std::map<std::string, Stat> stats_; /**< reduced entries */
+	int rank_;                     /**< process rank */
+	int nranks_;                   /**< number of ranks */
+};
+
+/**
+ * Scoped timer that adds the elapsed wall time to a profile section when it
+ * goes out of scope. The section name is copied only if profiling is enabled.
+ */
+class DspScopedTimer
+{
+public:
+	DspScopedTimer(const char * name):
+		stime_(DspProfiler::isEnabled() ? CoinGetTimeOfDay() : -1.0)
+	{
+		if (stime_ >= 0.0)
+			name_ = name;
+	}
+
+	/** time the section "name/index" (e.g., of a block) */
+	DspScopedTimer(const char * name, int index):
+		stime_(DspProfiler::isEnabled() ? CoinGetTimeOfDay() : -1.0)
+	{
+		if (stime_ >= 0.0)
+			name_ = std::string(name) + "/" + std::to_string(index);
+	}
+
+	~DspScopedTimer()
+	{
+		if (stime_ >= 0.0)
+			DspProfiler::instance().addTime(name_.c_str(), CoinGetTimeOfDay() - stime_);
+	}
+
+private:
+	std::string name_;
+	double stime_;
+};
+
+#define DSP_PROFILE_CONCAT_(a,b) a##b
+#define DSP_PROFILE_CONCAT(a,b) DSP_PROFILE_CONCAT_(a,b)
+
+/** time the rest of the current scope */
+#define DSP_PROFILE_SCOPE(name) DspScopedTimer DSP_PROFILE_CONCAT(dsp_profile_timer_, __LINE__)(name)
+
+/** time the rest of the current scope in a section per index */
+#define DSP_PROFILE_SCOPE_INDEX(name, index) DspScopedTimer DSP_PROFILE_CONCAT(dsp_profile_timer_, __LINE__)(name, index)
+
+/** add to a profile counter */
+#define DSP_PROFILE_COUNT(name, n) \
+	do { if (DspProfiler::isEnabled()) DspProfiler::instance().addCount(name, n); } while (0)
+
+/** add a measured time to a profile section */
+#define DSP_PROFILE_TIME(name, t) \
+	do { if (DspProfiler::isEnabled()) DspProfiler::instance().addTime(name, t); } while (0)
+
+#endif /* DSPPROFILER_H_ */
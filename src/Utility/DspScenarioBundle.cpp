@@ -0,0 +1,108 @@
+/*
+ * DspScenarioBundle.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#include <algorithm>
+#include "Utility/DspScenarioBundle.h"
+
+/** squared distance between two vectors */
+static double distance(const std::vector<double> & x, const std::vector<double> & y)
+{
+	double dist = 0.0;
+	for (unsigned i = 0; i < x.size(); ++i)
+		dist += (x[i] - y[i]) * (x[i] - y[i]);
+	return dist;
+}
+
+int DspBundleScenarios(
+		int nbundles,
+		const std::vector<std::vector<double> > & data,
+		std::vector<int> & bundles)
+{
+	int nscen = data.size();
+	bundles.assign(nscen, 0);
+	if (nscen == 0) return 0;
+	nbundles = std::max(1, std::min(nbundles, nscen));
+	/** nlarge bundles have one more scenario than the capacity */
+	int capacity = nscen / nbundles;
+	int nlarge = nscen % nbundles;
+
+	/** scale the data */
+	unsigned dim = data[0].size();
+	std::vector<std::vector<double> > points(data);
+	for (unsigned i = 0; i < dim; ++i)
+	{
+		double lb = data[0][i], ub = data[0][i];
+		for (int s = 1; s < nscen; ++s)
+		{
+			lb = std::min(lb, data[s][i]);
+			ub = std::max(ub, data[s][i]);
+		}
+		for (int s = 0; s < nscen; ++s)
+			points[s][i] = ub > lb ? (data[s][i] - lb) / (ub - lb) : 0.0;
+	}
+
+	/** seed the centers by the farthest-point rule */
+	std::vector<std::vector<double> > centers(1, points[0]);
+	std::vector<double> mindist(nscen);
+	for (int s = 0; s < nscen; ++s)
+		mindist[s] = distance(points[s], centers[0]);
+	while ((int) centers.size() < nbundles)
+	{
+		int far = std::max_element(mindist.begin(), mindist.end()) - mindist.begin();
+		centers.push_back(points[far]);
+		for (int s = 0; s < nscen; ++s)
+			mindist[s] = std::min(mindist[s], distance(points[s], centers.back()));
+	}
+
+	std::vector<int> assigned(nscen, -1);
+	std::vector<std::pair<double,int> > pairs(nscen * nbundles);
+	for (int iter = 0; iter < 100; ++iter)
+	{
+		/** assign the closest pairs of scenario and center first, subject to the capacity */
+		for (int s = 0; s < nscen; ++s)
+			for (int b = 0; b < nbundles; ++b)
+				pairs[s * nbundles + b] = std::make_pair(distance(points[s], centers[b]), s * nbundles + b);
+		std::stable_sort(pairs.begin(), pairs.end());
+
+		std::vector<int> assignment(nscen, -1);
+		std::vector<int> sizes(nbundles, 0);
+		int nlarger = 0;
+		for (unsigned k = 0; k < pairs.size(); ++k)
+		{
+			int s = pairs[k].second / nbundles;
+			int b = pairs[k].second % nbundles;
+			if (assignment[s] >= 0) continue;
+			if (sizes[b] == capacity && nlarger < nlarge)
+				nlarger++;
+			else if (sizes[b] >= capacity)
+				continue;
+			assignment[s] = b;
+			sizes[b]++;
+		}
+		if (assignment == assigned) break;
+		assigned = assignment;
+
+		/** move the centers to the means of the bundles */
+		for (int b = 0; b < nbundles; ++b)
+			centers[b].assign(dim, 0.0);
+		for (int s = 0; s < nscen; ++s)
+			for (unsigned i = 0; i < dim; ++i)
+				centers[assigned[s]][i] += points[s][i] / sizes[assigned[s]];
+	}
+
+	/** number the bundles in the order of their first scenarios */
+	std::vector<int> index(nbundles, -1);
+	int nformed = 0;
+	for (int s = 0; s < nscen; ++s)
+	{
+		if (index[assigned[s]] < 0)
+			index[assigned[s]] = nformed++;
+		bundles[s] = index[assigned[s]];
+	}
+
+	return nformed;
+}
@@ -0,0 +1,29 @@
+/*
+ * DspScenarioBundle.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#ifndef SRC_UTILITY_DSPSCENARIOBUNDLE_H_
+#define SRC_UTILITY_DSPSCENARIOBUNDLE_H_
+
+#include <vector>
+
+/**
+ * Cluster the scenarios into bundles of similar scenarios.
+ *
+ * Each scenario is represented by a vector of its data, of which each element is
+ * scaled to [0,1] over the scenarios. The bundles are formed by k-means clustering
+ * seeded by the farthest-point rule, where each bundle has floor(n/nbundles) or
+ * ceil(n/nbundles) scenarios so that the bundled subproblems are of similar sizes.
+ * The bundles are numbered in the order of their first scenarios.
+ *
+ * @return number of bundles, min(nbundles, n)
+ */
+int DspBundleScenarios(
+		int nbundles,                                   /**< [in] number of bundles */
+		const std::vector<std::vector<double> > & data, /**< [in] data vector of each scenario */
+		std::vector<int> & bundles                      /**< [out] bundle of each scenario */);
+
+#endif /* SRC_UTILITY_DSPSCENARIOBUNDLE_H_ */
@@ -0,0 +1,268 @@
+/*
+ * DspScenarioReduction.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "Utility/DspScenarioReduction.h"
+
+/** lexicographic order of the scenario data */
+struct DataOrder
+{
+	const std::vector<std::vector<double> > * data;
+	bool operator()(int s, int t) const {
+		return (*data)[s] < (*data)[t];
+	}
+};
+
+int DspMergeIdenticalScenarios(
+		const std::vector<std::vector<double> > & data,
+		std::vector<int> & rep)
+{
+	int nscen = data.size();
+	rep.resize(nscen);
+	std::vector<int> order(nscen);
+	for (int s = 0; s < nscen; ++s)
+		order[s] = s;
+	DataOrder less = {&data};
+	std::stable_sort(order.begin(), order.end(), less);
+
+	/** the stable order keeps the smallest index first in each group */
+	int ndistinct = 0;
+	for (int k = 0; k < nscen; ++k)
+	{
+		if (k > 0 && data[order[k]] == data[order[k-1]])
+			rep[order[k]] = rep[order[k-1]];
+		else
+		{
+			rep[order[k]] = order[k];
+			ndistinct++;
+		}
+	}
+
+	return ndistinct;
+}
+
+/** represent each scenario by its nearest kept scenario; return the Kantorovich distance */
+static double assignNearest(
+		int nscen,
+		const std::function<double(int,int)> & dist,
+		const std::vector<double> & prob,
+		const std::vector<int> & kept,
+		std::vector<int> & rep)
+{
+	double kantorovich = 0.0;
+	std::vector<bool> iskept(nscen, false);
+	for (unsigned k = 0; k < kept.size(); ++k)
+		iskept[kept[k]] = true;
+	for (int s = 0; s < nscen; ++s)
+	{
+		rep[s] = s;
+		if (iskept[s]) continue;
+		double mindist = std::numeric_limits<double>::infinity();
+		for (unsigned k = 0; k < kept.size(); ++k)
+		{
+			double d = dist(s, kept[k]);
+			if (d < mindist)
+			{
+				rep[s] = kept[k];
+				mindist = d;
+			}
+		}
+		kantorovich += prob[s] * mindist;
+	}
+	return kantorovich;
+}
+
+double DspForwardSelection(
+		int nselect,
+		int nscen,
+		const std::function<double(int,int)> & dist,
+		const std::vector<double> & prob,
+		std::vector<int> & rep)
+{
+	rep.resize(nscen);
+	for (int s = 0; s < nscen; ++s)
+		rep[s] = s;
+	if (nselect <= 0 || nselect >= nscen)
+		return 0.0;
+
+	/** distance from each scenario to the nearest selected scenario */
+	std::vector<double> mindist(nscen, std::numeric_limits<double>::infinity());
+	std::vector<bool> selected(nscen, false);
+	for (int k = 0; k < nselect; ++k)
+	{
+		int best = -1;
+		double best_cost = std::numeric_limits<double>::infinity();
+		for (int u = 0; u < nscen; ++u)
+		{
+			if (selected[u]) continue;
+			double cost = 0.0;
+			for (int s = 0; s < nscen && cost < best_cost; ++s)
+				if (!selected[s] && s != u)
+					cost += prob[s] * std::min(mindist[s], dist(s, u));
+			if (cost < best_cost)
+			{
+				best = u;
+				best_cost = cost;
+			}
+		}
+		selected[best] = true;
+		for (int s = 0; s < nscen; ++s)
+			if (!selected[s])
+				mindist[s] = std::min(mindist[s], dist(s, best));
+	}
+
+	/** redistribute to the nearest selected scenario */
+	std::vector<int> kept;
+	for (int s = 0; s < nscen; ++s)
+		if (selected[s])
+			kept.push_back(s);
+	return assignNearest(nscen, dist, prob, kept, rep);
+}
+
+double DspBackwardReduction(
+		int nselect,
+		int nscen,
+		const std::function<double(int,int)> & dist,
+		const std::vector<double> & prob,
+		std::vector<int> & rep)
+{
+	rep.resize(nscen);
+	for (int s = 0; s < nscen; ++s)
+		rep[s] = s;
+	if (nselect <= 0 || nselect >= nscen)
+		return 0.0;
+
+	/** nearest remaining scenario of each remaining scenario */
+	std::vector<int> nearest(nscen, -1);
+	std::vector<double> mindist(nscen, std::numeric_limits<double>::infinity());
+	for (int s = 0; s < nscen; ++s)
+		for (int t = s + 1; t < nscen; ++t)
+		{
+			double d = dist(s, t);
+			if (d < mindist[s])
+			{
+				nearest[s] = t;
+				mindist[s] = d;
+			}
+			if (d < mindist[t])
+			{
+				nearest[t] = s;
+				mindist[t] = d;
+			}
+		}
+
+	std::vector<double> weight(prob.begin(), prob.begin() + nscen);
+	std::vector<bool> deleted(nscen, false);
+	for (int ndeleted = 0; ndeleted < nscen - nselect; ++ndeleted)
+	{
+		int u = -1;
+		for (int s = 0; s < nscen; ++s)
+			if (!deleted[s] && (u < 0 || weight[s] * mindist[s] < weight[u] * mindist[u]))
+				u = s;
+		deleted[u] = true;
+		weight[nearest[u]] += weight[u];
+
+		/** update the scenarios of which the nearest was the deleted one */
+		for (int s = 0; s < nscen; ++s)
+		{
+			if (deleted[s] || nearest[s] != u) continue;
+			nearest[s] = -1;
+			mindist[s] = std::numeric_limits<double>::infinity();
+			for (int t = 0; t < nscen; ++t)
+			{
+				if (deleted[t] || t == s) continue;
+				double d = dist(s, t);
+				if (d < mindist[s])
+				{
+					nearest[s] = t;
+					mindist[s] = d;
+				}
+			}
+		}
+	}
+
+	std::vector<int> kept;
+	for (int s = 0; s < nscen; ++s)
+		if (!deleted[s])
+			kept.push_back(s);
+
+	return assignNearest(nscen, dist, prob, kept, rep);
+}
+
+double DspKMedoids(
+		int nselect,
+		int nscen,
+		const std::function<double(int,int)> & dist,
+		const std::vector<double> & prob,
+		std::vector<int> & rep)
+{
+	rep.resize(nscen);
+	for (int s = 0; s < nscen; ++s)
+		rep[s] = s;
+	if (nselect <= 0 || nselect >= nscen)
+		return 0.0;
+
+	/** seed the medoids by the most probable scenario and the weighted farthest-point rule */
+	std::vector<int> medoids(1, std::max_element(prob.begin(), prob.begin() + nscen) - prob.begin());
+	std::vector<double> mindist(nscen);
+	for (int s = 0; s < nscen; ++s)
+		mindist[s] = dist(s, medoids[0]);
+	while ((int) medoids.size() < nselect)
+	{
+		int far = 0;
+		for (int s = 1; s < nscen; ++s)
+			if (prob[s] * mindist[s] > prob[far] * mindist[far])
+				far = s;
+		if (mindist[far] == 0.0) break;
+		medoids.push_back(far);
+		for (int s = 0; s < nscen; ++s)
+			mindist[s] = std::min(mindist[s], dist(s, far));
+	}
+
+	double kantorovich = assignNearest(nscen, dist, prob, medoids, rep);
+	for (int iter = 0; iter < 100; ++iter)
+	{
+		/** move each medoid to the member minimizing the weighted distance to the other members */
+		std::vector<std::vector<int> > clusters(nscen);
+		for (int s = 0; s < nscen; ++s)
+			clusters[rep[s]].push_back(s);
+		bool changed = false;
+		for (unsigned k = 0; k < medoids.size(); ++k)
+		{
+			const std::vector<int> & members = clusters[medoids[k]];
+			int best = medoids[k];
+			double best_cost = 0.0;
+			for (unsigned j = 0; j < members.size(); ++j)
+				if (members[j] != best)
+					best_cost += prob[members[j]] * dist(members[j], best);
+			for (unsigned i = 0; i < members.size(); ++i)
+			{
+				if (members[i] == medoids[k]) continue;
+				double cost = 0.0;
+				for (unsigned j = 0; j < members.size() && cost < best_cost; ++j)
+					if (j != i)
+						cost += prob[members[j]] * dist(members[j], members[i]);
+				if (cost < best_cost)
+				{
+					best = members[i];
+					best_cost = cost;
+				}
+			}
+			if (best != medoids[k])
+			{
+				medoids[k] = best;
+				changed = true;
+			}
+		}
+		if (!changed) break;
+		kantorovich = assignNearest(nscen, dist, prob, medoids, rep);
+	}
+
+	return kantorovich;
+}
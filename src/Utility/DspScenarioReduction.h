@@ -0,0 +1,75 @@
+/*
+ * DspScenarioReduction.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#ifndef SRC_UTILITY_DSPSCENARIOREDUCTION_H_
+#define SRC_UTILITY_DSPSCENARIOREDUCTION_H_
+
+#include <vector>
+#include <functional>
+
+/**
+ * Find the identical scenarios, each of which is represented by a vector of its data.
+ *
+ * @return number of distinct scenarios
+ */
+int DspMergeIdenticalScenarios(
+		const std::vector<std::vector<double> > & data, /**< [in] data vector of each scenario */
+		std::vector<int> & rep                          /**< [out] smallest index of the scenarios identical to each scenario */);
+
+/**
+ * Reduce the scenarios by the forward selection of Heitsch and Roemisch.
+ *
+ * The scenarios are selected one at a time so that the Kantorovich distance between the
+ * original distribution and the distribution on the selected scenarios is minimized. The
+ * probability of each unselected scenario is redistributed to its nearest selected scenario.
+ * As in the backward reduction, the distances are evaluated on demand.
+ *
+ * @return Kantorovich distance between the original and the reduced distributions
+ */
+double DspForwardSelection(
+		int nselect,                                  /**< [in] number of scenarios to select */
+		int nscen,                                    /**< [in] number of scenarios */
+		const std::function<double(int,int)> & dist,  /**< [in] distance of two scenarios */
+		const std::vector<double> & prob,             /**< [in] probability of each scenario */
+		std::vector<int> & rep                        /**< [out] selected scenario representing each scenario */);
+
+/**
+ * Reduce the scenarios by the fast backward reduction of Dupacova, Growe-Kuska and Roemisch.
+ *
+ * The scenarios are deleted one at a time. Each step deletes the remaining scenario of which
+ * accumulated probability times the distance to its nearest remaining scenario is the smallest,
+ * and moves the probability to the nearest remaining scenario. Each deleted scenario is finally
+ * represented by its nearest remaining scenario. The distances are evaluated on demand, so that
+ * the distance matrix of a large number of scenarios is not stored.
+ *
+ * @return Kantorovich distance between the original and the reduced distributions
+ */
+double DspBackwardReduction(
+		int nselect,                                  /**< [in] number of scenarios to keep */
+		int nscen,                                    /**< [in] number of scenarios */
+		const std::function<double(int,int)> & dist,  /**< [in] distance of two scenarios */
+		const std::vector<double> & prob,             /**< [in] probability of each scenario */
+		std::vector<int> & rep                        /**< [out] kept scenario representing each scenario */);
+
+/**
+ * Cluster the scenarios by the k-medoids, where the medoids are the kept scenarios.
+ *
+ * The medoids are seeded by the most probable scenario and the weighted farthest-point rule.
+ * Each scenario is then assigned to its nearest medoid, and the medoid of each cluster is moved
+ * to the member minimizing the probability-weighted distance to the other members, until the
+ * medoids do not change. The distances are evaluated on demand.
+ *
+ * @return Kantorovich distance between the original and the reduced distributions
+ */
+double DspKMedoids(
+		int nselect,                                  /**< [in] number of medoids */
+		int nscen,                                    /**< [in] number of scenarios */
+		const std::function<double(int,int)> & dist,  /**< [in] distance of two scenarios */
+		const std::vector<double> & prob,             /**< [in] probability of each scenario */
+		std::vector<int> & rep                        /**< [out] medoid representing each scenario */);
+
+#endif /* SRC_UTILITY_DSPSCENARIOREDUCTION_H_ */
@@ -0,0 +1,142 @@
+/*
+ * DspSolutionPool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#include <cmath>
+#include <functional>
+#include "Utility/DspSolutionPool.h"
+
+DspSolutionPool::DspSolutionPool(double tolerance, int capacity) :
+tolerance_(tolerance),
+quantum_(100 * tolerance),
+capacity_(capacity),
+nevicted_(0) {}
+
+DspSolutionPool::DspSolutionPool(const DspSolutionPool & rhs) :
+tolerance_(rhs.tolerance_),
+quantum_(rhs.quantum_),
+capacity_(rhs.capacity_),
+nevicted_(rhs.nevicted_) {
+	/** copy in the same recency order */
+	for (EntryList::const_iterator it = rhs.lru_.begin(); it != rhs.lru_.end(); ++it)
+	{
+		Entry e = *it;
+		e.vec = new CoinPackedVector(*(it->vec));
+		lru_.push_back(e);
+		buckets_.insert(std::make_pair(e.key, --lru_.end()));
+	}
+}
+
+DspSolutionPool::~DspSolutionPool()
+{
+	clear();
+}
+
+void DspSolutionPool::setCapacity(int capacity)
+{
+	capacity_ = capacity;
+	evict();
+}
+
+size_t DspSolutionPool::hashKey(const CoinPackedVector & x) const
+{
+	std::hash<long long> h;
+	size_t key = h(x.getNumElements());
+	for (int i = 0; i < x.getNumElements(); ++i)
+	{
+		long long q = llround(x.getElements()[i] / quantum_);
+		/** The element is dropped if it rounds to zero. */
+		if (q == 0) continue;
+		key ^= h(x.getIndices()[i]) + 0x9e3779b9 + (key << 6) + (key >> 2);
+		key ^= h(q) + 0x9e3779b9 + (key << 6) + (key >> 2);
+	}
+	return key;
+}
+
+bool DspSolutionPool::isEqual(const CoinPackedVector & x, const CoinPackedVector & y) const
+{
+	if (x.getNumElements() != y.getNumElements())
+		return false;
+	for (int i = 0; i < x.getNumElements(); ++i)
+	{
+		if (x.getIndices()[i] != y.getIndices()[i])
+			return false;
+		if (fabs(x.getElements()[i] - y.getElements()[i]) >= tolerance_)
+			return false;
+	}
+	return true;
+}
+
+const CoinPackedVector * DspSolutionPool::find(const CoinPackedVector & x)
+{
+	size_t key = hashKey(x);
+	std::pair<std::unordered_multimap<size_t, EntryList::iterator>::iterator,
+		std::unordered_multimap<size_t, EntryList::iterator>::iterator> range = buckets_.equal_range(key);
+	for (std::unordered_multimap<size_t, EntryList::iterator>::iterator it = range.first; it != range.second; ++it)
+	{
+		if (isEqual(x, *(it->second->vec)))
+		{
+			/** move to the most recently used */
+			lru_.splice(lru_.begin(), lru_, it->second);
+			return lru_.front().vec;
+		}
+	}
+	return NULL;
+}
+
+void DspSolutionPool::insert(CoinPackedVector * x)
+{
+	Entry e;
+	e.vec = x;
+	e.key = hashKey(*x);
+	e.pinned = true;
+	lru_.push_front(e);
+	buckets_.insert(std::make_pair(e.key, lru_.begin()));
+	evict();
+}
+
+void DspSolutionPool::release()
+{
+	for (EntryList::iterator it = lru_.begin(); it != lru_.end(); ++it)
+		it->pinned = false;
+	evict();
+}
+
+void DspSolutionPool::evict()
+{
+	if (capacity_ <= 0) return;
+
+	EntryList::iterator it = lru_.end();
+	while (lru_.size() > static_cast<size_t>(capacity_) && it != lru_.begin())
+	{
+		--it;
+		if (it->pinned) continue;
+
+		/** remove from the bucket */
+		std::pair<std::unordered_multimap<size_t, EntryList::iterator>::iterator,
+			std::unordered_multimap<size_t, EntryList::iterator>::iterator> range = buckets_.equal_range(it->key);
+		for (std::unordered_multimap<size_t, EntryList::iterator>::iterator b = range.first; b != range.second; ++b)
+		{
+			if (b->second == it)
+			{
+				buckets_.erase(b);
+				break;
+			}
+		}
+
+		delete it->vec;
+		it = lru_.erase(it);
+		nevicted_++;
+	}
+}
+
+void DspSolutionPool::clear()
+{
+	for (EntryList::iterator it = lru_.begin(); it != lru_.end(); ++it)
+		delete it->vec;
+	lru_.clear();
+	buckets_.clear();
+}
@@ -0,0 +1,93 @@
+/*
+ * DspSolutionPool.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#ifndef SRC_UTILITY_DSPSOLUTIONPOOL_H_
+#define SRC_UTILITY_DSPSOLUTIONPOOL_H_
+
+#include <list>
+#include <unordered_map>
+#include "Utility/DspTypes.h"
+
+/**
+ * Pool of sparse solutions indexed by hash for duplicate detection.
+ *
+ * Solution elements are quantized to build the hash key, and the solutions in
+ * the same bucket are compared element-wise with the tolerance. Two solutions
+ * within the tolerance may fall into different buckets if an element is close
+ * to a quantization boundary; such a solution is simply stored twice.
+ *
+ * The pool owns the solutions. If the capacity is positive, the least recently
+ * used solutions are freed when the pool exceeds the capacity. Newly inserted
+ * solutions are pinned until release() is called, so that the pointers handed
+ * out to the caller remain valid until they are consumed.
+ */
+class DspSolutionPool
+{
+public:
+
+	/** A default constructor. */
+	DspSolutionPool(
+			double tolerance = 1.0e-8, /**< tolerance of element-wise comparison */
+			int    capacity = 0        /**< maximum number of solutions (0 for no limit) */);
+
+	/** A copy constructor. */
+	DspSolutionPool(const DspSolutionPool & rhs);
+
+	/** A default destructor. */
+	virtual ~DspSolutionPool();
+
+	/** set the maximum number of solutions (0 for no limit) */
+	void setCapacity(int capacity);
+
+	/** find a solution within the tolerance; return NULL if there is none */
+	const CoinPackedVector * find(const CoinPackedVector & x);
+
+	/** insert a solution; the pool takes the ownership */
+	void insert(CoinPackedVector * x);
+
+	/** unpin all the solutions so that they can be evicted */
+	void release();
+
+	/** free all the solutions */
+	void clear();
+
+	/** number of solutions */
+	size_t size() const {return lru_.size();}
+
+	/** number of evicted solutions */
+	int getNumEvicted() const {return nevicted_;}
+
+private:
+
+	struct Entry
+	{
+		CoinPackedVector * vec; /**< solution */
+		size_t key;             /**< hash key */
+		bool pinned;            /**< whether the solution can be evicted */
+	};
+
+	typedef std::list<Entry> EntryList;
+
+	/** hash key of the quantized solution */
+	size_t hashKey(const CoinPackedVector & x) const;
+
+	/** whether two solutions are equal within the tolerance */
+	bool isEqual(const CoinPackedVector & x, const CoinPackedVector & y) const;
+
+	/** evict the least recently used solutions not pinned */
+	void evict();
+
+	double tolerance_; /**< tolerance of element-wise comparison */
+	double quantum_;   /**< quantization step of the hash key */
+	int capacity_;     /**< maximum number of solutions */
+	int nevicted_;     /**< number of evicted solutions */
+
+	EntryList lru_; /**< solutions from the most recently used */
+	std::unordered_multimap<size_t, EntryList::iterator> buckets_; /**< hash buckets */
+};
+
+#endif /* SRC_UTILITY_DSPSOLUTIONPOOL_H_ */
@@ -0,0 +1,117 @@
+/*
+ * DspWasserstein.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#include <vector>
+#include <algorithm>
+#include "Utility/DspWasserstein.h"
+
+/** order of the scenarios by increasing distance and decreasing value */
+struct WassersteinOrder
+{
+	const double * r;
+	const double * d;
+	bool operator()(int i, int j) const {
+		return d[i] < d[j] || (d[i] == d[j] && r[i] > r[j]);
+	}
+};
+
+bool DspWassersteinWorstCase(
+		int n,
+		const double * r,
+		const double * d,
+		double eps,
+		double * p)
+{
+	for (int i = 0; i < n; ++i)
+		p[i] = 0.0;
+
+	std::vector<int> order(n);
+	for (int i = 0; i < n; ++i)
+		order[i] = i;
+	WassersteinOrder cmp = {r, d};
+	std::sort(order.begin(), order.end(), cmp);
+	if (n == 0 || d[order[0]] > eps)
+		return false;
+
+	/** upper concave hull of (d_i, r_i); only the best scenario is kept for each distance */
+	std::vector<int> hull;
+	for (int k = 0; k < n; ++k)
+	{
+		int i = order[k];
+		if (k > 0 && d[i] == d[order[k-1]]) continue;
+		while (hull.size() >= 2)
+		{
+			int a = hull[hull.size() - 2];
+			int b = hull.back();
+			/** remove b if it lies on or below the segment from a to i */
+			if ((r[b] - r[a]) * (d[i] - d[a]) <= (r[i] - r[a]) * (d[b] - d[a]))
+				hull.pop_back();
+			else
+				break;
+		}
+		hull.push_back(i);
+	}
+
+	/** The hull is increasing up to its peak, so the optimum is at the peak or at distance eps. */
+	unsigned k = 0;
+	while (k + 1 < hull.size() && r[hull[k+1]] > r[hull[k]] && d[hull[k+1]] <= eps)
+		k++;
+	int a = hull[k];
+	if (k + 1 == hull.size() || r[hull[k+1]] <= r[a])
+		p[a] = 1.0;
+	else
+	{
+		/** mix the two scenarios so that the distance is eps */
+		int b = hull[k+1];
+		p[b] = (eps - d[a]) / (d[b] - d[a]);
+		p[a] = 1.0 - p[b];
+	}
+
+	return true;
+}
+
+/** order of the pairs by increasing distance and index */
+struct DistanceOrder
+{
+	const double * d;
+	bool operator()(int i, int j) const {
+		return d[i] < d[j] || (d[i] == d[j] && i < j);
+	}
+};
+
+int DspWassersteinSparsify(
+		int n,
+		const double * d,
+		int knearest,
+		double cutoff,
+		std::vector<int> & keep)
+{
+	keep.clear();
+	if (knearest <= 0 || knearest >= n)
+	{
+		for (int i = 0; i < n; ++i)
+			if (cutoff < 0.0 || d[i] <= cutoff || d[i] == 0.0)
+				keep.push_back(i);
+		return keep.size();
+	}
+
+	/** partition the knearest pairs */
+	std::vector<int> order(n);
+	for (int i = 0; i < n; ++i)
+		order[i] = i;
+	DistanceOrder less = {d};
+	std::nth_element(order.begin(), order.begin() + knearest - 1, order.end(), less);
+
+	std::vector<bool> kept(n, false);
+	for (int k = 0; k < knearest; ++k)
+		kept[order[k]] = true;
+	for (int i = 0; i < n; ++i)
+		if (d[i] == 0.0 || (kept[i] && (cutoff < 0.0 || d[i] <= cutoff)))
+			keep.push_back(i);
+
+	return keep.size();
+}
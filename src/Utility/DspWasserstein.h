@@ -0,0 +1,48 @@
+/*
+ * DspWasserstein.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#ifndef SRC_UTILITY_DSPWASSERSTEIN_H_
+#define SRC_UTILITY_DSPWASSERSTEIN_H_
+
+#include <vector>
+
+/**
+ * Find the worst-case distribution in the Wasserstein ball around a single reference
+ * distribution, which is the distribution separation problem
+ *
+ *   max_p sum_i r_i p_i  s.t.  sum_i d_i p_i <= eps, sum_i p_i = 1, p >= 0,
+ *
+ * where d_i is the distance from the reference to scenario i. The problem has an optimal
+ * solution with at most two positive probabilities, which lie on the upper concave hull
+ * of the points (d_i, r_i). This finds the solution in O(n log n) without solving the LP.
+ *
+ * @return false if the problem is infeasible (i.e., every d_i > eps)
+ */
+bool DspWassersteinWorstCase(
+		int n,            /**< [in] number of scenarios */
+		const double * r, /**< [in] objective coefficient (recourse value) of each scenario */
+		const double * d, /**< [in] distance from the reference to each scenario */
+		double eps,       /**< [in] size of the Wasserstein ball */
+		double * p        /**< [out] worst-case probability of each scenario */);
+
+/**
+ * Select the transport pairs of a scenario kept in a sparsified Wasserstein ambiguity set.
+ *
+ * A pair is kept if it is one of the knearest pairs of the smallest distances (ties broken
+ * by index) and its distance does not exceed the cutoff. The pairs of zero distance are always
+ * kept. A nonpositive knearest keeps the pairs of any rank, and a negative cutoff any distance.
+ *
+ * @return number of the kept pairs
+ */
+int DspWassersteinSparsify(
+		int n,                   /**< [in] number of pairs (i.e., references) */
+		const double * d,        /**< [in] distance of each pair */
+		int knearest,            /**< [in] maximum number of the kept pairs */
+		double cutoff,           /**< [in] maximum distance of the kept pairs */
+		std::vector<int> & keep  /**< [out] indices of the kept pairs in increasing order */);
+
+#endif /* SRC_UTILITY_DSPWASSERSTEIN_H_ */
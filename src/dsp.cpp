@@ -7,12 +7,13 @@
 
 #include "DspConfig.h"
 #include <iostream>
+#include <algorithm>
 #include "CoinMpsIO.hpp"
 #include "DspCInterface.h"
 
 const char *gDspUsage =
 	"Not enough or invalid arguments, please try again.\n\n"
-	"Usage: --algo <de,bd,dd,drbd,drdd,dw> [--wassnorm <number> --wasseps <number>] --smps <smps file> --mps <mps file> --dec <dec file> [--soln <solution file prefix> --param <param file> --test <benchmark objective value>]\n\n"
+	"Usage: --algo <de,bd,dd,drbd,drdd,dw> [--wassnorm <number> --wasseps <number>] --smps <smps file> --mps <mps file> --dec <dec file> [--soln <solution file prefix> --param <param file> --test <benchmark objective value> --profile <profile file> --restart <checkpoint file> --initlambda <multiplier file> --initcols <column file> --initsol <incumbent file> --bundles <number of bundles> --bundle-file <bundle file> --reduce <number of scenarios> --reduce-method <backward,kmedoids> --reduce-out <smps file>]\n\n"
 	"       --algo\t\tchoice of algorithms.\n"
 	"             \t\tde: deterministic equivalent form\n"
 	"             \t\tbd: Benders decomposition\n"
@@ -27,11 +28,25 @@ const char *gDspUsage =
 	"       --dec\t\tDEC file name\n"
 	"       --soln\t\toptional argument for solution file prefix. For example, if the prefix is given as MySol, then two files MySol.primal.txt and MySol.dual.txt will be written for primal and dual solutions, respectively.\n"
 	"       --param\t\toptional paramater for parameter file name\n"
-	"       --test\t\toptional parameter for testing objective value\n";
+	"       --test\t\toptional parameter for testing objective value\n"
+	"       --profile\toptional argument for profile report file name. The report is written in JSON if the name ends with .json, and in CSV otherwise.\n"
+	"       --restart\toptional argument for the checkpoint file from which dd or dw resumes. The dd checkpoints are written every DD/CHECKPOINT/FREQ iterations to DD/CHECKPOINT/FILE, and the dw checkpoints to DW/CHECKPOINT/FILE.\n"
+	"       --initlambda\toptional argument for the file of initial Lagrangian multipliers of the coupling rows for dd, given as whitespace-separated numbers.\n"
+	"       --initcols\toptional argument for the file of initial columns for dw. Each column is given as a subproblem index, the number of its columns, and the subproblem solution.\n"
+	"       --initsol\toptional argument for the file of an initial incumbent for dd and dw, given as the values of the coupling (first-stage) variables.\n"
+	"       --bundles\toptional argument for the number of scenario bundles for dd, dw and bd. The scenarios are clustered into the bundles by similarity, and each bundle is solved as a single subproblem.\n"
+	"       --bundle-file\toptional argument for the file of the bundle of each scenario, given as whitespace-separated bundle indices numbered from zero. This overrides --bundles.\n"
+	"       --reduce\toptional argument for the number of scenarios to which the scenarios of the smps files are reduced before solving.\n"
+	"       --reduce-method\toptional argument for the scenario reduction method.\n"
+	"             \t\tbackward: fast backward reduction (default)\n"
+	"             \t\tkmedoids: k-medoids clustering\n"
+	"       --reduce-out\toptional argument for the SMPS file name without extensions, to which the reduced scenarios are written. --algo is optional with this argument.\n";
 
 void setBlockIds(DspApiEnv* env, int nsubprobs, bool master_has_subblocks);
-int runDsp(char *algotype, char *smpsfile, char *mpsfile, char *decfile, char *solnfile, char *paramfile, char *testvalue, double wassparams[2]);
+int runDsp(char *algotype, char *smpsfile, char *mpsfile, char *decfile, char *solnfile, char *paramfile, char *testvalue, char *profilefile, char *restartfile, char *warmfiles[3], int nbundles, char *bundlefile, double wassparams[2], int nreduce, char *reduceargs[2]);
 int readMpsDec(DspApiEnv* env, char* mpsfile, char* decfile);
+int readWarmStart(DspApiEnv* env, char* warmfiles[3]);
+int readBundles(DspApiEnv* env, char* bundlefile);
 int parseDecFile(char* decfile, vector<vector<string> >& rows_in_blocks);
 void createBlockModel(DspApiEnv* env, CoinMpsIO& p, const CoinPackedMatrix* mat, 
 	int blockid, vector<string>& rows_in_block, map<string,int>& rowname2index, 
@@ -73,7 +88,14 @@ int main(int argc, char* argv[]) {
 		char* solnfile = NULL;
 		char* paramfile = NULL;
 		char* testvalue = NULL;
+		char* profilefile = NULL;
+		char* restartfile = NULL;
+		char* warmfiles[3] = {NULL, NULL, NULL};
+		int nbundles = 0;
+		char* bundlefile = NULL;
 		double wassparams[2] = {-1.0, -1.0};
+		int nreduce = 0;
+		char* reduceargs[2] = {NULL, NULL};
 		for (int i = 1; i < argc; i += 2) {
 			if (i + 1 != argc) {
 				if (string(argv[i]) == "--algo")
@@ -94,6 +116,26 @@ int main(int argc, char* argv[]) {
 					paramfile = argv[i+1];
 				else if (string(argv[i]) == "--test")
 					testvalue = argv[i+1];
+				else if (string(argv[i]) == "--profile")
+					profilefile = argv[i+1];
+				else if (string(argv[i]) == "--restart")
+					restartfile = argv[i+1];
+				else if (string(argv[i]) == "--initlambda")
+					warmfiles[0] = argv[i+1];
+				else if (string(argv[i]) == "--initcols")
+					warmfiles[1] = argv[i+1];
+				else if (string(argv[i]) == "--initsol")
+					warmfiles[2] = argv[i+1];
+				else if (string(argv[i]) == "--bundles")
+					nbundles = atoi(argv[i+1]);
+				else if (string(argv[i]) == "--bundle-file")
+					bundlefile = argv[i+1];
+				else if (string(argv[i]) == "--reduce")
+					nreduce = atoi(argv[i+1]);
+				else if (string(argv[i]) == "--reduce-method")
+					reduceargs[0] = argv[i+1];
+				else if (string(argv[i]) == "--reduce-out")
+					reduceargs[1] = argv[i+1];
 				else
 				{
 					EXIT_WITH_MSG
@@ -101,8 +143,8 @@ int main(int argc, char* argv[]) {
 			}
 		}
 
-		// algotype is required.
-		if (algotype == NULL) {
+		// algotype is required, unless the reduced scenarios are written.
+		if (algotype == NULL && reduceargs[1] == NULL) {
 			EXIT_WITH_MSG
 		}
 
@@ -111,8 +153,16 @@ int main(int argc, char* argv[]) {
 			EXIT_WITH_MSG
 		}
 
+		// Scenario reduction is for smps files.
+		if ((nreduce > 0 || reduceargs[1] != NULL) && smpsfile == NULL) {
+			EXIT_WITH_MSG
+		}
+		if (reduceargs[0] != NULL && string(reduceargs[0]) != "backward" && string(reduceargs[0]) != "kmedoids") {
+			EXIT_WITH_MSG
+		}
+
 		// run dsp
-		int ret = runDsp(algotype, smpsfile, mpsfile, decfile, solnfile, paramfile, testvalue, wassparams);
+		int ret = runDsp(algotype, smpsfile, mpsfile, decfile, solnfile, paramfile, testvalue, profilefile, restartfile, warmfiles, nbundles, bundlefile, wassparams, nreduce, reduceargs);
 
 #ifdef DSP_HAS_MPI
 		MPI_Finalize();
@@ -122,7 +172,7 @@ int main(int argc, char* argv[]) {
 #undef EXIT_WITH_MSG
 }
 
-int runDsp(char *algotype, char *smpsfile, char *mpsfile, char *decfile, char *solnfile, char *paramfile, char *testvalue, double wassparams[2])
+int runDsp(char *algotype, char *smpsfile, char *mpsfile, char *decfile, char *solnfile, char *paramfile, char *testvalue, char *profilefile, char *restartfile, char *warmfiles[3], int nbundles, char *bundlefile, double wassparams[2], int nreduce, char *reduceargs[2])
 {
 
 	int ret = 0;
@@ -149,7 +199,6 @@ int runDsp(char *algotype, char *smpsfile, char *mpsfile, char *decfile, char *s
 			cout << "Second stage: " << getNumRows(env,1) << " rows, " << getNumCols(env,1) << " cols, " << getNumIntegers(env,1) << " integers" << endl;
 			cout << "Number of scenarios: " << getNumSubproblems(env) << endl;
 		}
-		setBlockIds(env, getNumSubproblems(env), true);
 	} else if (mpsfile != NULL && decfile != NULL) {
 		if (isroot) {
 			cout << "Reading MPS file: " << mpsfile << endl;
@@ -165,6 +214,58 @@ int runDsp(char *algotype, char *smpsfile, char *mpsfile, char *decfile, char *s
 		readParamFile(env, paramfile);
 	}
 
+	if (nreduce > 0) {
+		if (isroot) cout << "Reducing the scenarios to " << nreduce << " scenarios" << endl;
+		int method = reduceargs[0] != NULL && string(reduceargs[0]) == "kmedoids" ? SCEN_KMEDOIDS : SCEN_BACKWARD;
+		ret = reduceScenarios(env, nreduce, method);
+		if (ret != 0) return ret;
+	}
+
+	if (reduceargs[1] != NULL) {
+		if (isroot) {
+			cout << "Writing SMPS files: " << reduceargs[1] << endl;
+			ret = writeSmps(env, reduceargs[1]);
+			if (ret != 0) return ret;
+		}
+		if (algotype == NULL) {
+			freeEnv(env);
+			return 0;
+		}
+	}
+
+	if (bundlefile != NULL) {
+		if (isroot) cout << "Reading scenario bundles: " << bundlefile << endl;
+		ret = readBundles(env, bundlefile);
+		if (ret != 0) return ret;
+	} else if (nbundles > 0) {
+		if (isroot) cout << "Number of scenario bundles: " << nbundles << endl;
+		setIntParam(env, "NUM_BUNDLES", nbundles);
+	}
+
+	// Assign scenarios (or scenario bundles) to each process
+	if (isstochastic) {
+		int nsubprobs = getNumSubproblems(env);
+		if (env->par_->getIntPtrParamSize("ARR_BUNDLE_IDX") > 0) {
+			const int* bundles = env->par_->getIntPtrParam("ARR_BUNDLE_IDX");
+			nsubprobs = 1 + *std::max_element(bundles, bundles + env->par_->getIntPtrParamSize("ARR_BUNDLE_IDX"));
+		} else if (env->par_->getIntParam("NUM_BUNDLES") > 0)
+			nsubprobs = CoinMin(nsubprobs, env->par_->getIntParam("NUM_BUNDLES"));
+		setBlockIds(env, nsubprobs, true);
+	}
+
+	if (profilefile != NULL) {
+		if (isroot) cout << "Writing profile report: " << profilefile << endl;
+		setProfile(env, profilefile);
+	}
+
+	if (restartfile != NULL) {
+		if (isroot) cout << "Restarting from checkpoint: " << restartfile << endl;
+		setRestart(env, restartfile);
+	}
+
+	ret = readWarmStart(env, warmfiles);
+	if (ret != 0) return ret;
+
 	if (string(algotype) == "de") {
 		solveDe(env);
 	} else if (string(algotype) == "bd") {
@@ -429,6 +530,74 @@ void setBlockIds(DspApiEnv* env, int nsubprobs, bool master_has_subblocks) {
 	setIntPtrParam(env, "ARR_PROC_IDX", (int) proc_idx_set.size(), &proc_idx_set[0]);
 }
 
+/** read whitespace-separated numbers from a file */
+static int readNumbers(const char* filename, vector<double>& vals) {
+	ifstream file(filename);
+	if (!file.is_open()) {
+		cerr << "Failed to open the file " << filename << endl;
+		return -1;
+	}
+	double val;
+	while (file >> val)
+		vals.push_back(val);
+	if (!file.eof()) {
+		cerr << "Invalid number in the file " << filename << endl;
+		return -1;
+	}
+	return 0;
+}
+
+int readWarmStart(DspApiEnv* env, char* warmfiles[3]) {
+	bool isroot = true;
+#ifdef DSP_HAS_MPI
+	int comm_rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &comm_rank);
+	isroot = comm_rank == 0 ? true : false;
+#endif
+	vector<double> vals;
+
+	// initial multipliers
+	if (warmfiles[0] != NULL) {
+		if (isroot) cout << "Reading initial multipliers: " << warmfiles[0] << endl;
+		if (readNumbers(warmfiles[0], vals) != 0) return -1;
+		if (setInitialMultipliers(env, vals.size(), vals.data()) != DSP_RTN_OK) return -1;
+		vals.clear();
+	}
+
+	// initial columns, each of which is given by [block, size, solution]
+	if (warmfiles[1] != NULL) {
+		if (isroot) cout << "Reading initial columns: " << warmfiles[1] << endl;
+		if (readNumbers(warmfiles[1], vals) != 0) return -1;
+		for (unsigned pos = 0; pos < vals.size(); ) {
+			int size = pos + 1 < vals.size() ? static_cast<int>(vals[pos+1]) : -1;
+			if (size < 0 || pos + 2 + size > vals.size()) {
+				cerr << "Invalid column in the file " << warmfiles[1] << endl;
+				return -1;
+			}
+			if (addInitialColumn(env, static_cast<int>(vals[pos]), size, vals.data() + pos + 2) != DSP_RTN_OK) return -1;
+			pos += 2 + size;
+		}
+		vals.clear();
+	}
+
+	// initial incumbent
+	if (warmfiles[2] != NULL) {
+		if (isroot) cout << "Reading initial incumbent: " << warmfiles[2] << endl;
+		if (readNumbers(warmfiles[2], vals) != 0) return -1;
+		if (setInitialIncumbent(env, vals.size(), vals.data()) != DSP_RTN_OK) return -1;
+	}
+
+	return 0;
+}
+
+int readBundles(DspApiEnv* env, char* bundlefile) {
+	vector<double> vals;
+	if (readNumbers(bundlefile, vals) != 0) return -1;
+	vector<int> bundles(vals.begin(), vals.end());
+	if (setScenarioBundles(env, bundles.size(), bundles.data()) != DSP_RTN_OK) return -1;
+	return 0;
+}
+
 int readMpsDec(DspApiEnv* env, char* mpsfile, char* decfile) {
 	int ret = 0;
 	// Read .mps file
@@ -0,0 +1,94 @@
+/*
+ * genSmps.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kibaekkim
+ */
+
+#include "DspConfig.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "Model/TssModel.h"
+
+const char *gGenSmpsUsage =
+	"Not enough or invalid arguments, please try again.\n\n"
+	"Usage: --smps <smps file> --nscen <number> --out <file prefix> [--seed <number> --rhs <number> --obj <number> --mat <number> --mpsdec]\n\n"
+	"       --smps\t\tSMPS file name without extensions of the base instance\n"
+	"       --nscen\t\tnumber of scenarios to generate. The scenarios of the base instance are cloned in round-robin fashion.\n"
+	"       --out\t\toutput file name without extensions\n"
+	"       --seed\t\toptional random seed (default: 1)\n"
+	"       --rhs\t\toptional relative perturbation in [0,1) of the second-stage right-hand sides (default: 0.0)\n"
+	"       --obj\t\toptional relative perturbation in [0,1) of the second-stage objective coefficients (default: 0.0)\n"
+	"       --mat\t\toptional relative perturbation in [0,1) of the technology matrix (default: 0.0)\n"
+	"       --mpsdec\t\toptionally write the extensive form in MPS and DEC files instead of SMPS files\n";
+
+/*
+ This will compile a stand-alone binary file that generates synthetic instances
+ of arbitrary numbers of scenarios from an SMPS instance.
+*/
+int main(int argc, char* argv[]) {
+
+	char* smpsfile = NULL;
+	char* outfile = NULL;
+	int nscen = 0;
+	unsigned seed = 1;
+	double perturb[3] = {0.0, 0.0, 0.0};
+	bool mpsdec = false;
+
+	for (int i = 1; i < argc; ++i) {
+		if (string(argv[i]) == "--mpsdec") {
+			mpsdec = true;
+			continue;
+		}
+		if (i + 1 == argc) {
+			cout << gGenSmpsUsage;
+			return 1;
+		}
+		if (string(argv[i]) == "--smps")
+			smpsfile = argv[++i];
+		else if (string(argv[i]) == "--nscen")
+			nscen = atoi(argv[++i]);
+		else if (string(argv[i]) == "--out")
+			outfile = argv[++i];
+		else if (string(argv[i]) == "--seed")
+			seed = strtoul(argv[++i], NULL, 10);
+		else if (string(argv[i]) == "--rhs")
+			perturb[0] = atof(argv[++i]);
+		else if (string(argv[i]) == "--obj")
+			perturb[1] = atof(argv[++i]);
+		else if (string(argv[i]) == "--mat")
+			perturb[2] = atof(argv[++i]);
+		else {
+			cout << gGenSmpsUsage;
+			return 1;
+		}
+	}
+
+	if (smpsfile == NULL || outfile == NULL || nscen <= 0 ||
+			perturb[0] < 0.0 || perturb[1] < 0.0 || perturb[2] < 0.0 ||
+			perturb[0] >= 1.0 || perturb[1] >= 1.0 || perturb[2] >= 1.0) {
+		cout << gGenSmpsUsage;
+		return 1;
+	}
+
+	TssModel model;
+	if (model.readSmps(smpsfile) != DSP_RTN_OK) {
+		cout << "Failed to read the SMPS files " << smpsfile << endl;
+		return 1;
+	}
+
+	int ret = mpsdec ?
+			model.writeMpsDec(outfile, nscen, perturb, seed) :
+			model.writeSmps(outfile, nscen, perturb, seed);
+	if (ret != DSP_RTN_OK) {
+		cout << "Failed to write the instance " << outfile << endl;
+		return 1;
+	}
+
+	cout << "Generated " << nscen << " scenarios from " << model.getNumScenarios()
+			<< " scenarios of " << smpsfile << " in " << outfile
+			<< (mpsdec ? ".mps and .dec" : ".cor, .tim and .sto") << endl;
+
+	return 0;
+}
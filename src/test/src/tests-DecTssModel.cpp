@@ -0,0 +1,393 @@
+// tests-DecTssModel.cpp
+#include "catch.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include "Model/DecTssModel.h"
+#include "Utility/DspParams.h"
+#include "Utility/DspScenarioReduction.h"
+
+/** min x + sum_s p_s c_s y_s s.t. x <= 10, a_s x + y_s >= d_s, for three scenarios */
+static DecTssModel * createThreeScenarioModel(const double * tech, const double * cost, const double * demand) {
+    DecTssModel * model = new DecTssModel;
+    model->setNumberOfScenarios(3);
+    model->setDimensions(1, 1, 1, 1);
+
+    CoinBigIndex start1[] = {0, 1};
+    int index1[] = {0};
+    double value1[] = {1.0};
+    double clbd1[] = {0.0}, cubd1[] = {10.0}, obj1[] = {1.0};
+    double rlbd1[] = {-COIN_DBL_MAX}, rubd1[] = {10.0};
+    model->loadFirstStage(start1, index1, value1, clbd1, cubd1, "C", obj1, rlbd1, rubd1);
+
+    const double prob[] = {0.2, 0.3, 0.5};
+    CoinBigIndex start2[] = {0, 2};
+    int index2[] = {0, 1};
+    double clbd2[] = {0.0}, cubd2[] = {100.0}, rubd2[] = {COIN_DBL_MAX};
+    for (int s = 0; s < 3; ++s) {
+        double value2[] = {tech[s], 1.0};
+        double obj2[] = {cost[s]}, rlbd2[] = {demand[s]};
+        model->loadSecondStage(s, prob[s], start2, index2, value2, clbd2, cubd2, "C", obj2, rlbd2, rubd2);
+    }
+    return model;
+}
+
+TEST_CASE("Scenario bundles of a two-stage model") {
+    const double tech[] = {1.0, 1.0, 1.0};
+    const double cost[] = {1.0, 2.0, 3.0};
+    const double demand[] = {1.0, 2.0, 3.0};
+    DecTssModel * model = createThreeScenarioModel(tech, cost, demand);
+    const int bundles[] = {0, 1, 0};
+    DecTssModel * bundled = NULL;
+    REQUIRE(model->createBundledModel(2, bundles, bundled) == DSP_RTN_OK);
+    REQUIRE(bundled != NULL);
+
+    SECTION("bundle dimensions and probabilities") {
+        REQUIRE(bundled->getNumScenarios() == 2);
+        REQUIRE(bundled->getNumCols(0) == 1);
+        REQUIRE(bundled->getNumCols(1) == 2);
+        REQUIRE(bundled->getNumRows(1) == 2);
+        REQUIRE(bundled->getProbability()[0] == Approx(0.7));
+        REQUIRE(bundled->getProbability()[1] == Approx(0.3));
+    }
+
+    SECTION("scenarios in a bundle and padding") {
+        CoinPackedMatrix * mat_tech = NULL;
+        CoinPackedMatrix * mat_reco = NULL;
+        double * clbd = NULL, * cubd = NULL, * obj = NULL, * rlbd = NULL, * rubd = NULL;
+        char * ctype = NULL;
+
+        /** scenarios 0 and 2, where the objective is weighted by the conditional probability */
+        REQUIRE(bundled->copyRecoProb(0, mat_tech, mat_reco, clbd, cubd, ctype, obj, rlbd, rubd, false) == DSP_RTN_OK);
+        REQUIRE(obj[0] == Approx(0.2 / 0.7 * 1.0));
+        REQUIRE(obj[1] == Approx(0.5 / 0.7 * 3.0));
+        REQUIRE(rlbd[0] == Approx(1.0));
+        REQUIRE(rlbd[1] == Approx(3.0));
+        REQUIRE(mat_reco->getCoefficient(0, 0) == Approx(1.0));
+        REQUIRE(mat_reco->getCoefficient(1, 1) == Approx(1.0));
+        REQUIRE(mat_reco->getCoefficient(0, 1) == 0.0);
+        delete mat_tech; delete mat_reco;
+        delete [] clbd; delete [] cubd; delete [] ctype; delete [] obj; delete [] rlbd; delete [] rubd;
+
+        /** scenario 1 followed by the padding fixed to zero */
+        REQUIRE(bundled->copyRecoProb(1, mat_tech, mat_reco, clbd, cubd, ctype, obj, rlbd, rubd, false) == DSP_RTN_OK);
+        REQUIRE(obj[0] == Approx(2.0));
+        REQUIRE(obj[1] == 0.0);
+        REQUIRE(cubd[1] == 0.0);
+        REQUIRE(rlbd[0] == Approx(2.0));
+        REQUIRE(rlbd[1] == -COIN_DBL_MAX);
+        REQUIRE(rubd[1] == COIN_DBL_MAX);
+        delete mat_tech; delete mat_reco;
+        delete [] clbd; delete [] cubd; delete [] ctype; delete [] obj; delete [] rlbd; delete [] rubd;
+    }
+
+    SECTION("unbundle solution") {
+        /** x, the scenarios 0 and 2 of bundle 0, and the scenario 1 and padding of bundle 1 */
+        const double bundledsol[] = {5.0, 10.0, 30.0, 20.0, 0.0};
+        double solution[4];
+        REQUIRE(model->unbundleSolution(2, bundles, bundledsol, solution) == DSP_RTN_OK);
+        REQUIRE(solution[0] == 5.0);
+        REQUIRE(solution[1] == 10.0);
+        REQUIRE(solution[2] == 20.0);
+        REQUIRE(solution[3] == 30.0);
+    }
+
+    SECTION("unbundle multipliers") {
+        const double bundledmul[] = {7.0, 3.0};
+        double multipliers[3];
+        REQUIRE(model->unbundleMultipliers(2, bundles, bundledmul, multipliers) == DSP_RTN_OK);
+        REQUIRE(multipliers[0] == Approx(2.0));
+        REQUIRE(multipliers[1] == Approx(3.0));
+        REQUIRE(multipliers[2] == Approx(5.0));
+        REQUIRE(multipliers[0] + multipliers[2] == Approx(bundledmul[0]));
+    }
+
+    SECTION("invalid bundles") {
+        DecTssModel * invalid = NULL;
+        const int outofrange[] = {0, 2, 0};
+        REQUIRE(model->createBundledModel(2, outofrange, invalid) == DSP_RTN_ERR);
+        REQUIRE(invalid == NULL);
+        const int empty[] = {0, 0, 0};
+        REQUIRE(model->createBundledModel(2, empty, invalid) == DSP_RTN_ERR);
+        REQUIRE(invalid == NULL);
+    }
+
+    delete bundled;
+    delete model;
+}
+
+TEST_CASE("Scenario reduction of a two-stage model") {
+    /** The scenarios differ only in the technology coefficients, where scenarios 0 and 1 are close. */
+    const double tech[] = {1.0, 1.1, 5.0};
+    const double cost[] = {1.0, 1.0, 1.0};
+    const double demand[] = {2.0, 2.0, 2.0};
+    DecTssModel * model = createThreeScenarioModel(tech, cost, demand);
+    double kantorovich = -1.0;
+
+    SECTION("no reduction") {
+        REQUIRE(model->reduceScenarios(3, SCEN_BACKWARD, &kantorovich) == DSP_RTN_OK);
+        REQUIRE(model->getNumScenarios() == 3);
+        REQUIRE(kantorovich == 0.0);
+    }
+
+    for (int method = SCEN_BACKWARD; method <= SCEN_KMEDOIDS; ++method) {
+        DYNAMIC_SECTION("reduce to two scenarios by method " << method) {
+            REQUIRE(model->reduceScenarios(2, method, &kantorovich) == DSP_RTN_OK);
+            REQUIRE(model->getNumScenarios() == 2);
+
+            /** scenario 0 is removed and its probability is moved to scenario 1 */
+            const double * prob = model->getProbability();
+            REQUIRE(prob[0] + prob[1] == Approx(1.0));
+            REQUIRE(prob[0] == Approx(0.5));
+            REQUIRE(prob[1] == Approx(0.5));
+            REQUIRE(kantorovich == Approx(0.2 * 0.1));
+
+            CoinPackedMatrix * mat_tech = NULL;
+            CoinPackedMatrix * mat_reco = NULL;
+            double * clbd = NULL, * cubd = NULL, * obj = NULL, * rlbd = NULL, * rubd = NULL;
+            char * ctype = NULL;
+            /** the kept scenarios are renumbered in order */
+            REQUIRE(model->copyRecoProb(0, mat_tech, mat_reco, clbd, cubd, ctype, obj, rlbd, rubd, false) == DSP_RTN_OK);
+            REQUIRE(mat_tech->getCoefficient(0, 0) == Approx(1.1));
+            delete mat_tech; delete mat_reco;
+            delete [] clbd; delete [] cubd; delete [] ctype; delete [] obj; delete [] rlbd; delete [] rubd;
+        }
+    }
+
+    SECTION("the distance is symmetric") {
+        REQUIRE(model->getScenarioDistance(0, 2, 1.0) == Approx(4.0));
+        REQUIRE(model->getScenarioDistance(2, 0, 1.0) == Approx(4.0));
+        REQUIRE(model->getScenarioDistance(1, 1, 1.0) == 0.0);
+    }
+
+    delete model;
+}
+
+/**
+ * the farmer instance of examples/smps, where the first-stage variables are continuous;
+ * the coefficients of x8 (the last column) in cons3 are random if recourse is given
+ */
+static void writeFarmerSmps(const char * filename, const double * recourse = NULL) {
+    std::string name(filename);
+    std::ofstream cor((name + ".cor").c_str());
+    cor << "NAME          FARMER\n"
+        << "ROWS\n"
+        << " N  OBJROW\n L  cons0\n G  cons1\n G  cons2\n L  cons3\n"
+        << "COLUMNS\n"
+        << "    x0        OBJROW     150            cons0      1\n"
+        << "    x0        cons1      3\n"
+        << "    x1        OBJROW     230            cons0      1\n"
+        << "    x1        cons2      3.6\n"
+        << "    x2        OBJROW     260            cons0      1\n"
+        << "    x2        cons3     -24\n"
+        << "    x3        OBJROW     238            cons1      1\n"
+        << "    x4        OBJROW     210            cons2      1\n"
+        << "    x5        OBJROW    -170            cons1     -1\n"
+        << "    x6        OBJROW    -150            cons2     -1\n"
+        << "    x7        OBJROW    -36             cons3      1\n"
+        << "    x8        OBJROW    -10             cons3      1\n"
+        << "RHS\n"
+        << "    RHS1      cons0      500.5          cons1      200\n"
+        << "    RHS1      cons2      240\n"
+        << "BOUNDS\n"
+        << " UP BOUND     x7         6000\n"
+        << "ENDATA\n";
+    std::ofstream tim((name + ".tim").c_str());
+    tim << "TIME          FARMER\n"
+        << "PERIODS       IMPLICIT\n"
+        << "    x0        OBJROW                   PERIOD1\n"
+        << "    x3        cons1                    PERIOD2\n"
+        << "ENDATA\n";
+    const char * scenarios[] = {
+        " SC SCEN01    ROOT            0.33333333   PERIOD2\n"
+        "    x0        cons1           3\n"
+        "    x1        cons2           3.6\n"
+        "    x2        cons3          -24\n",
+        " SC SCEN02    ROOT            0.33333333   PERIOD2\n"
+        "    x0        cons1           2.5\n"
+        "    x1        cons2           3\n"
+        "    x2        cons3          -20\n",
+        " SC SCEN03    ROOT            0.33333334   PERIOD2\n"
+        "    x0        cons1           2\n"
+        "    x1        cons2           2.4\n"
+        "    x2        cons3          -16\n"};
+    std::ofstream sto((name + ".sto").c_str());
+    sto << "STOCH         FARMER\n"
+        << "SCENARIOS\n";
+    for (int s = 0; s < 3; ++s) {
+        sto << scenarios[s];
+        if (recourse)
+            sto << "    x8        cons3           " << recourse[s] << "\n";
+    }
+    sto << "ENDATA\n";
+}
+
+static void removeSmps(const char * filename) {
+    std::string name(filename);
+    std::remove((name + ".cor").c_str());
+    std::remove((name + ".tim").c_str());
+    std::remove((name + ".sto").c_str());
+}
+
+TEST_CASE("Write and read SMPS files of a two-stage model") {
+    writeFarmerSmps("tests-farmer");
+    DecTssModel model;
+    REQUIRE(model.readSmps("tests-farmer") == DSP_RTN_OK);
+    REQUIRE(model.getNumScenarios() == 3);
+
+    const double yield[] = {3.0, 2.5, 2.0};
+    const double cost[] = {238.0, 210.0, -170.0, -150.0, -36.0, -10.0};
+    CoinPackedMatrix * mat_tech = NULL;
+    CoinPackedMatrix * mat_reco = NULL;
+    double * clbd = NULL, * cubd = NULL, * obj = NULL, * rlbd = NULL, * rubd = NULL;
+    char * ctype = NULL;
+
+    SECTION("without perturbation") {
+        REQUIRE(model.writeSmps("tests-farmer-gen") == DSP_RTN_OK);
+        DecTssModel gen;
+        REQUIRE(gen.readSmps("tests-farmer-gen") == DSP_RTN_OK);
+        REQUIRE(gen.getNumScenarios() == 3);
+        REQUIRE(gen.getNumCols(0) == 3);
+        REQUIRE(gen.getNumRows(0) == 1);
+        REQUIRE(gen.getNumCols(1) == 6);
+        REQUIRE(gen.getNumRows(1) == 3);
+        for (int s = 0; s < 3; ++s) {
+            REQUIRE(gen.getProbability()[s] == Approx(model.getProbability()[s]));
+            REQUIRE(gen.copyRecoProb(s, mat_tech, mat_reco, clbd, cubd, ctype, obj, rlbd, rubd, false) == DSP_RTN_OK);
+            REQUIRE(mat_tech->getCoefficient(0, 0) == Approx(yield[s]));
+            REQUIRE(mat_tech->getCoefficient(1, 1) == Approx(1.2 * yield[s]));
+            REQUIRE(mat_tech->getCoefficient(2, 2) == Approx(-8.0 * yield[s]));
+            for (int j = 0; j < 6; ++j)
+                REQUIRE(obj[j] == Approx(cost[j]));
+            REQUIRE(rlbd[0] == Approx(200.0));
+            REQUIRE(rlbd[1] == Approx(240.0));
+            REQUIRE(rubd[2] == Approx(0.0));
+            REQUIRE(cubd[4] == Approx(6000.0));
+            delete mat_tech; delete mat_reco;
+            delete [] clbd; delete [] cubd; delete [] ctype; delete [] obj; delete [] rlbd; delete [] rubd;
+        }
+        removeSmps("tests-farmer-gen");
+    }
+
+    SECTION("cloned and perturbed scenarios") {
+        const double perturb[] = {0.5, 0.5, 0.5};
+        REQUIRE(model.writeSmps("tests-farmer-gen", 5, perturb, 7) == DSP_RTN_OK);
+        DecTssModel gen;
+        REQUIRE(gen.readSmps("tests-farmer-gen") == DSP_RTN_OK);
+        REQUIRE(gen.getNumScenarios() == 5);
+
+        /** the base scenarios 0 and 1 are cloned twice */
+        double sum = 0.0;
+        for (int s = 0; s < 5; ++s) {
+            sum += gen.getProbability()[s];
+            REQUIRE(gen.getProbability()[s] == Approx(model.getProbability()[s % 3] / (s % 3 < 2 ? 2 : 1)));
+        }
+        REQUIRE(sum == Approx(1.0));
+
+        /** the perturbed data stay within the relative amplitudes and keep their signs */
+        for (int s = 0; s < 5; ++s) {
+            double t = yield[s % 3];
+            REQUIRE(gen.copyRecoProb(s, mat_tech, mat_reco, clbd, cubd, ctype, obj, rlbd, rubd, false) == DSP_RTN_OK);
+            REQUIRE(mat_tech->getCoefficient(0, 0) >= 0.5 * t);
+            REQUIRE(mat_tech->getCoefficient(0, 0) <= 1.5 * t);
+            REQUIRE(mat_tech->getCoefficient(2, 2) <= -4.0 * t);
+            REQUIRE(mat_tech->getCoefficient(2, 2) >= -12.0 * t);
+            for (int j = 0; j < 6; ++j) {
+                REQUIRE(obj[j] * cost[j] > 0.0);
+                REQUIRE(fabs(obj[j]) <= 1.5 * fabs(cost[j]));
+            }
+            REQUIRE(rlbd[0] >= 100.0);
+            REQUIRE(rlbd[0] <= 300.0);
+            REQUIRE(rubd[0] >= 1.0e+20);
+            delete mat_tech; delete mat_reco;
+            delete [] clbd; delete [] cubd; delete [] ctype; delete [] obj; delete [] rlbd; delete [] rubd;
+        }
+        removeSmps("tests-farmer-gen");
+    }
+
+    SECTION("invalid perturbation") {
+        const double perturb[] = {1.0, 0.0, 0.0};
+        REQUIRE(model.writeSmps("tests-farmer-gen", 5, perturb) == DSP_RTN_ERR);
+    }
+
+    removeSmps("tests-farmer");
+}
+
+TEST_CASE("Scenario distance of a two-stage model") {
+    const double same[] = {1.0, 1.0, 1.0};
+    const double close[] = {1.0, 1.1, 5.0};
+
+    SECTION("scenarios differing only in cost") {
+        const double demand[] = {2.0, 2.0, 2.0};
+        DecTssModel * model = createThreeScenarioModel(same, close, demand);
+        REQUIRE(model->getScenarioDistance(0, 2, 1.0) == Approx(4.0));
+        REQUIRE(model->getScenarioDistance(0, 1, 2.0) == Approx(0.01));
+        delete model;
+    }
+
+    SECTION("scenarios differing only in demand") {
+        const double cost[] = {1.0, 1.0, 1.0};
+        DecTssModel * model = createThreeScenarioModel(same, cost, close);
+        REQUIRE(model->getScenarioDistance(0, 2, 1.0) == Approx(4.0));
+
+        /** scenario 0 is removed, and scenarios 1 and 2 are kept */
+        double kantorovich = -1.0;
+        REQUIRE(model->reduceScenarios(2, SCEN_BACKWARD, &kantorovich) == DSP_RTN_OK);
+        REQUIRE(model->getNumScenarios() == 2);
+        REQUIRE(model->getProbability()[0] == Approx(0.5));
+        REQUIRE(kantorovich == Approx(0.2 * 0.1));
+        double * rlbd = NULL;
+        CoinPackedMatrix * mat_tech = NULL;
+        CoinPackedMatrix * mat_reco = NULL;
+        double * clbd = NULL, * cubd = NULL, * obj = NULL, * rubd = NULL;
+        char * ctype = NULL;
+        REQUIRE(model->copyRecoProb(1, mat_tech, mat_reco, clbd, cubd, ctype, obj, rlbd, rubd, false) == DSP_RTN_OK);
+        REQUIRE(rlbd[0] == Approx(5.0));
+        delete mat_tech; delete mat_reco;
+        delete [] clbd; delete [] cubd; delete [] ctype; delete [] obj; delete [] rlbd; delete [] rubd;
+        delete model;
+    }
+
+    SECTION("random recourse in the last column of an SMPS model") {
+        const double recourse[] = {1.0, 2.0, 1.0};
+        writeFarmerSmps("tests-farmer-recourse", recourse);
+        DecTssModel model;
+        REQUIRE(model.readSmps("tests-farmer-recourse") == DSP_RTN_OK);
+        /** the yields differ by (0.5, 0.6, 4) and the recourse by 1 */
+        REQUIRE(model.getScenarioDistance(0, 1, 2.0) == Approx(0.25 + 0.36 + 16.0 + 1.0));
+        REQUIRE(model.getScenarioDistance(0, 2, 2.0) == Approx(1.0 + 1.44 + 64.0));
+        REQUIRE(model.getScenarioDistance(1, 0, 2.0) == Approx(model.getScenarioDistance(0, 1, 2.0)));
+        removeSmps("tests-farmer-recourse");
+    }
+}
+
+TEST_CASE("Identical scenarios of a two-stage model") {
+    /** scenario 0 has no demand, and scenarios 1 and 2 have the demand of zero */
+    const double tech[] = {1.0, 1.0, 1.0};
+    const double cost[] = {1.0, 1.0, 1.0};
+    const double demand[] = {-COIN_DBL_MAX, 0.0, 0.0};
+    DecTssModel * model = createThreeScenarioModel(tech, cost, demand);
+    std::vector<std::vector<double> > data(3);
+
+    SECTION("exact data keep the infinite bounds") {
+        for (int s = 0; s < 3; ++s)
+            REQUIRE(model->getScenarioData(s, data[s], true) == DSP_RTN_OK);
+        REQUIRE(data[0] != data[1]);
+        REQUIRE(data[1] == data[2]);
+
+        std::vector<int> rep;
+        REQUIRE(DspMergeIdenticalScenarios(data, rep) == 2);
+        REQUIRE(rep[0] == 0);
+        REQUIRE(rep[1] == 1);
+        REQUIRE(rep[2] == 1);
+    }
+
+    SECTION("data for the distance replace the infinite bounds by zeros") {
+        for (int s = 0; s < 3; ++s)
+            REQUIRE(model->getScenarioData(s, data[s]) == DSP_RTN_OK);
+        REQUIRE(data[0] == data[1]);
+    }
+
+    delete model;
+}
@@ -0,0 +1,71 @@
+// tests-DspCheckpoint.cpp
+#include <sstream>
+#include "catch.hpp"
+
+#include "CoinError.hpp"
+#include "Utility/DspCheckpoint.h"
+#include "TreeSearch/DspBranchObj.h"
+
+TEST_CASE("Checkpoint entries") {
+    std::stringstream ss;
+
+    SECTION("round trip") {
+        std::vector<double> x = {1.0 / 3.0, -1.7976931348623157e+308, 0.0};
+        std::vector<int> ages = {0, -1, 5};
+        DspCheckpointWrite(ss, "iteration", 12);
+        DspCheckpointWrite(ss, "objective", 0.1 + 0.2);
+        DspCheckpointWrite(ss, "solution", x);
+        DspCheckpointWrite(ss, "ages", ages);
+        DspCheckpointWrite(ss, "empty", std::vector<double>());
+
+        int iter;
+        double obj;
+        std::vector<double> y, empty(2, 1.0);
+        std::vector<int> ages2;
+        DspCheckpointRead(ss, "iteration", iter);
+        DspCheckpointRead(ss, "objective", obj);
+        DspCheckpointRead(ss, "solution", y);
+        DspCheckpointRead(ss, "ages", ages2);
+        DspCheckpointRead(ss, "empty", empty);
+        REQUIRE(iter == 12);
+        REQUIRE(obj == 0.1 + 0.2);
+        REQUIRE(y == x);
+        REQUIRE(ages2 == ages);
+        REQUIRE(empty.size() == 0);
+    }
+
+    SECTION("mismatched key") {
+        int iter;
+        DspCheckpointWrite(ss, "iteration", 12);
+        REQUIRE_THROWS_AS(DspCheckpointRead(ss, "nodes", iter), CoinError);
+    }
+
+    SECTION("truncated entry") {
+        std::vector<double> y;
+        ss << "solution 3 1.0 2.0";
+        REQUIRE_THROWS_AS(DspCheckpointRead(ss, "solution", y), CoinError);
+    }
+}
+
+TEST_CASE("Branching object checkpoint") {
+    std::stringstream ss;
+    DspBranchObj obj, restored;
+    obj.push_back(3, 1.0, 2.0);
+    obj.push_back(7, 0.0, 0.0);
+    obj.direction_ = -1;
+    obj.parentObj_ = -12.5;
+    obj.dualsol_ = {0.5, -1.0};
+    obj.writeCheckpoint(ss);
+    restored.readCheckpoint(ss);
+
+    REQUIRE(restored.getNumObjs() == 2);
+    REQUIRE(restored.getIndex(0) == 3);
+    REQUIRE(restored.getIndex(1) == 7);
+    REQUIRE(restored.getLb(0) == 1.0);
+    REQUIRE(restored.getUb(0) == 2.0);
+    REQUIRE(restored.getUb(1) == 0.0);
+    REQUIRE(restored.direction_ == -1);
+    REQUIRE(restored.parentObj_ == -12.5);
+    REQUIRE(restored.dualsol_ == obj.dualsol_);
+    REQUIRE(restored.bestBound_ == obj.bestBound_);
+}
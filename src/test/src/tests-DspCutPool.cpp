@@ -0,0 +1,46 @@
+// tests-DspCutPool.cpp
+#include "catch.hpp"
+
+#include "Utility/DspCutPool.h"
+
+static CoinPackedVector makeRow(double a, double b) {
+    CoinPackedVector row;
+    row.insert(0, a);
+    row.insert(2, b);
+    return row;
+}
+
+TEST_CASE("Cut pool") {
+    DspCutPool pool(0.999, 2);
+    std::vector<int> removed;
+
+    SECTION("parallel cuts are filtered") {
+        int id = pool.insert(makeRow(1.0, 1.0), 1.0);
+        REQUIRE(pool.find(makeRow(2.0, 2.0), 1.0) == id);
+        REQUIRE(pool.find(makeRow(2.0, 2.0), 3.0) == -1);
+        REQUIRE(pool.find(makeRow(1.0, -1.0), 0.0) == -1);
+    }
+
+    SECTION("weaker parallel cuts are retired") {
+        pool.insert(makeRow(1.0, 1.0), 1.0);
+        int id = pool.insert(makeRow(1.0, 1.0), 2.0);
+        REQUIRE(pool.size() == 2);
+        REQUIRE(pool.purge(removed) == 1);
+        REQUIRE(pool.size() == 1);
+        REQUIRE(pool.getAge(id) == 0);
+    }
+
+    SECTION("cuts not tight are purged") {
+        int tight = pool.insert(makeRow(1.0, 0.0), 1.0);
+        int loose = pool.insert(makeRow(0.0, 1.0), 1.0);
+        double x[3] = {1.0, 0.0, 5.0};
+        pool.age(x);
+        REQUIRE(pool.purge(removed) == 0);
+        pool.age(x);
+        REQUIRE(pool.getAge(loose) == 2);
+        REQUIRE(pool.getNumActive(tight) == 2);
+        REQUIRE(pool.purge(removed) == 1);
+        REQUIRE(removed[0] == loose);
+        REQUIRE(pool.getNumPurged() == 1);
+    }
+}
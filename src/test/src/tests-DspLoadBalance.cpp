@@ -0,0 +1,37 @@
+// tests-DspLoadBalance.cpp
+#include "catch.hpp"
+
+#include "Utility/DspLoadBalance.h"
+
+TEST_CASE("Load balancing") {
+    /** round-robin assignment of subproblems 0,1,2,3 to two processes */
+    std::vector<int> owners = {0, 1, 0, 1};
+    std::vector<int> newowners;
+
+    SECTION("imbalanced loads are rebalanced") {
+        std::vector<double> times = {4.0, 1.0, 3.0, 1.0};
+        REQUIRE(DspLoadImbalance(2, times, owners) == Approx(7.0 / 4.5));
+        REQUIRE(DspLoadAssign(2, times, owners, 0.0, newowners) > 0);
+        REQUIRE(newowners[0] != newowners[2]);
+        REQUIRE(DspLoadImbalance(2, times, newowners) == Approx(5.0 / 4.5));
+    }
+
+    SECTION("balanced loads are kept") {
+        std::vector<double> times = {2.0, 2.0, 2.0, 2.0};
+        REQUIRE(DspLoadImbalance(2, times, owners) == Approx(1.0));
+        REQUIRE(DspLoadAssign(2, times, owners, 0.1, newowners) == 0);
+        REQUIRE(newowners == owners);
+    }
+
+    SECTION("small improvements are ignored") {
+        std::vector<double> times = {2.1, 2.0, 2.0, 2.0};
+        REQUIRE(DspLoadAssign(2, times, owners, 0.1, newowners) == 0);
+        REQUIRE(newowners == owners);
+    }
+
+    SECTION("no load") {
+        std::vector<double> times = {0.0, 0.0, 0.0, 0.0};
+        REQUIRE(DspLoadImbalance(2, times, owners) == Approx(1.0));
+        REQUIRE(DspLoadAssign(2, times, owners, 0.0, newowners) == 0);
+    }
+}
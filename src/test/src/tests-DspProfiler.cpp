@@ -0,0 +1,104 @@
+// tests-DspProfiler.cpp
+#include <thread>
+#include "catch.hpp"
+
+#include "Utility/DspProfiler.h"
+
+TEST_CASE("Profile accumulation") {
+    DspProfiler & profiler = DspProfiler::instance();
+    profiler.reset();
+    profiler.enable(true);
+    DspProfiler::Table table;
+
+    SECTION("times and counts of the threads are merged") {
+        profiler.addTime("solve", 1.0);
+        profiler.addTime("solve", 2.0);
+        profiler.addCount("cuts", 3);
+        profiler.addCount("cuts");
+        std::thread worker([&profiler]() {
+            profiler.addTime("solve", 0.5);
+            profiler.addCount("cuts", 2);
+        });
+        worker.join();
+
+        profiler.merge(table);
+        REQUIRE(table.size() == 2);
+        REQUIRE(table["solve"].time == Approx(3.5));
+        REQUIRE(table["solve"].calls == 3);
+        REQUIRE(table["solve"].count == 0);
+        REQUIRE(table["cuts"].count == 6);
+        REQUIRE(table["cuts"].calls == 0);
+    }
+
+    SECTION("scoped timers per index") {
+        for (int b = 0; b < 3; ++b) {
+            DSP_PROFILE_SCOPE_INDEX("block", b % 2);
+        }
+        {
+            DSP_PROFILE_SCOPE("total");
+        }
+        profiler.merge(table);
+        REQUIRE(table.size() == 3);
+        REQUIRE(table["block/0"].calls == 2);
+        REQUIRE(table["block/1"].calls == 1);
+        REQUIRE(table["total"].calls == 1);
+        REQUIRE(table["block/0"].time >= 0.0);
+    }
+
+    SECTION("nothing is recorded when disabled") {
+        profiler.enable(false);
+        {
+            DSP_PROFILE_SCOPE_INDEX("block", 0);
+        }
+        DSP_PROFILE_COUNT("cuts", 1);
+        profiler.merge(table);
+        REQUIRE(table.empty());
+    }
+
+    SECTION("reset clears the entries") {
+        profiler.addTime("solve", 1.0);
+        profiler.reset();
+        profiler.merge(table);
+        REQUIRE(table.empty());
+    }
+
+    profiler.enable(false);
+    profiler.reset();
+}
+
+TEST_CASE("Profile reduction over the ranks") {
+    DspProfiler & profiler = DspProfiler::instance();
+    profiler.reset();
+
+    std::vector<DspProfiler::Table> tables(3);
+    tables[0]["solve"].time = 1.0;
+    tables[0]["solve"].calls = 4;
+    tables[1]["solve"].time = 3.0;
+    tables[1]["solve"].calls = 2;
+    tables[2]["solve"].time = 2.0;
+    tables[2]["solve"].calls = 6;
+    tables[2]["cuts"].count = 5;
+    profiler.reduce(tables);
+
+    const std::map<std::string, DspProfiler::Stat> & stats = profiler.getStats();
+    REQUIRE(stats.size() == 2);
+
+    const DspProfiler::Stat & solve = stats.find("solve")->second;
+    REQUIRE(solve.nranks == 3);
+    REQUIRE(solve.sum.time == Approx(6.0));
+    REQUIRE(solve.min.time == Approx(1.0));
+    REQUIRE(solve.max.time == Approx(3.0));
+    REQUIRE(solve.sum.calls == 12);
+    REQUIRE(solve.min.calls == 2);
+    REQUIRE(solve.max.calls == 6);
+
+    /** only the ranks that recorded an entry count in its statistics */
+    const DspProfiler::Stat & cuts = stats.find("cuts")->second;
+    REQUIRE(cuts.nranks == 1);
+    REQUIRE(cuts.sum.count == 5);
+    REQUIRE(cuts.min.count == 5);
+    REQUIRE(cuts.max.count == 5);
+
+    profiler.reset();
+    REQUIRE(profiler.getStats().empty());
+}
@@ -0,0 +1,42 @@
+// tests-DspScenarioBundle.cpp
+#include <algorithm>
+#include "catch.hpp"
+
+#include "Utility/DspScenarioBundle.h"
+
+TEST_CASE("Scenario bundling") {
+    std::vector<int> bundles;
+
+    SECTION("similar scenarios are bundled") {
+        std::vector<std::vector<double> > data = {{0.0, 5.0}, {10.0, 5.0}, {1.0, 5.0}, {11.0, 5.0}};
+        REQUIRE(DspBundleScenarios(2, data, bundles) == 2);
+        REQUIRE(bundles == std::vector<int>({0, 1, 0, 1}));
+    }
+
+    SECTION("bundle sizes are balanced") {
+        std::vector<std::vector<double> > data = {{0.0}, {0.1}, {0.2}, {10.0}};
+        REQUIRE(DspBundleScenarios(2, data, bundles) == 2);
+        REQUIRE(std::count(bundles.begin(), bundles.end(), 0) == 2);
+        REQUIRE(std::count(bundles.begin(), bundles.end(), 1) == 2);
+        REQUIRE(bundles[0] == bundles[1]);
+    }
+
+    SECTION("every bundle is nonempty") {
+        std::vector<std::vector<double> > data = {{0.0}, {0.1}, {0.2}, {0.3}, {10.0}};
+        REQUIRE(DspBundleScenarios(4, data, bundles) == 4);
+        for (int b = 0; b < 4; ++b)
+            REQUIRE(std::count(bundles.begin(), bundles.end(), b) >= 1);
+    }
+
+    SECTION("more bundles than scenarios") {
+        std::vector<std::vector<double> > data = {{1.0}, {2.0}, {3.0}};
+        REQUIRE(DspBundleScenarios(5, data, bundles) == 3);
+        REQUIRE(bundles == std::vector<int>({0, 1, 2}));
+    }
+
+    SECTION("identical scenarios") {
+        std::vector<std::vector<double> > data(4, std::vector<double>(3, 1.0));
+        REQUIRE(DspBundleScenarios(1, data, bundles) == 1);
+        REQUIRE(bundles == std::vector<int>(4, 0));
+    }
+}
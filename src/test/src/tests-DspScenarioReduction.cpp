@@ -0,0 +1,103 @@
+// tests-DspScenarioReduction.cpp
+#include <cmath>
+#include "catch.hpp"
+
+#include "Utility/DspScenarioReduction.h"
+
+TEST_CASE("Identical scenarios") {
+    std::vector<int> rep;
+
+    SECTION("identical scenarios are represented by the first one") {
+        std::vector<std::vector<double> > data = {{1.0, 2.0}, {0.0, 2.0}, {1.0, 2.0}, {0.0, 2.0}, {3.0, 1.0}};
+        REQUIRE(DspMergeIdenticalScenarios(data, rep) == 3);
+        REQUIRE(rep == std::vector<int>({0, 1, 0, 1, 4}));
+    }
+
+    SECTION("distinct scenarios") {
+        std::vector<std::vector<double> > data = {{1.0}, {2.0}, {3.0}};
+        REQUIRE(DspMergeIdenticalScenarios(data, rep) == 3);
+        REQUIRE(rep == std::vector<int>({0, 1, 2}));
+    }
+}
+
+TEST_CASE("Forward selection") {
+    std::vector<double> x;
+    auto dist = [&x](int s, int t) { return std::abs(x[s] - x[t]); };
+    std::vector<int> rep;
+
+    SECTION("reduce to two scenarios") {
+        x = {0.0, 0.1, 10.0, 10.2};
+        std::vector<double> prob = {0.25, 0.25, 0.25, 0.25};
+        double d = DspForwardSelection(2, 4, dist, prob, rep);
+        REQUIRE(rep[0] == rep[1]);
+        REQUIRE(rep[2] == rep[3]);
+        REQUIRE(rep[0] != rep[2]);
+        REQUIRE(d == Approx(0.25 * 0.1 + 0.25 * 0.2));
+    }
+
+    SECTION("the probable scenario is selected") {
+        x = {0.0, 1.0, 2.0};
+        std::vector<double> prob = {0.1, 0.1, 0.8};
+        REQUIRE(DspForwardSelection(1, 3, dist, prob, rep) == Approx(0.1 * 2.0 + 0.1 * 1.0));
+        REQUIRE(rep == std::vector<int>({2, 2, 2}));
+    }
+
+    SECTION("no reduction") {
+        x = {0.0, 1.0};
+        std::vector<double> prob = {0.5, 0.5};
+        REQUIRE(DspForwardSelection(2, 2, dist, prob, rep) == 0.0);
+        REQUIRE(rep == std::vector<int>({0, 1}));
+    }
+}
+
+TEST_CASE("Backward reduction") {
+    std::vector<double> x = {0.0, 0.1, 10.0, 10.2};
+    auto dist = [&x](int s, int t) { return std::abs(x[s] - x[t]); };
+    std::vector<int> rep;
+
+    SECTION("reduce to two scenarios") {
+        std::vector<double> prob = {0.25, 0.25, 0.25, 0.25};
+        double d = DspBackwardReduction(2, 4, dist, prob, rep);
+        REQUIRE(rep[0] == rep[1]);
+        REQUIRE(rep[2] == rep[3]);
+        REQUIRE(rep[0] != rep[2]);
+        REQUIRE(d == Approx(0.25 * 0.1 + 0.25 * 0.2));
+    }
+
+    SECTION("the improbable scenario is deleted") {
+        std::vector<double> prob = {0.1, 0.4, 0.1, 0.4};
+        REQUIRE(DspBackwardReduction(2, 4, dist, prob, rep) == Approx(0.1 * 0.1 + 0.1 * 0.2));
+        REQUIRE(rep == std::vector<int>({1, 1, 3, 3}));
+    }
+
+    SECTION("no reduction") {
+        std::vector<double> prob = {0.25, 0.25, 0.25, 0.25};
+        REQUIRE(DspBackwardReduction(4, 4, dist, prob, rep) == 0.0);
+        REQUIRE(rep == std::vector<int>({0, 1, 2, 3}));
+    }
+}
+
+TEST_CASE("K-medoids clustering") {
+    std::vector<double> x = {0.0, 1.0, 2.0, 10.0, 11.0, 12.0};
+    auto dist = [&x](int s, int t) { return std::abs(x[s] - x[t]); };
+    std::vector<double> prob(6, 1.0 / 6.0);
+    std::vector<int> rep;
+
+    SECTION("medoids are the cluster centers") {
+        REQUIRE(DspKMedoids(2, 6, dist, prob, rep) == Approx(4.0 / 6.0));
+        REQUIRE(rep == std::vector<int>({1, 1, 1, 4, 4, 4}));
+    }
+
+    SECTION("single medoid") {
+        DspKMedoids(1, 6, dist, prob, rep);
+        REQUIRE(rep == std::vector<int>(6, rep[0]));
+        REQUIRE((rep[0] == 2 || rep[0] == 3));
+    }
+
+    SECTION("identical scenarios") {
+        std::vector<double> y = {1.0, 1.0, 1.0};
+        auto same = [&y](int s, int t) { return std::abs(y[s] - y[t]); };
+        REQUIRE(DspKMedoids(2, 3, same, std::vector<double>(3, 1.0 / 3.0), rep) == 0.0);
+        REQUIRE(rep == std::vector<int>({0, 0, 0}));
+    }
+}
@@ -0,0 +1,48 @@
+// tests-DspSolutionPool.cpp
+#include "catch.hpp"
+
+#include "Utility/DspSolutionPool.h"
+
+static CoinPackedVector * makeSolution(double a, double b) {
+    CoinPackedVector * x = new CoinPackedVector;
+    x->insert(0, a);
+    x->insert(2, b);
+    return x;
+}
+
+TEST_CASE("Solution pool") {
+    DspSolutionPool pool(1.0e-8, 2);
+
+    SECTION("duplicate detection") {
+        pool.insert(makeSolution(1.0, 2.0));
+        CoinPackedVector * y = makeSolution(1.0 + 1.0e-10, 2.0);
+        CoinPackedVector * z = makeSolution(1.0, 2.5);
+        REQUIRE(pool.find(*y) != NULL);
+        REQUIRE(pool.find(*z) == NULL);
+        delete y;
+        delete z;
+    }
+
+    SECTION("least recently used eviction") {
+        pool.insert(makeSolution(1.0, 1.0));
+        pool.insert(makeSolution(2.0, 2.0));
+        pool.insert(makeSolution(3.0, 3.0));
+        /** pinned solutions are not evicted */
+        REQUIRE(pool.size() == 3);
+        pool.release();
+        REQUIRE(pool.size() == 2);
+        REQUIRE(pool.getNumEvicted() == 1);
+
+        CoinPackedVector * x = makeSolution(1.0, 1.0);
+        CoinPackedVector * y = makeSolution(2.0, 2.0);
+        REQUIRE(pool.find(*x) == NULL);
+        REQUIRE(pool.find(*y) != NULL);
+        /** 3.0 is now the least recently used */
+        pool.insert(x);
+        pool.release();
+        CoinPackedVector * z = makeSolution(3.0, 3.0);
+        REQUIRE(pool.find(*z) == NULL);
+        delete y;
+        delete z;
+    }
+}
@@ -0,0 +1,70 @@
+// tests-DspWasserstein.cpp
+#include "catch.hpp"
+
+#include "Utility/DspWasserstein.h"
+
+TEST_CASE("Wasserstein worst-case distribution") {
+    double p[4];
+
+    SECTION("mixture of two scenarios on the hull") {
+        double r[4] = {1.0, 3.0, 2.0, 10.0};
+        double d[4] = {0.0, 0.5, 0.2, 5.0};
+        REQUIRE(DspWassersteinWorstCase(4, r, d, 1.0, p));
+        REQUIRE(p[1] == Approx(8.0 / 9.0));
+        REQUIRE(p[3] == Approx(1.0 / 9.0));
+        REQUIRE(p[0] + p[2] == Approx(0.0));
+    }
+
+    SECTION("the peak is inside the ball") {
+        double r[4] = {1.0, 3.0, 2.0, 10.0};
+        double d[4] = {0.0, 0.5, 0.2, 5.0};
+        REQUIRE(DspWassersteinWorstCase(4, r, d, 6.0, p));
+        REQUIRE(p[3] == Approx(1.0));
+    }
+
+    SECTION("zero radius") {
+        double r[3] = {5.0, 1.0, 7.0};
+        double d[3] = {1.0, 0.0, 2.0};
+        REQUIRE(DspWassersteinWorstCase(3, r, d, 0.0, p));
+        REQUIRE(p[1] == Approx(1.0));
+    }
+
+    SECTION("infeasible") {
+        double r[2] = {1.0, 2.0};
+        double d[2] = {1.0, 2.0};
+        REQUIRE_FALSE(DspWassersteinWorstCase(2, r, d, 0.5, p));
+    }
+}
+
+TEST_CASE("Wasserstein transport pair sparsification") {
+    double d[5] = {3.0, 0.5, 0.0, 2.0, 0.5};
+    std::vector<int> keep;
+
+    SECTION("all pairs") {
+        REQUIRE(DspWassersteinSparsify(5, d, 0, -1.0, keep) == 5);
+        REQUIRE(keep == std::vector<int>({0, 1, 2, 3, 4}));
+    }
+
+    SECTION("k-nearest pairs with ties broken by index") {
+        REQUIRE(DspWassersteinSparsify(5, d, 2, -1.0, keep) == 2);
+        REQUIRE(keep == std::vector<int>({1, 2}));
+        REQUIRE(DspWassersteinSparsify(5, d, 4, -1.0, keep) == 4);
+        REQUIRE(keep == std::vector<int>({1, 2, 3, 4}));
+    }
+
+    SECTION("distance cutoff") {
+        REQUIRE(DspWassersteinSparsify(5, d, 0, 1.0, keep) == 3);
+        REQUIRE(keep == std::vector<int>({1, 2, 4}));
+    }
+
+    SECTION("k-nearest pairs under the cutoff") {
+        REQUIRE(DspWassersteinSparsify(5, d, 4, 1.0, keep) == 3);
+        REQUIRE(keep == std::vector<int>({1, 2, 4}));
+    }
+
+    SECTION("zero-distance pairs are always kept") {
+        double z[3] = {1.0, 0.0, 0.0};
+        REQUIRE(DspWassersteinSparsify(3, z, 1, 0.5, keep) == 2);
+        REQUIRE(keep == std::vector<int>({1, 2}));
+    }
+}
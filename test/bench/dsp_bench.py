@@ -0,0 +1,305 @@
+#!/usr/bin/env python3
+"""
+Benchmark harness for runDsp.
+
+This runs the matrix of algorithms, solvers, thread counts and rank counts
+given in a JSON file over the instances in examples/ (and optionally generated
+instances), records the wall time, iterations, bounds, profiled time splits
+and peak resident set size of each run, and compares them against a stored
+baseline. The peak RSS (peak_rss_mb) is that of the largest single process of
+the run (e.g., the largest MPI rank or the launcher), not the total over the
+ranks, since the operating system reports the maximum over the descendants.
+
+Each run is killed and reported as a failure if it does not finish within its
+timeout (--timeout, or "timeout" of its group in the matrix).
+
+Example:
+
+    python3 dsp_bench.py --rundsp ../../build/src/runDsp --matrix matrix.json \\
+        --output results.json --baseline baseline.json
+
+A run is reported as a regression if its wall time exceeds the baseline by
+more than the relative threshold (--time-threshold) and the absolute slack
+(--time-slack), if its peak RSS exceeds the baseline by more than
+--rss-threshold, or if its bounds do not match the baseline objective.
+"""
+
+import argparse
+import itertools
+import json
+import os
+import re
+import signal
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+OUTPUT_PATTERNS = {
+    "status": (r"^Status: (\S+)", int),
+    "primal_bound": (r"^Primal Bound: (\S+)", float),
+    "dual_bound": (r"^Dual Bound  : (\S+)", float),
+    "iterations": (r"^Iterations  : (\S+)", int),
+    "solve_time": (r"^Time \(s\)    : (\S+)", float),
+}
+
+
+def parse_output(text):
+    """Parse the result lines printed by runDsp."""
+    result = {}
+    for key, (pattern, conv) in OUTPUT_PATTERNS.items():
+        m = re.search(pattern, text, re.MULTILINE)
+        if m:
+            try:
+                result[key] = conv(m.group(1))
+            except ValueError:
+                result[key] = None
+    return result
+
+
+def parse_profile(filename):
+    """Read the JSON profile report written by runDsp --profile."""
+    try:
+        with open(filename) as f:
+            report = json.load(f)
+    except (IOError, ValueError):
+        return {}
+    splits = {}
+    for name, values in report.get("sections", {}).items():
+        splits[name] = {
+            "time_max": values.get("time_max"),
+            "time_avg": values.get("time_avg"),
+            "calls": values.get("calls_sum"),
+        }
+    return splits
+
+
+def instance_args(instance, root):
+    """Return the runDsp input arguments of an instance."""
+    args = []
+    if "smps" in instance:
+        args += ["--smps", os.path.join(root, instance["smps"])]
+    else:
+        args += ["--mps", os.path.join(root, instance["mps"]),
+                 "--dec", os.path.join(root, instance["dec"])]
+    for key in ("wassnorm", "wasseps"):
+        if key in instance:
+            args += ["--" + key, str(instance[key])]
+    return args
+
+
+def write_param_file(base, threads, extra):
+    """Create a temporary parameter file from the base file and overrides."""
+    fd, name = tempfile.mkstemp(prefix="dsp_bench_", suffix=".txt")
+    with os.fdopen(fd, "w") as f:
+        if base:
+            with open(base) as b:
+                f.write(b.read())
+            f.write("\n")
+        f.write("int NUM_CORES %d\n" % threads)
+        for line in extra:
+            f.write(line + "\n")
+    return name
+
+
+def run_case(opts, case):
+    """Run a single benchmark case and return its record."""
+    root = opts.root
+    solver = opts.solvers[case["solver"]]
+    param = write_param_file(
+        os.path.join(root, solver["param"]) if "param" in solver else None,
+        case["threads"], case["instance"].get("params", []))
+    fd, profile = tempfile.mkstemp(prefix="dsp_bench_", suffix=".json")
+    os.close(fd)
+
+    cmd = []
+    if case["ranks"] > 1:
+        cmd += opts.mpiexec.split() + ["-np", str(case["ranks"])]
+    cmd += [opts.rundsp, "--algo", case["algo"]]
+    cmd += instance_args(case["instance"], root)
+    cmd += ["--param", param, "--profile", profile]
+
+    record = {
+        "name": case["name"],
+        "algo": case["algo"],
+        "solver": case["solver"],
+        "instance": case["instance"]["name"],
+        "threads": case["threads"],
+        "ranks": case["ranks"],
+        "command": " ".join(cmd),
+    }
+
+    timeout = case.get("timeout") or opts.timeout
+    record["timed_out"] = False
+
+    stime = time.time()
+    try:
+        # The run gets its own process group, so that a timeout kills the MPI ranks as well.
+        proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                                universal_newlines=True, start_new_session=True)
+        chunks = []
+        reader = threading.Thread(target=lambda: chunks.append(proc.stdout.read()))
+        reader.daemon = True
+        reader.start()
+        # wait4 gives the resource usage of the child and its descendants.
+        while True:
+            pid, status, rusage = os.wait4(proc.pid, os.WNOHANG)
+            if pid != 0:
+                break
+            if timeout > 0 and time.time() - stime > timeout:
+                os.killpg(proc.pid, signal.SIGKILL)
+                _, status, rusage = os.wait4(proc.pid, 0)
+                record["timed_out"] = True
+                break
+            time.sleep(0.1)
+        reader.join(10.0)
+        out = "".join(chunks)
+        proc.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1
+        record["returncode"] = proc.returncode
+        # ru_maxrss is the maximum over the processes (not the sum), in kilobytes on Linux and in bytes on Mac.
+        rss = rusage.ru_maxrss
+        record["peak_rss_mb"] = rss / (1024.0 * 1024.0) if sys.platform == "darwin" else rss / 1024.0
+    except OSError as e:
+        out = str(e)
+        record["returncode"] = -1
+        record["peak_rss_mb"] = None
+    record["wall_time"] = time.time() - stime
+    record.update(parse_output(out))
+    record["profile"] = parse_profile(profile)
+
+    if opts.log_dir:
+        with open(os.path.join(opts.log_dir, case["name"] + ".log"), "w") as f:
+            f.write(out)
+
+    os.remove(param)
+    os.remove(profile)
+    return record
+
+
+def expand_matrix(matrix, filters):
+    """Expand the benchmark matrix into a list of cases."""
+    cases = []
+    for group in matrix["runs"]:
+        instances = [matrix["instances"][name] for name in group["instances"]]
+        for algo, solver, threads, ranks, inst in itertools.product(
+                group["algos"], group.get("solvers", ["scip"]),
+                group.get("threads", [1]), group.get("ranks", [1]), instances):
+            name = "%s_%s_%s_t%d_n%d" % (algo, solver, inst["name"], threads, ranks)
+            if filters and not any(re.search(f, name) for f in filters):
+                continue
+            cases.append({"name": name, "algo": algo, "solver": solver,
+                          "threads": threads, "ranks": ranks, "instance": inst,
+                          "timeout": group.get("timeout")})
+    return cases
+
+
+def generate_instances(matrix, root, gensmps):
+    """Create the generated instances that do not exist yet."""
+    for inst in matrix["instances"].values():
+        gen = inst.get("generate")
+        if gen is None:
+            continue
+        target = os.path.join(root, inst["smps"] + ".cor") if "smps" in inst \
+            else os.path.join(root, inst["mps"])
+        if os.path.exists(target):
+            continue
+        if not os.path.isdir(os.path.dirname(target)):
+            os.makedirs(os.path.dirname(target))
+        print("Generating instance %s" % inst["name"])
+        subprocess.check_call(gen.format(gensmps=gensmps), shell=True, cwd=root)
+
+
+def compare(record, base, opts):
+    """Compare a record against its baseline and return the list of regressions."""
+    issues = []
+    if record.get("timed_out"):
+        issues.append("timed out after %.0f s" % record.get("wall_time"))
+    elif record.get("returncode") != 0:
+        issues.append("exit code %s" % record.get("returncode"))
+    if base is None:
+        return issues
+    t, bt = record.get("wall_time"), base.get("wall_time")
+    if t is not None and bt is not None:
+        if t > bt * (1.0 + opts.time_threshold) and t - bt > opts.time_slack:
+            issues.append("wall time %.2f s (baseline %.2f s)" % (t, bt))
+    r, br = record.get("peak_rss_mb"), base.get("peak_rss_mb")
+    if r is not None and br is not None and r > br * (1.0 + opts.rss_threshold):
+        issues.append("peak RSS %.1f MB (baseline %.1f MB)" % (r, br))
+    for key in ("primal_bound", "dual_bound"):
+        v, bv = record.get(key), base.get(key)
+        if v is not None and bv is not None:
+            if abs(v - bv) > opts.obj_tolerance * (abs(bv) + 1.0e-10):
+                issues.append("%s %g (baseline %g)" % (key, v, bv))
+    return issues
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description="Run the DSP benchmark matrix.")
+    parser.add_argument("--rundsp", required=True, help="path to runDsp")
+    parser.add_argument("--matrix", default=os.path.join(here, "matrix.json"), help="benchmark matrix file")
+    parser.add_argument("--root", default=os.path.normpath(os.path.join(here, "..", "..")),
+                        help="repository root; instance and parameter paths are relative to this")
+    parser.add_argument("--output", default="dsp_bench_results.json", help="result file")
+    parser.add_argument("--baseline", default=os.path.join(here, "baseline.json"), help="baseline result file")
+    parser.add_argument("--update-baseline", action="store_true", help="store the results as the new baseline")
+    parser.add_argument("--filter", action="append", default=[], help="run only the cases matching the regex")
+    parser.add_argument("--gensmps", default=None,
+                        help="path to genSmps for the generated instances (default: next to runDsp)")
+    parser.add_argument("--mpiexec", default="mpiexec", help="MPI launcher")
+    parser.add_argument("--log-dir", default=None, help="directory to keep the runDsp outputs")
+    parser.add_argument("--time-threshold", type=float, default=0.20, help="relative wall time regression threshold")
+    parser.add_argument("--time-slack", type=float, default=1.0, help="absolute wall time slack in seconds")
+    parser.add_argument("--rss-threshold", type=float, default=0.20,
+                        help="relative regression threshold of the peak RSS of the largest process")
+    parser.add_argument("--obj-tolerance", type=float, default=1.0e-4, help="relative objective tolerance")
+    parser.add_argument("--timeout", type=float, default=3600.0,
+                        help="default wall time limit of a run in seconds (0 for none)")
+    opts = parser.parse_args()
+
+    with open(opts.matrix) as f:
+        matrix = json.load(f)
+    for name, inst in matrix["instances"].items():
+        inst["name"] = name
+    opts.solvers = matrix["solvers"]
+    opts.rundsp = os.path.abspath(opts.rundsp)
+    if opts.log_dir and not os.path.isdir(opts.log_dir):
+        os.makedirs(opts.log_dir)
+
+    if opts.gensmps is None:
+        opts.gensmps = os.path.join(os.path.dirname(opts.rundsp), "genSmps")
+    generate_instances(matrix, opts.root, os.path.abspath(opts.gensmps))
+
+    baseline = {}
+    if os.path.exists(opts.baseline):
+        with open(opts.baseline) as f:
+            baseline = dict((r["name"], r) for r in json.load(f)["runs"])
+
+    records = []
+    regressions = 0
+    for case in expand_matrix(matrix, opts.filter):
+        record = run_case(opts, case)
+        issues = compare(record, baseline.get(case["name"]), opts)
+        record["regressions"] = issues
+        records.append(record)
+        regressions += len(issues) > 0
+        print("%-50s %8.2f s %8s it %10.1f MB  %s" % (
+            case["name"], record["wall_time"], record.get("iterations", "-"),
+            record["peak_rss_mb"] or 0.0, "; ".join(issues) if issues else "ok"))
+        sys.stdout.flush()
+
+    results = {"date": time.strftime("%Y-%m-%dT%H:%M:%S"), "rundsp": opts.rundsp, "runs": records}
+    with open(opts.output, "w") as f:
+        json.dump(results, f, indent=1, sort_keys=True)
+    if opts.update_baseline:
+        with open(opts.baseline, "w") as f:
+            json.dump(results, f, indent=1, sort_keys=True)
+        print("Updated baseline %s" % opts.baseline)
+
+    print("%d runs, %d regressions" % (len(records), regressions))
+    return 1 if regressions > 0 and not opts.update_baseline else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())